@@ -6,6 +6,10 @@
  */
 
 #include "RYUW122.h"
+#include "RYUW122RetryPolicy.h"
+#ifdef RYUW122_HAS_RX_QUEUE
+#include "RYUW122RxQueue.h"
+#endif
 #include <stdlib.h>
 
 // Helper: safe integer parse using strtol. Returns defVal on null/invalid input.
@@ -17,40 +21,163 @@ static int safeAtoi(const char* s, int defVal = 0) {
     return (int)val;
 }
 
-// Helper: split string by comma, handling empty fields.
-// Similar to strsep but portable and specific to comma.
-static char* strSepComma(char** stringp) {
-    char* start = *stringp;
-    if (!start) return nullptr;
-    char* end = strchr(start, ',');
-    if (end) {
-        *end = '\0';
-        *stringp = end + 1;
-    } else {
-        *stringp = nullptr;
+// Helper: validate the parameters of an AT+ANCHOR_SEND and format the command and
+// the prefix of the +ANCHOR_RCV line answering it. Returns false on invalid parameters.
+static bool formatAnchorSend(char* command, size_t commandSize, char* expected, size_t expectedSize,
+                             const char* tagAddress, int payloadLength, const char* data) {
+    // Validate parameters according to AT command documentation
+    if (!tagAddress || strlen(tagAddress) != 8) {
+        DEBUG_PRINTLN(F("Error: TAG Address must be 8 bytes ASCII"));
+        return false;
     }
-    return start;
+    if (payloadLength < 0 || payloadLength > RYUW122_MAX_PAYLOAD_LENGTH) {
+        DEBUG_PRINTLN(F("Error: Payload length must be 0-12 bytes"));
+        return false;
+    }
+    if (!data && payloadLength > 0) {
+        DEBUG_PRINTLN(F("Error: Data cannot be nullptr with positive payload length"));
+        return false;
+    }
+
+    snprintf_P(command, commandSize, PSTR("AT+ANCHOR_SEND=%s,%d,%s"), tagAddress, payloadLength, data ? data : "");
+    snprintf_P(expected, expectedSize, PSTR("+ANCHOR_RCV=%s,"), tagAddress);
+    return true;
 }
 
-// Helper: read a line from stream into a char buffer, handling timeout and buffer size.
-// Returns true if a line was read, false on timeout or error.
-static bool readLine(Stream& stream, char* buffer, size_t bufferSize, unsigned long timeout) {
-    unsigned long start = millis();
-    size_t pos = 0;
-    while ((millis() - start) < timeout) {
-        if (stream.available()) {
-            char c = stream.read();
-            if (c == '\n') {
-                buffer[pos] = '\0';
-                return true;
-            }
-            if (pos < bufferSize - 1) {
-                buffer[pos++] = c;
-            }
+// Helper: validate the parameters of an AT+TAG_SEND and format the command.
+static bool formatTagSend(char* command, size_t commandSize, int payloadLength, const char* data) {
+    // Validate parameters according to AT command documentation
+    if (payloadLength < 0 || payloadLength > RYUW122_MAX_PAYLOAD_LENGTH) {
+        DEBUG_PRINTLN(F("Error: Payload length must be 0-12 bytes"));
+        return false;
+    }
+    if (!data && payloadLength > 0) {
+        DEBUG_PRINTLN(F("Error: Data cannot be nullptr with positive payload length"));
+        return false;
+    }
+
+    snprintf_P(command, commandSize, PSTR("AT+TAG_SEND=%d,%s"), payloadLength, data ? data : "");
+    return true;
+}
+
+// Helper: true for the frames the module sends on its own (not as an answer to a command).
+static bool isUnsolicitedLine(const char* line) {
+    return strncmp_P(line, PSTR("+ANCHOR_RCV="), 12) == 0 || strncmp_P(line, PSTR("+TAG_RCV="), 9) == 0;
+}
+
+// Helper: decode an optionally signed decimal integer and advance past it.
+// Returns false if there are no digits.
+static bool parseFrameInt(const char*& p, int& value) {
+    bool negative = (*p == '-');
+    if (negative || *p == '+') p++;
+    if (*p < '0' || *p > '9') return false;
+    int v = 0;
+    while (*p >= '0' && *p <= '9') v = v * 10 + (*p++ - '0');
+    value = negative ? -v : v;
+    return true;
+}
+
+// Helper: decode the last <RSSI> field of a frame (p just after its comma); trailing garbage makes it invalid.
+static bool parseFrameRssi(const char* p, RYUW122Frame& frame) {
+    if (*p == '\0') return true; // RSSI display disabled: empty field
+    if (!parseFrameInt(p, frame.rssi)) return false;
+    if (frame.rssi < -100) frame.rssi = -100; // Clamp to -100
+    frame.hasRssi = true;
+    return *p == '\0';
+}
+
+bool RYUW122ParseFrame(char* line, RYUW122Frame& frame) {
+    frame.type = RYUW122FrameType::INVALID;
+    frame.tagAddress = "";
+    frame.data = "";
+    frame.payloadLength = 0;
+    frame.distance = 0;
+    frame.rssi = 0;
+    frame.hasRssi = false;
+    if (!line) return false;
+
+    RYUW122FrameType type;
+    char* p;
+    if (strncmp_P(line, PSTR("+ANCHOR_RCV="), 12) == 0) {
+        type = RYUW122FrameType::ANCHOR_RCV;
+        p = line + 12;
+
+        // <TAG Address>,
+        char* address = p;
+        while (*p != ',' && *p != '\0') p++;
+        if (*p != ',' || p == address) return false;
+        *p++ = '\0';
+        frame.tagAddress = address;
+    } else if (strncmp_P(line, PSTR("+TAG_RCV="), 9) == 0) {
+        type = RYUW122FrameType::TAG_RCV;
+        p = line + 9;
+    } else {
+        return false;
+    }
+
+    // <Payload Length>,<Data> - the data is delimited by its length, so it may contain commas
+    const char* q = p;
+    if (!parseFrameInt(q, frame.payloadLength) || *q != ',') return false;
+    if (frame.payloadLength < 0 || frame.payloadLength > RYUW122_MAX_PAYLOAD_LENGTH) return false;
+    p += (q - p) + 1;
+    for (int i = 0; i < frame.payloadLength; i++) {
+        if (p[i] == '\0') return false; // shorter than declared
+    }
+    char* data = p;
+    p += frame.payloadLength;
+    char terminator = *p;
+    if (terminator != ',' && terminator != '\0') return false;
+    *p = '\0';
+    frame.data = data;
+
+    q = p + 1;
+    if (type == RYUW122FrameType::ANCHOR_RCV) {
+        // <Distance> with an optional unit suffix (e.g. "120 cm"), then [,<RSSI>]
+        if (terminator != ',' || !parseFrameInt(q, frame.distance)) return false;
+        while (*q == ' ') q++;
+        while ((*q >= 'a' && *q <= 'z') || (*q >= 'A' && *q <= 'Z')) q++;
+        if (*q == ',') {
+            if (!parseFrameRssi(q + 1, frame)) return false;
+        } else if (*q != '\0') {
+            return false;
+        }
+    } else if (terminator == ',') {
+        if (!parseFrameRssi(q, frame)) return false;
+    }
+
+    frame.type = type;
+    return true;
+}
+
+// Completion state of a blocking call waiting on its own transaction
+struct SyncWaiter {
+    bool done;
+    RYUW122TransactionStatus status;
+    RYUW122ErrorCode error;
+    char* response;
+    int responseSize;
+    AnchorResponse* decoded; // receives the fields of a +ANCHOR_RCV/+TAG_RCV answer
+};
+
+static void syncWaiterCallback(const RYUW122TransactionResult& result, void* context) {
+    SyncWaiter* waiter = static_cast<SyncWaiter*>(context);
+    waiter->status = result.status;
+    waiter->error = result.error;
+    if (waiter->response && waiter->responseSize > 0) {
+        strncpy(waiter->response, result.response, waiter->responseSize - 1);
+        waiter->response[waiter->responseSize - 1] = '\0';
+    }
+    // The frame points into the receive buffer, which the next line overwrites: copy the decoded fields now
+    if (waiter->decoded) {
+        waiter->decoded->success = (result.frame != nullptr);
+        if (result.frame) {
+            memcpy(waiter->decoded->responseData, result.frame->data, result.frame->payloadLength);
+            waiter->decoded->responseData[result.frame->payloadLength] = '\0';
+            waiter->decoded->distance = result.frame->distance;
+            waiter->decoded->rssi = result.frame->rssi;
         }
     }
-    buffer[pos] = '\0'; // Null-terminate even on timeout
-    return false; // Timeout
+    waiter->done = true;
 }
 
 
@@ -258,17 +385,7 @@ bool RYUW122::begin(){
     if (this->hs){
         DEBUG_PRINTLN(F("Using Hardware Serial"));
 
-#ifdef HARDWARE_SERIAL_SELECTABLE_PIN
-        if(this->mcuTxPin != -1 && this->mcuRxPin != -1) {
-            DEBUG_PRINTLN(F("Hardware Serial with custom TX/RX pins"));
-            this->serialDef.begin(*this->hs, (uint32_t)this->bpsRate, this->serialConfig, this->mcuRxPin, this->mcuTxPin);
-        }else{
-            this->serialDef.begin(*this->hs, (uint32_t)this->bpsRate, this->serialConfig);
-        }
-#endif
-#ifndef HARDWARE_SERIAL_SELECTABLE_PIN
-        this->serialDef.begin(*this->hs, (uint32_t)this->bpsRate);
-#endif
+        beginSerial(this->bpsRate);
         // Wait for serial port to connect (needed for native USB)
         while (!this->hs) {
           ;
@@ -278,8 +395,8 @@ bool RYUW122::begin(){
     }else if (this->ss){
         DEBUG_PRINTLN(F("Using Software Serial (pre-configured instance)"));
 
-        this->serialDef.begin(*this->ss, (uint32_t)this->bpsRate);
-    }    else{
+        beginSerial(this->bpsRate);
+    } else if (!this->st) {
         DEBUG_PRINTLN(F("Using Software Serial (creating new instance with pins)"));
         // SoftwareSerial constructor expects (rxPin, txPin)
         SoftwareSerial* mySerial = new SoftwareSerial((int)this->mcuRxPin, (int)this->mcuTxPin);
@@ -290,7 +407,7 @@ bool RYUW122::begin(){
         DEBUG_PRINT(F("Software Serial TX Pin: "));
         DEBUG_PRINTLN((int)this->mcuTxPin);
 
-        this->serialDef.begin(*this->ss, (uint32_t)this->bpsRate);
+        beginSerial(this->bpsRate);
 #endif
     }
 
@@ -331,8 +448,20 @@ bool RYUW122::begin(){
     }
     #endif
 
+    if (!this->serialDef.stream) return false;
+
+    if (_autoBaud != RYUW122AutoBaud::OFF && !detectBaudRate()) {
+        DEBUG_PRINTLN(F("Error: The module does not answer at any baud rate"));
+        return false;
+    }
+
+    // Fill the settings cache; a module that does not answer yet is read lazily by the getters
+    if (!refreshSettings()) {
+        DEBUG_PRINTLN(F("Warning: Could not read the module settings"));
+    }
+
     // Return success if serial stream is initialized
-    return this->serialDef.stream != nullptr;
+    return true;
 }
 
 /**
@@ -360,7 +489,8 @@ void RYUW122::managedDelay(unsigned long timeout) const {
  * @return Number of bytes available to read, or 0 if stream is not initialized
  */
 int RYUW122::available() {
-    return this->serialDef.stream ? this->serialDef.stream->available() : 0;
+    if (!this->serialDef.stream) return 0;
+    return (_rxChunkLength - _rxChunkPos) + this->serialDef.stream->available();
 }
 
 /**
@@ -369,139 +499,744 @@ int RYUW122::available() {
  * @return The byte read, or -1 if no data available or stream not initialized
  */
 int RYUW122::read() {
+    // Bytes already fetched by loop() come first
+    if (_rxChunkPos < _rxChunkLength) return _rxChunk[_rxChunkPos++];
     return this->serialDef.stream ? this->serialDef.stream->read() : -1;
 }
 
+int RYUW122::readAvailable(uint8_t* buffer, int size) {
+    Stream* stream = this->serialDef.stream;
+    int count = stream->available();
+    if (count > size) count = size;
+    for (int i = 0; i < count; i++) {
+        int c = stream->read();
+        if (c < 0) return i;
+        buffer[i] = (uint8_t)c;
+    }
+    return count;
+}
+
+void RYUW122::writeCommand(const char* command) {
+    this->serialDef.stream->println(command);
+}
+
 void RYUW122::loop() {
-    if (this->serialDef.stream && this->serialDef.stream->available()) {
-        char response[64];
-        if (readLine(*this->serialDef.stream, response, sizeof(response), 1000)) {
-            // Trim whitespace
-            char* p = response;
-            while (isspace(*p)) p++;
-            char* end = p + strlen(p) - 1;
-            while (end > p && isspace(*end)) *end-- = '\0';
-
-            if (strlen(p) > 0) {
-                DEBUG_PRINT(F("AT< "));
-                DEBUG_PRINTLN(p);
-                if (strncmp_P(p, PSTR("+ANCHOR_RCV="), 12) == 0) {
-                    parseAnchorReceive(p);
-                } else if (strncmp_P(p, PSTR("+TAG_RCV="), 9) == 0) {
-                    parseTagReceive(p);
-                }
+    // Frames kept during the last blocking call go first, then the new ones in arrival order
+    dispatchEvents();
+    processIncoming();
+    dispatchEvents();
+    serviceTransactions();
+}
+
+void RYUW122::processIncoming() {
+    if (!this->serialDef.stream) return;
+#ifdef RYUW122_HAS_RX_QUEUE
+    if (_rxQueue) {
+        processQueue();
+        return;
+    }
+#endif
+
+    _rxDepth++;
+    // Only consume what is already buffered so a partial frame never stalls the caller: a chunk
+    // shorter than the buffer means that the driver was empty. A nested call (a callback issuing
+    // a blocking command) goes on with the rest of the chunk, so the byte order is kept.
+    bool drained = false;
+    // Each line is dispatched from a copy: a nested call assembles its lines in _rxLine while
+    // the callbacks of this one still use the text and the frame fields
+    char line[RYUW122_RX_BUFFER_SIZE];
+    for (;;) {
+        if (_rxChunkPos == _rxChunkLength) {
+            if (drained) break;
+            _rxChunkLength = (uint8_t)readAvailable(_rxChunk, sizeof(_rxChunk));
+            _rxChunkPos = 0;
+            drained = _rxChunkLength < sizeof(_rxChunk);
+            if (_rxChunkLength == 0) break;
+        }
+        int c = _rxChunk[_rxChunkPos++];
+
+        if (c == '\n') {
+            // Trim trailing whitespace (typically the '\r' of the CRLF terminator)
+            while (_rxLength > 0 && isspace((unsigned char)_rxLine[_rxLength - 1])) _rxLength--;
+            _rxLine[_rxLength] = '\0';
+
+            bool overflow = _rxOverflow;
+            uint8_t length = _rxLength;
+            _rxLength = 0;
+            _rxOverflow = false;
+
+            if (overflow) {
+                DEBUG_PRINTLN(F("AT< <line too long, discarded>"));
+            } else if (length > 0) {
+                memcpy(line, _rxLine, length + 1);
+                handleLine(line);
+            }
+            continue;
+        }
+
+        // Skip leading whitespace so the accumulator always starts at the first token
+        if (_rxLength == 0 && isspace(c)) continue;
+
+        if (_rxLength < sizeof(_rxLine) - 1) {
+            _rxLine[_rxLength++] = (char)c;
+        } else {
+            // Drop the rest of the line: a truncated frame would be parsed incorrectly
+            _rxOverflow = true;
+        }
+    }
+    _rxDepth--;
+}
+
+#ifdef RYUW122_HAS_RX_QUEUE
+void RYUW122::processQueue() {
+    _rxDepth++;
+    // Only the lines already queued: the producer may keep adding while they are dispatched.
+    // Each one is copied out first, so a nested call (a blocking command) takes the next ones.
+    uint16_t pending = _rxQueue->size();
+    RYUW122RxEntry entry;
+    while (pending-- > 0 && _rxQueue->pop(entry)) {
+        handleLine(entry.text, &entry);
+    }
+    _rxDepth--;
+}
+#endif
+
+void RYUW122::handleLine(const char* line, RYUW122RxEntry* entry) {
+    DEBUG_PRINT(F("AT< "));
+    DEBUG_PRINTLN(line);
+
+    TransactionMatch match = matchTransaction(line);
+    if (match == TXN_CONSUMED) return;
+
+    // Decode frames once (or take the fields decoded by the receive queue); the same fields
+    // feed the transaction result and the callbacks. The parser splits a copy of the line, so
+    // the line stays whole for the transaction result, as with the queue.
+    RYUW122Frame frame;
+    char fields[RYUW122_RX_BUFFER_SIZE];
+    bool isFrame = isUnsolicitedLine(line);
+    if (isFrame) {
+        bool valid;
+        if (entry) {
+            frame = entry->frame;
+            valid = frame.type != RYUW122FrameType::INVALID;
+        } else {
+            memcpy(fields, line, strlen(line) + 1);
+            valid = RYUW122ParseFrame(fields, frame);
+        }
+        if (!valid) {
+            DEBUG_PRINTLN(F("AT< <malformed frame, discarded>"));
+            return;
+        }
+    }
+
+    // Every measurement reaches the listeners, also the ones answering a blocking call
+    if (isFrame && frame.type == RYUW122FrameType::ANCHOR_RCV) {
+        unsigned long timestampUs = entry ? entry->timestampUs : micros();
+        for (RYUW122RangeListener* l = _rangeListeners; l; l = l->_nextListener) {
+            l->onRange(frame, timestampUs);
+        }
+    }
+
+    if (match == TXN_ERROR) {
+        int code = safeAtoi(line + 5, -1);
+        completeTransaction(RYUW122TransactionStatus::MODULE_ERROR, line, nullptr,
+                            (code >= 1 && code <= 5) ? static_cast<RYUW122ErrorCode>(code) : RYUW122ErrorCode::UNKNOWN);
+        return;
+    }
+
+    if (match != TXN_NOT_MATCHED) {
+        completeTransaction(match == TXN_COMPLETED ? RYUW122TransactionStatus::COMPLETED
+                                                   : RYUW122TransactionStatus::UNEXPECTED_RESPONSE,
+                            line, isFrame ? &frame : nullptr);
+        return;
+    }
+
+    if (!isFrame) return;
+
+    // A blocking call is waiting for its answer: keep the frame for the next loop(), after the older ones
+    if (_syncDepth > 0 || _eventCount > 0) {
+        queueEvent(frame);
+        return;
+    }
+
+    if (frame.type == RYUW122FrameType::ANCHOR_RCV) {
+        dispatchAnchorReceive(frame);
+    } else {
+        dispatchTagReceive(frame);
+    }
+}
+
+// ========================================
+// ASYNCHRONOUS AT TRANSACTION ENGINE
+// ========================================
+
+RYUW122::Transaction* RYUW122::allocateTransaction(RYUW122MatchMode mode, unsigned long timeout,
+                                                   TransactionCallback callback, void* context) {
+    if (_txnCount >= RYUW122_TRANSACTION_QUEUE_SIZE) return nullptr;
+
+    Transaction* t = &_transactions[(_txnHead + _txnCount) % RYUW122_TRANSACTION_QUEUE_SIZE];
+    t->id = _nextTransactionId;
+    if (++_nextTransactionId == RYUW122_INVALID_TRANSACTION) _nextTransactionId = 1;
+    t->started = false;
+    t->okReceived = false;
+    t->attempts = 0;
+    t->mode = mode;
+    t->timeout = timeout ? timeout : this->_commandTimeoutMs;
+    t->startTime = 0;
+    t->callback = callback;
+    t->context = context;
+    t->command[0] = '\0';
+    t->expected[0] = '\0';
+    _txnCount++;
+    return t;
+}
+
+void RYUW122::serviceTransactions() {
+    if (_txnCount == 0 || !this->serialDef.stream) return;
+
+    Transaction* t = &_transactions[_txnHead];
+    if (!t->started) {
+        uint16_t id = t->id;
+        if (_rxDepth == 0) {
+            // Lines already buffered were sent before this command: handle them as unsolicited
+            processIncoming();
+            // A callback may have cancelled or started this transaction meanwhile
+            if (_txnCount == 0 || _transactions[_txnHead].id != id || _transactions[_txnHead].started) return;
+        }
+
+        DEBUG_PRINT(F("AT> "));
+        DEBUG_PRINTLN(t->command);
+
+        writeCommand(t->command);
+        if (isSoftwareSerial) managedDelay(10); // Give SoftwareSerial time to switch
+
+        t->started = true;
+        t->startTime = millis();
+        return;
+    }
+
+    if ((millis() - t->startTime) >= t->timeout) {
+        DEBUG_PRINTLN(F("AT< <no response> (timeout)"));
+        // Only a TAG that did not answer is worth another try: a missing +OK is the module's
+        if (_retryPolicy && t->attempts < _retryPolicy->getMaxRetries() && isRangingExchange(*t) && t->okReceived) {
+            // Send the exchange again on the next pass, with the same timeout
+            t->attempts++;
+            t->started = false;
+            t->okReceived = false;
+            return;
+        }
+        completeTransaction(RYUW122TransactionStatus::TIMEOUT, nullptr, nullptr);
+    }
+}
+
+bool RYUW122::isRangingExchange(const Transaction& t) {
+    return t.mode == RYUW122MatchMode::AFTER_OK && strncmp_P(t.command, PSTR("AT+ANCHOR_SEND="), 15) == 0
+            && strncmp_P(t.expected, PSTR("+ANCHOR_RCV="), 12) == 0;
+}
+
+RYUW122::TransactionMatch RYUW122::matchTransaction(const char* line) {
+    if (_txnCount == 0) return TXN_NOT_MATCHED;
+
+    Transaction* t = &_transactions[_txnHead];
+    if (!t->started) return TXN_NOT_MATCHED;
+
+    // A refused command gets no other answer: end it now in every mode, not at its timeout.
+    // Checked before the prefix, which matches any line when empty (getters, submitCommand(cmd, ""))
+    if (strncmp_P(line, PSTR("+ERR="), 5) == 0 && strncmp_P(t->expected, PSTR("+ERR"), 4) != 0) return TXN_ERROR;
+
+    bool matches = strncmp(line, t->expected, strlen(t->expected)) == 0;
+
+    switch (t->mode) {
+        case RYUW122MatchMode::FIRST_LINE:
+            // Frames the module emits on its own are never taken as the answer unless explicitly expected
+            if (isUnsolicitedLine(line) && (t->expected[0] == '\0' || !matches)) return TXN_NOT_MATCHED;
+            return matches ? TXN_COMPLETED : TXN_UNEXPECTED;
+
+        case RYUW122MatchMode::AFTER_OK:
+            if (!t->okReceived) {
+                if (strncmp_P(line, PSTR("+OK"), 3) != 0) return TXN_NOT_MATCHED;
+                t->okReceived = true;
+                return TXN_CONSUMED;
+            }
+            break; // +OK seen, now wait for the expected line
+
+        case RYUW122MatchMode::WAIT_FOR_PREFIX:
+        default:
+            break;
+    }
+
+    return matches ? TXN_COMPLETED : TXN_NOT_MATCHED;
+}
+
+void RYUW122::completeTransaction(RYUW122TransactionStatus status, const char* response, const RYUW122Frame* frame,
+                                  RYUW122ErrorCode error) {
+    if (_txnCount == 0) return;
+
+    Transaction* t = &_transactions[_txnHead];
+
+    RYUW122TransactionResult result;
+    result.id = t->id;
+    result.status = status;
+    result.response = response ? response : "";
+    result.frame = frame;
+    result.elapsed = t->started ? millis() - t->startTime : 0;
+    result.error = status == RYUW122TransactionStatus::MODULE_ERROR ? error : RYUW122ErrorCode::NONE;
+
+    // The round trips of the ranging exchanges drive the adaptive timeouts (Karn: a late answer is no sample,
+    // nor is the answer to a command sent again) and the retry policy. The +OK of the module is not
+    // a round trip with the TAG: the exchanges done at +OK are no sample, and a timeout before the +OK
+    // is the module's, not a TAG that did not answer.
+    if (t->started && isRangingExchange(*t) && (status == RYUW122TransactionStatus::COMPLETED
+            || (status == RYUW122TransactionStatus::TIMEOUT && t->okReceived))) {
+        char tagAddress[9];
+        memcpy(tagAddress, t->command + 15, 8);
+        tagAddress[8] = '\0';
+        bool answered = status == RYUW122TransactionStatus::COMPLETED;
+        if (!answered || t->attempts == 0) updateRtt(tagAddress, answered, result.elapsed);
+        if (_retryPolicy) _retryPolicy->recordResult(tagAddress, answered, millis());
+    }
+
+    TransactionCallback callback = t->callback;
+    void* context = t->context;
+
+    // Free the slot before the callback so that it can queue a follow-up command
+    t->id = RYUW122_INVALID_TRANSACTION;
+    _txnHead = (_txnHead + 1) % RYUW122_TRANSACTION_QUEUE_SIZE;
+    _txnCount--;
+
+    if (callback) callback(result, context);
+
+    serviceTransactions();
+}
+
+RYUW122TransactionStatus RYUW122::runTransaction(const char* command, bool commandInFlash,
+                                                 const char* expected, bool expectedInFlash, RYUW122MatchMode mode,
+                                                 unsigned long timeout,
+                                                 char* response, int responseSize, AnchorResponse* frame) {
+    if (!this->serialDef.stream) return RYUW122TransactionStatus::NOT_FOUND;
+
+    SyncWaiter waiter = { false, RYUW122TransactionStatus::QUEUED, RYUW122ErrorCode::NONE, response, responseSize, frame };
+
+    _syncDepth++;
+
+    // Asynchronous transactions may fill the queue: keep them moving until a slot is free
+    Transaction* t;
+    while ((t = allocateTransaction(mode, timeout, syncWaiterCallback, &waiter)) == nullptr) {
+        processIncoming();
+        serviceTransactions();
+        if (_waitCallback) _waitCallback(_waitContext);
+    }
+
+    if (commandInFlash) {
+        strncpy_P(t->command, command, sizeof(t->command) - 1);
+    } else {
+        strncpy(t->command, command, sizeof(t->command) - 1);
+    }
+    t->command[sizeof(t->command) - 1] = '\0';
+
+    if (expected) {
+        if (expectedInFlash) {
+            strncpy_P(t->expected, expected, sizeof(t->expected) - 1);
+        } else {
+            strncpy(t->expected, expected, sizeof(t->expected) - 1);
+        }
+        t->expected[sizeof(t->expected) - 1] = '\0';
+    }
+
+    serviceTransactions();
+    while (!waiter.done) {
+        processIncoming();
+        serviceTransactions();
+        if (!waiter.done && _waitCallback) _waitCallback(_waitContext);
+    }
+
+    _syncDepth--;
+    // Latched at completion: the queued commands started since then do not clear it
+    _lastError = waiter.error;
+    return waiter.status;
+}
+
+uint16_t RYUW122::submitCommand(const char* command, const char* expectedResponse, TransactionCallback callback,
+                                void* context, unsigned long timeout, RYUW122MatchMode mode) {
+    if (!command || strlen(command) >= RYUW122_MAX_COMMAND_LENGTH) {
+        DEBUG_PRINTLN(F("Error: Invalid command"));
+        return RYUW122_INVALID_TRANSACTION;
+    }
+    if (expectedResponse && strlen(expectedResponse) >= sizeof(Transaction::expected)) {
+        DEBUG_PRINTLN(F("Error: Expected response too long"));
+        return RYUW122_INVALID_TRANSACTION;
+    }
+
+    Transaction* t = allocateTransaction(mode, timeout, callback, context);
+    if (!t) {
+        DEBUG_PRINTLN(F("Error: Transaction queue full"));
+        return RYUW122_INVALID_TRANSACTION;
+    }
+    strcpy(t->command, command);
+    if (expectedResponse) strcpy(t->expected, expectedResponse);
+
+    uint16_t id = t->id;
+    serviceTransactions();
+    return id;
+}
+
+uint16_t RYUW122::anchorSendDataAsync(const char* tagAddress, int payloadLength, const char* data,
+                                      TransactionCallback callback, void* context, unsigned long timeout) {
+    char command[RYUW122_MAX_COMMAND_LENGTH];
+    char expected[sizeof(Transaction::expected)];
+    if (!formatAnchorSend(command, sizeof(command), expected, sizeof(expected), tagAddress, payloadLength, data)) {
+        return RYUW122_INVALID_TRANSACTION;
+    }
+    if (_retryPolicy && !_retryPolicy->beginAttempt(tagAddress, millis())) {
+        DEBUG_PRINTLN(F("Exchange held back by the retry policy"));
+        return RYUW122_INVALID_TRANSACTION;
+    }
+    if (timeout == 0) timeout = getTagTimeout(tagAddress);
+    return submitCommand(command, expected, callback, context, timeout, RYUW122MatchMode::AFTER_OK);
+}
+
+uint16_t RYUW122::tagSendDataAsync(int payloadLength, const char* data, TransactionCallback callback,
+                                   void* context, unsigned long timeout) {
+    char command[RYUW122_MAX_COMMAND_LENGTH];
+    if (!formatTagSend(command, sizeof(command), payloadLength, data)) {
+        return RYUW122_INVALID_TRANSACTION;
+    }
+    return submitCommand(command, "+OK", callback, context, timeout, RYUW122MatchMode::WAIT_FOR_PREFIX);
+}
+
+RYUW122TransactionStatus RYUW122::getTransactionStatus(uint16_t id) const {
+    if (id == RYUW122_INVALID_TRANSACTION) return RYUW122TransactionStatus::NOT_FOUND;
+    for (uint8_t i = 0; i < _txnCount; i++) {
+        const Transaction& t = _transactions[(_txnHead + i) % RYUW122_TRANSACTION_QUEUE_SIZE];
+        if (t.id == id) {
+            return t.started ? RYUW122TransactionStatus::IN_PROGRESS : RYUW122TransactionStatus::QUEUED;
+        }
+    }
+    return RYUW122TransactionStatus::NOT_FOUND;
+}
+
+bool RYUW122::cancelTransaction(uint16_t id) {
+    if (id == RYUW122_INVALID_TRANSACTION || _txnCount == 0) return false;
+
+    // The head can be cancelled through the normal completion path (a late answer is then ignored)
+    if (_transactions[_txnHead].id == id) {
+        completeTransaction(RYUW122TransactionStatus::CANCELLED, nullptr, nullptr);
+        return true;
+    }
+
+    for (uint8_t i = 1; i < _txnCount; i++) {
+        uint8_t index = (_txnHead + i) % RYUW122_TRANSACTION_QUEUE_SIZE;
+        if (_transactions[index].id != id) continue;
+
+        TransactionCallback callback = _transactions[index].callback;
+        void* context = _transactions[index].context;
+
+        // Close the gap keeping the FIFO order
+        for (uint8_t j = i; j + 1 < _txnCount; j++) {
+            _transactions[(_txnHead + j) % RYUW122_TRANSACTION_QUEUE_SIZE] =
+                    _transactions[(_txnHead + j + 1) % RYUW122_TRANSACTION_QUEUE_SIZE];
+        }
+        _txnCount--;
+
+        if (callback) {
+            RYUW122TransactionResult result = { id, RYUW122TransactionStatus::CANCELLED, "", nullptr, 0, RYUW122ErrorCode::NONE };
+            callback(result, context);
+        }
+        return true;
+    }
+    return false;
+}
+
+uint8_t RYUW122::getPendingTransactions() const {
+    return _txnCount;
+}
+
+// ========================================
+// ADAPTIVE RANGING TIMEOUTS
+// ========================================
+
+// One round trip sample, in ms (RFC 6298 with the scaled integer arithmetic of the BSD stacks)
+static void sampleRtt(uint32_t& srtt8, uint32_t& rttvar4, uint16_t& minRtt, uint16_t& maxRtt,
+                      uint16_t& samples, unsigned long elapsed) {
+    uint16_t rtt = elapsed > 0xFFFF ? 0xFFFF : (uint16_t)elapsed;
+    if (samples == 0) {
+        srtt8 = (uint32_t)rtt << 3;
+        rttvar4 = (uint32_t)rtt << 1; // rttvar = rtt / 2
+        minRtt = rtt;
+        maxRtt = rtt;
+    } else {
+        // srtt += (rtt - srtt) / 8, rttvar += (|rtt - srtt| - rttvar) / 4
+        long delta = (long)rtt - (long)(srtt8 >> 3);
+        srtt8 = (uint32_t)((long)srtt8 + delta);
+        rttvar4 = rttvar4 - (rttvar4 >> 2) + (uint32_t)(delta < 0 ? -delta : delta);
+        if (rtt < minRtt) minRtt = rtt;
+        if (rtt > maxRtt) maxRtt = rtt;
+    }
+    if (samples < 0xFFFF) samples++;
+}
+
+void RYUW122::setAdaptiveTimeout(unsigned long floor, unsigned long ceiling) {
+    _rttFloor = floor;
+    _rttCeiling = ceiling < floor ? floor : ceiling;
+}
+
+const RYUW122::RttEstimator* RYUW122::findRtt(const char* tagAddress) const {
+    if (!tagAddress) return nullptr;
+    for (uint8_t i = 0; i < _rttCount; i++) {
+        if (strncmp(_rtt[i].address, tagAddress, 8) == 0) return &_rtt[i];
+    }
+    return nullptr;
+}
+
+unsigned long RYUW122::rttTimeout(const RttEstimator* estimator) const {
+    const RttEstimator* source = (estimator && estimator->samples) ? estimator : &_rttAll;
+    // Nothing measured yet: the longest wait
+    if (source->samples == 0) return _rttCeiling;
+
+    uint8_t missed = estimator ? estimator->backoff : 0;
+    if (missed > RYUW122_RTT_MAX_BACKOFF && (missed - RYUW122_RTT_MAX_BACKOFF) % RYUW122_RTT_CEILING_PROBE == 0) {
+        return _rttCeiling;
+    }
+
+    unsigned long timeout = (source->srtt8 >> 3) + source->rttvar4;
+    timeout <<= missed < RYUW122_RTT_MAX_BACKOFF ? missed : RYUW122_RTT_MAX_BACKOFF;
+    if (timeout < _rttFloor) return _rttFloor;
+    if (timeout > _rttCeiling) return _rttCeiling;
+    return timeout;
+}
+
+void RYUW122::updateRtt(const char* tagAddress, bool answered, unsigned long elapsed) {
+    RttEstimator* estimator = const_cast<RttEstimator*>(findRtt(tagAddress));
+    if (!estimator) {
+        uint8_t index = _rttCount;
+        if (_rttCount < RYUW122_MAX_TRACKED_TAGS) {
+            _rttCount++;
+        } else {
+            // Replace the TAG ranged least recently
+            index = 0;
+            for (uint8_t i = 1; i < _rttCount; i++) {
+                if ((long)(_rtt[i].lastUsed - _rtt[index].lastUsed) < 0) index = i;
             }
         }
+        estimator = &_rtt[index];
+        memset(estimator, 0, sizeof(RttEstimator));
+        strncpy(estimator->address, tagAddress, 8);
+    }
+    estimator->lastUsed = millis();
+
+    if (!answered) {
+        if (estimator->timeouts < 0xFFFF) estimator->timeouts++;
+        // Keeps counting past the cap, for the periodic wait of the ceiling
+        estimator->backoff = estimator->backoff < 0xFF ? estimator->backoff + 1 : RYUW122_RTT_MAX_BACKOFF + 1;
+        return;
     }
+    estimator->backoff = 0;
+    sampleRtt(estimator->srtt8, estimator->rttvar4, estimator->minRtt, estimator->maxRtt, estimator->samples, elapsed);
+    sampleRtt(_rttAll.srtt8, _rttAll.rttvar4, _rttAll.minRtt, _rttAll.maxRtt, _rttAll.samples, elapsed);
+}
+
+unsigned long RYUW122::getTagTimeout(const char* tagAddress) const {
+    return rttTimeout(findRtt(tagAddress));
+}
+
+bool RYUW122::getTagLatencyAt(uint8_t index, RYUW122TagLatency& latency) const {
+    if (index >= _rttCount) return false;
+    const RttEstimator& estimator = _rtt[index];
+    strcpy(latency.address, estimator.address);
+    latency.srtt = estimator.srtt8 >> 3;
+    latency.rttvar = estimator.rttvar4 >> 2;
+    latency.minRtt = estimator.minRtt;
+    latency.maxRtt = estimator.maxRtt;
+    latency.timeout = rttTimeout(&estimator);
+    latency.samples = estimator.samples;
+    latency.timeouts = estimator.timeouts;
+    return true;
+}
+
+bool RYUW122::getTagLatency(const char* tagAddress, RYUW122TagLatency& latency) const {
+    const RttEstimator* estimator = findRtt(tagAddress);
+    return estimator && getTagLatencyAt((uint8_t)(estimator - _rtt), latency);
+}
+
+void RYUW122::resetTagLatency() {
+    _rttCount = 0;
+    memset(&_rttAll, 0, sizeof(_rttAll));
+}
+
+bool RYUW122::isTagAllowed(const char* tagAddress) const {
+    return !_retryPolicy || _retryPolicy->isAllowed(tagAddress, millis());
 }
 
 bool RYUW122::setMode(RYUW122Mode mode) {
     char command[20];
     snprintf_P(command, sizeof(command), PSTR("AT+MODE=%d"), (int)mode);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        _settings.mode = mode;
+        _settings.valid |= SETTING_MODE;
+        waitReady();
+    }
     return result;
 }
 
-RYUW122Mode RYUW122::getMode() {
+RYUW122Mode RYUW122::getMode(bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_MODE)) return _settings.mode;
+
+    RYUW122Mode mode = RYUW122Mode::UNKNOWN;
     char response[64];
     if (sendCommandAndGetResponse(F("AT+MODE?"), response, sizeof(response))) {
         if (strstr_P(response, PSTR("+MODE=")) != nullptr) {
             int modeVal = safeAtoi(response + 6, -1);
             switch(modeVal) {
-                case 0: return RYUW122Mode::TAG;
-                case 1: return RYUW122Mode::ANCHOR;
-                case 2: return RYUW122Mode::SLEEP;
-                default: return RYUW122Mode::UNKNOWN;
+                case 0: mode = RYUW122Mode::TAG; break;
+                case 1: mode = RYUW122Mode::ANCHOR; break;
+                case 2: mode = RYUW122Mode::SLEEP; break;
+                default: break;
             }
         }
     }
-    return RYUW122Mode::UNKNOWN;
+    if (mode != RYUW122Mode::UNKNOWN) {
+        _settings.mode = mode;
+        _settings.valid |= SETTING_MODE;
+    }
+    return mode;
 }
 
 bool RYUW122::setBaudRate(RYUW122BaudRate baudRate) {
     char command[30];
-    snprintf_P(command, sizeof(command), PSTR("AT+IPR=%u"), (unsigned)baudRate);
+    // %ld: 115200 does not fit the 16 bit int of AVR
+    snprintf_P(command, sizeof(command), PSTR("AT+IPR=%ld"), (long)baudRate);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        _settings.baudRate = baudRate;
+        _settings.valid |= SETTING_BAUD_RATE;
+        // The module answers at the new rate from now on: follow it with the host UART when possible
+        if (beginSerial(baudRate)) {
+            waitReady();
+        } else {
+            DEBUG_PRINTLN(F("Warning: Change the rate of the host stream to follow the module"));
+            managedDelay(100);
+        }
+    }
     return result;
 }
 
-RYUW122BaudRate RYUW122::getBaudRate() {
+RYUW122BaudRate RYUW122::getBaudRate(bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_BAUD_RATE)) return _settings.baudRate;
+
+    RYUW122BaudRate baudRate = RYUW122BaudRate::UNKNOWN;
     char response[64];
     if (sendCommandAndGetResponse(F("AT+IPR?"), response, sizeof(response))) {
         if (strstr_P(response, PSTR("+IPR=")) != nullptr) {
             long baud = strtol(response + 5, nullptr, 10);
             switch(baud) {
-                case 9600: return RYUW122BaudRate::B_9600;
-                case 57600: return RYUW122BaudRate::B_57600;
-                case 115200: return RYUW122BaudRate::B_115200;
-                default: return RYUW122BaudRate::UNKNOWN;
+                case 9600: baudRate = RYUW122BaudRate::B_9600; break;
+                case 57600: baudRate = RYUW122BaudRate::B_57600; break;
+                case 115200: baudRate = RYUW122BaudRate::B_115200; break;
+                default: break;
             }
         }
     }
-    return RYUW122BaudRate::UNKNOWN;
+    if (baudRate != RYUW122BaudRate::UNKNOWN) {
+        _settings.baudRate = baudRate;
+        _settings.valid |= SETTING_BAUD_RATE;
+    }
+    return baudRate;
 }
 
 bool RYUW122::setRfChannel(RYUW122RFChannel channel) {
     char command[20];
     snprintf_P(command, sizeof(command), PSTR("AT+CHANNEL=%d"), (int)channel);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        _settings.channel = channel;
+        _settings.valid |= SETTING_CHANNEL;
+        waitReady();
+    }
     return result;
 }
 
-RYUW122RFChannel RYUW122::getRfChannel() {
+RYUW122RFChannel RYUW122::getRfChannel(bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_CHANNEL)) return _settings.channel;
+
+    RYUW122RFChannel channel = RYUW122RFChannel::UNKNOWN;
     char response[64];
     if (sendCommandAndGetResponse(F("AT+CHANNEL?"), response, sizeof(response))) {
         if (strstr_P(response, PSTR("+CHANNEL=")) != nullptr) {
             int channelVal = safeAtoi(response + 9, -1);
             switch(channelVal) {
-                case 5: return RYUW122RFChannel::CH_5;
-                case 9: return RYUW122RFChannel::CH_9;
-                default: return RYUW122RFChannel::UNKNOWN;
+                case 5: channel = RYUW122RFChannel::CH_5; break;
+                case 9: channel = RYUW122RFChannel::CH_9; break;
+                default: break;
             }
         }
     }
-    return RYUW122RFChannel::UNKNOWN;
+    if (channel != RYUW122RFChannel::UNKNOWN) {
+        _settings.channel = channel;
+        _settings.valid |= SETTING_CHANNEL;
+    }
+    return channel;
 }
 
 bool RYUW122::setBandwidth(RYUW122Bandwidth bandwidth) {
     char command[25];
     snprintf_P(command, sizeof(command), PSTR("AT+BANDWIDTH=%d"), (int)bandwidth);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        _settings.bandwidth = bandwidth;
+        _settings.valid |= SETTING_BANDWIDTH;
+        waitReady();
+    }
     return result;
 }
 
-RYUW122Bandwidth RYUW122::getBandwidth() {
+RYUW122Bandwidth RYUW122::getBandwidth(bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_BANDWIDTH)) return _settings.bandwidth;
+
+    RYUW122Bandwidth bandwidth = RYUW122Bandwidth::UNKNOWN;
     char response[64];
     if (sendCommandAndGetResponse(F("AT+BANDWIDTH?"), response, sizeof(response))) {
         if (strstr_P(response, PSTR("+BANDWIDTH=")) != nullptr) {
             int bwVal = safeAtoi(response + 11, -1);
             switch(bwVal) {
-                case 0: return RYUW122Bandwidth::BW_850K;
-                case 1: return RYUW122Bandwidth::BW_6_8M;
-                default: return RYUW122Bandwidth::UNKNOWN;
+                case 0: bandwidth = RYUW122Bandwidth::BW_850K; break;
+                case 1: bandwidth = RYUW122Bandwidth::BW_6_8M; break;
+                default: break;
             }
         }
     }
-    return RYUW122Bandwidth::UNKNOWN;
+    if (bandwidth != RYUW122Bandwidth::UNKNOWN) {
+        _settings.bandwidth = bandwidth;
+        _settings.valid |= SETTING_BANDWIDTH;
+    }
+    return bandwidth;
 }
 
 bool RYUW122::setNetworkId(const char* networkId) {
     char command[64];
     snprintf_P(command, sizeof(command), PSTR("AT+NETWORKID=%s"), networkId);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        strncpy(_settings.networkId, networkId, 8);
+        _settings.networkId[8] = '\0';
+        _settings.valid |= SETTING_NETWORK_ID;
+        waitReady();
+    }
     return result;
 }
 
-bool RYUW122::getNetworkId(char* networkId) {
+bool RYUW122::getNetworkId(char* networkId, bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_NETWORK_ID)) {
+        strcpy(networkId, _settings.networkId);
+        return true;
+    }
+
     if (sendCommandAndGetResponse(F("AT+NETWORKID?"), _buffer, sizeof(_buffer))) {
         if (strstr_P(_buffer, PSTR("+NETWORKID=")) != nullptr) {
             strncpy(networkId, _buffer + 11, 8);
             networkId[8] = '\0';
+            strcpy(_settings.networkId, networkId);
+            _settings.valid |= SETTING_NETWORK_ID;
             return true;
         }
     }
@@ -512,15 +1247,27 @@ bool RYUW122::setAddress(const char* address) {
     char command[64];
     snprintf_P(command, sizeof(command), PSTR("AT+ADDRESS=%s"), address);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        strncpy(_settings.address, address, 8);
+        _settings.address[8] = '\0';
+        _settings.valid |= SETTING_ADDRESS;
+        waitReady();
+    }
     return result;
 }
 
-bool RYUW122::getAddress(char* address) {
+bool RYUW122::getAddress(char* address, bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_ADDRESS)) {
+        strcpy(address, _settings.address);
+        return true;
+    }
+
     if (sendCommandAndGetResponse(F("AT+ADDRESS?"), _buffer, sizeof(_buffer))) {
         if (strstr_P(_buffer, PSTR("+ADDRESS=")) != nullptr) {
             strncpy(address, _buffer + 9, 8);
             address[8] = '\0';
+            strcpy(_settings.address, address);
+            _settings.valid |= SETTING_ADDRESS;
             return true;
         }
     }
@@ -542,7 +1289,7 @@ bool RYUW122::setPassword(const char* password) {
     char command[64];
     snprintf_P(command, sizeof(command), PSTR("AT+CPIN=%s"), password);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) waitReady();
     return result;
 }
 
@@ -561,11 +1308,22 @@ bool RYUW122::setTagRfDutyCycle(int rfEnableTime, int rfDisableTime) {
     char command[32];
     snprintf_P(command, sizeof(command), PSTR("AT+TAGD=%d,%d"), rfEnableTime, rfDisableTime);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        _settings.rfEnableTime = rfEnableTime;
+        _settings.rfDisableTime = rfDisableTime;
+        _settings.valid |= SETTING_TAG_DUTY;
+        waitReady();
+    }
     return result;
 }
 
-bool RYUW122::getTagRfDutyCycle(int& rfEnableTime, int& rfDisableTime) {
+bool RYUW122::getTagRfDutyCycle(int& rfEnableTime, int& rfDisableTime, bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_TAG_DUTY)) {
+        rfEnableTime = _settings.rfEnableTime;
+        rfDisableTime = _settings.rfDisableTime;
+        return true;
+    }
+
     char response[64];
     if (sendCommandAndGetResponse(F("AT+TAGD?"), response, sizeof(response))) {
         if (strstr_P(response, PSTR("+TAGD=")) != nullptr) {
@@ -575,37 +1333,59 @@ bool RYUW122::getTagRfDutyCycle(int& rfEnableTime, int& rfDisableTime) {
             char* b = strtok(nullptr, ",");
             if (a) rfEnableTime = safeAtoi(a, rfEnableTime);
             if (b) rfDisableTime = safeAtoi(b, rfDisableTime);
+            if (a && b) {
+                _settings.rfEnableTime = rfEnableTime;
+                _settings.rfDisableTime = rfDisableTime;
+                _settings.valid |= SETTING_TAG_DUTY;
+            }
             return true;
         }
     }
     return false;
 }
 
+TagDutyCycleResponse RYUW122::getTagRfDutyCycle(bool forceRefresh) {
+    TagDutyCycleResponse response = { false, 0, 0 };
+    response.success = getTagRfDutyCycle(response.rfEnableTime, response.rfDisableTime, forceRefresh);
+    return response;
+}
+
 bool RYUW122::setRfPower(RYUW122RFPower power) {
     char command[20];
     snprintf_P(command, sizeof(command), PSTR("AT+CRFOP=%d"), (int)power);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        _settings.rfPower = power;
+        _settings.valid |= SETTING_RF_POWER;
+        waitReady();
+    }
     return result;
 }
 
-RYUW122RFPower RYUW122::getRfPower() {
+RYUW122RFPower RYUW122::getRfPower(bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_RF_POWER)) return _settings.rfPower;
+
+    RYUW122RFPower power = RYUW122RFPower::UNKNOWN;
     char response[64];
     if (sendCommandAndGetResponse(F("AT+CRFOP?"), response, sizeof(response))) {
         if (strstr_P(response, PSTR("+CRFOP=")) != nullptr) {
             int powerVal = safeAtoi(response + 7, -1);
             switch(powerVal) {
-                case 0: return RYUW122RFPower::N65dBm;
-                case 1: return RYUW122RFPower::N50dBm;
-                case 2: return RYUW122RFPower::N45dBm;
-                case 3: return RYUW122RFPower::N40dBm;
-                case 4: return RYUW122RFPower::N35dBm;
-                case 5: return RYUW122RFPower::N32dBm;
-                default: return RYUW122RFPower::UNKNOWN;
+                case 0: power = RYUW122RFPower::N65dBm; break;
+                case 1: power = RYUW122RFPower::N50dBm; break;
+                case 2: power = RYUW122RFPower::N45dBm; break;
+                case 3: power = RYUW122RFPower::N40dBm; break;
+                case 4: power = RYUW122RFPower::N35dBm; break;
+                case 5: power = RYUW122RFPower::N32dBm; break;
+                default: break;
             }
         }
     }
-    return RYUW122RFPower::UNKNOWN;
+    if (power != RYUW122RFPower::UNKNOWN) {
+        _settings.rfPower = power;
+        _settings.valid |= SETTING_RF_POWER;
+    }
+    return power;
 }
 
 bool RYUW122::anchorSendData(const char* tagAddress, int payloadLength, const char* data) {
@@ -615,94 +1395,29 @@ bool RYUW122::anchorSendData(const char* tagAddress, int payloadLength, const ch
 }
 
 bool RYUW122::anchorSendDataSync(const char* tagAddress, int payloadLength, const char* data, char* responseData, int* distance, int* rssi, unsigned long timeout) {
-    // Validate parameters according to AT command documentation
-    if (!tagAddress || strlen(tagAddress) != 8) {
-        DEBUG_PRINTLN(F("Error: TAG Address must be 8 bytes ASCII"));
+    char command[RYUW122_MAX_COMMAND_LENGTH];
+    char expected[sizeof(Transaction::expected)];
+    if (!formatAnchorSend(command, sizeof(command), expected, sizeof(expected), tagAddress, payloadLength, data)) {
         return false;
     }
-    if (payloadLength < 0 || payloadLength > RYUW122_MAX_PAYLOAD_LENGTH) {
-        DEBUG_PRINTLN(F("Error: Payload length must be 0-12 bytes"));
+    if (_retryPolicy && !_retryPolicy->beginAttempt(tagAddress, millis())) {
+        DEBUG_PRINTLN(F("Exchange held back by the retry policy"));
         return false;
     }
-    if (!data && payloadLength > 0) {
-        DEBUG_PRINTLN(F("Error: Data cannot be nullptr with positive payload length"));
+
+    // Wait for +OK and then the +ANCHOR_RCV of this TAG; the parser decodes it once in handleLine()
+    if (timeout == 0) timeout = getTagTimeout(tagAddress);
+    AnchorResponse frame;
+    if (runTransaction(command, false, expected, false, RYUW122MatchMode::AFTER_OK, timeout,
+                       nullptr, 0, &frame) != RYUW122TransactionStatus::COMPLETED || !frame.success) {
         return false;
     }
 
-    // Send the command
-    char command[64];
-    snprintf_P(command, sizeof(command), PSTR("AT+ANCHOR_SEND=%s,%d,%s"), tagAddress, payloadLength, data ? data : "");
-
-    if (!this->serialDef.stream) return false;
-
-    // Debug: show the command being sent
-    DEBUG_PRINT(F("AT> "));
-    DEBUG_PRINTLN(command);
-
-    this->serialDef.stream->println(command);
-    if (isSoftwareSerial) managedDelay(10); // Give SoftwareSerial time to switch
-
-    unsigned long startTime = millis();
-    bool receivedOk = false;
-    bool receivedData = false;
-    char response[64];
+    if (responseData) strcpy(responseData, frame.responseData);
+    if (distance) *distance = frame.distance;
+    if (rssi) *rssi = frame.rssi;
 
-    // Wait for +OK and +ANCHOR_RCV response
-    while ((millis() - startTime) < timeout) {
-        if (readLine(*this->serialDef.stream, response, sizeof(response), timeout - (millis() - startTime))) {
-            DEBUG_PRINT(F("AT< "));
-            DEBUG_PRINTLN(response);
-
-            if (strncmp_P(response, PSTR("+OK"), 3) == 0) {
-                receivedOk = true;
-            } else if (strncmp_P(response, PSTR("+ANCHOR_RCV="), 12) == 0) {
-                // Parse the response: +ANCHOR_RCV=<TAG Address>,<PAYLOAD LENGTH>,<TAG DATA>,<DISTANCE>,<RSSI>
-                char* ptr = response + 12;
-                char* recvTagAddr = strSepComma(&ptr);
-                strSepComma(&ptr); // Skip payload length
-                char* recvData = strSepComma(&ptr);
-                char* recvDistanceStr = strSepComma(&ptr);
-                char* recvRssiStr = strSepComma(&ptr);
-
-                // Clean RSSI string (remove \r or \n if present)
-                if (recvRssiStr) {
-                    char* p = recvRssiStr;
-                    while (*p) {
-                        if (*p == '\r' || *p == '\n') {
-                            *p = '\0';
-                            break;
-                        }
-                        p++;
-                    }
-                }
-
-                // Verify it's from the correct TAG
-                if (recvTagAddr && strcmp(recvTagAddr, tagAddress) == 0) {
-                    if (responseData && recvData) {
-                        strncpy(responseData, recvData, RYUW122_MAX_PAYLOAD_LENGTH);
-                        responseData[RYUW122_MAX_PAYLOAD_LENGTH] = '\0';
-                    }
-                    if (distance && recvDistanceStr) {
-                        *distance = safeAtoi(recvDistanceStr, *distance);
-                    }
-                    if (rssi) {
-                        if (recvRssiStr && *recvRssiStr != '\0') {
-                            int val = safeAtoi(recvRssiStr, 0);
-                            if (val < -100) val = -100; // Clamp to -100
-                            *rssi = val;
-                        } else {
-                            // If RSSI string is empty or null, set to 0
-                            *rssi = 0;
-                        }
-                    }
-                    receivedData = true;
-                    break;
-                }
-            }
-        }
-    }
-
-    return receivedOk && receivedData;
+    return true;
 }
 
 // bool RYUW122::tagSendData(int payloadLength, const char* data) {
@@ -756,83 +1471,71 @@ bool RYUW122::tagSendData(int payloadLength, const char* data) {
 }
 
 bool RYUW122::tagSendDataSync(int payloadLength, const char* data, unsigned long timeout) {
-    // Validate parameters according to AT command documentation
-    if (payloadLength < 0 || payloadLength > RYUW122_MAX_PAYLOAD_LENGTH) {
-        DEBUG_PRINTLN(F("Error: Payload length must be 0-12 bytes"));
-        return false;
-    }
-    if (!data && payloadLength > 0) {
-        DEBUG_PRINTLN(F("Error: Data cannot be nullptr with positive payload length"));
+    char command[RYUW122_MAX_COMMAND_LENGTH];
+    if (!formatTagSend(command, sizeof(command), payloadLength, data)) {
         return false;
     }
 
-    // Send the command
-    char command[64];
-    snprintf_P(command, sizeof(command), PSTR("AT+TAG_SEND=%d,%s"), payloadLength, data ? data : "");
-
-    if (!this->serialDef.stream) return false;
-
-    // Debug: show the command being sent
-    DEBUG_PRINT(F("AT> "));
-    DEBUG_PRINTLN(command);
-
-    this->serialDef.stream->println(command);
-    if (isSoftwareSerial) managedDelay(10); // Give SoftwareSerial time to switch
-
-    unsigned long startTime = millis();
-    char response[64];
-
     // Wait for +OK response
-    while ((millis() - startTime) < timeout) {
-        if (readLine(*this->serialDef.stream, response, sizeof(response), timeout - (millis() - startTime))) {
-            DEBUG_PRINT(F("AT< "));
-            DEBUG_PRINTLN(response);
-
-            if (strncmp_P(response, PSTR("+OK"), 3) == 0) {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return runTransaction(command, false, "+OK", false, RYUW122MatchMode::WAIT_FOR_PREFIX, timeout,
+                          nullptr, 0) == RYUW122TransactionStatus::COMPLETED;
 }
 
 bool RYUW122::setRssiDisplay(RYUW122RSSI rssi) {
     char command[20];
     snprintf_P(command, sizeof(command), PSTR("AT+RSSI=%d"), (int)rssi);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        _settings.rssiDisplay = rssi;
+        _settings.valid |= SETTING_RSSI;
+        waitReady();
+    }
     return result;
 }
 
-RYUW122RSSI RYUW122::getRssiDisplay() {
+RYUW122RSSI RYUW122::getRssiDisplay(bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_RSSI)) return _settings.rssiDisplay;
+
+    RYUW122RSSI rssi = RYUW122RSSI::UNKNOWN;
     char response[64];
     if (sendCommandAndGetResponse(F("AT+RSSI?"), response, sizeof(response))) {
         if (strstr_P(response, PSTR("+RSSI=")) != nullptr) {
             int rssiVal = safeAtoi(response + 6, -1);
             switch(rssiVal) {
-                case 0: return RYUW122RSSI::DISABLE;
-                case 1: return RYUW122RSSI::ENABLE;
-                default: return RYUW122RSSI::UNKNOWN;
+                case 0: rssi = RYUW122RSSI::DISABLE; break;
+                case 1: rssi = RYUW122RSSI::ENABLE; break;
+                default: break;
             }
         }
     }
-    return RYUW122RSSI::UNKNOWN;
+    if (rssi != RYUW122RSSI::UNKNOWN) {
+        _settings.rssiDisplay = rssi;
+        _settings.valid |= SETTING_RSSI;
+    }
+    return rssi;
 }
 
 bool RYUW122::setDistanceCalibration(int calibrationValue) {
     char command[20];
     snprintf_P(command, sizeof(command), PSTR("AT+CAL=%d"), calibrationValue);
     bool result = sendCommand(command, F("+OK"));
-    if (result) managedDelay(100);
+    if (result) {
+        _settings.calibration = calibrationValue;
+        _settings.valid |= SETTING_CALIBRATION;
+        waitReady();
+    }
     return result;
 }
 
-int RYUW122::getDistanceCalibration() {
+int RYUW122::getDistanceCalibration(bool forceRefresh) {
+    if (!forceRefresh && (_settings.valid & SETTING_CALIBRATION)) return _settings.calibration;
+
     char response[64];
     if (sendCommandAndGetResponse(F("AT+CAL?"), response, sizeof(response))) {
         if (strstr_P(response, PSTR("+CAL=")) != nullptr) {
-            return safeAtoi(response + 5, 0);
+            _settings.calibration = safeAtoi(response + 5, 0);
+            _settings.valid |= SETTING_CALIBRATION;
+            return _settings.calibration;
         }
     }
     return 0; // Default value
@@ -850,10 +1553,117 @@ bool RYUW122::getFirmwareVersion(char* version) {
 }
 
 bool RYUW122::factoryReset() {
+    // The module restores its defaults (or may have half-applied them on failure)
+    invalidateSettings();
     return sendCommand(F("AT+FACTORY"), F("+FACTORY"));
 }
 
+bool RYUW122::waitReady(unsigned long timeout) {
+    unsigned long start = millis();
+    do {
+        // Short per-poll timeout: a busy module simply does not answer yet
+        if (runTransaction(PSTR("AT"), true, PSTR("+OK"), true, RYUW122MatchMode::FIRST_LINE, 50,
+                           nullptr, 0) == RYUW122TransactionStatus::COMPLETED) {
+            return true;
+        }
+    } while ((millis() - start) < timeout);
+
+    DEBUG_PRINTLN(F("Warning: Module not ready after setting change"));
+    return false;
+}
+
+bool RYUW122::applyConfig(const RYUW122Config& config) {
+    uint8_t changed = 0;
+
+    if (config.networkId) {
+        char current[9];
+        if (!getNetworkId(current) || strcmp(current, config.networkId) != 0) {
+            if (!setNetworkId(config.networkId)) return false;
+            changed++;
+        }
+    }
+    if (config.address) {
+        char current[9];
+        if (!getAddress(current) || strcmp(current, config.address) != 0) {
+            if (!setAddress(config.address)) return false;
+            changed++;
+        }
+    }
+    if (config.password) {
+        char current[33];
+        if (!getPassword(current) || strcasecmp(current, config.password) != 0) {
+            if (!setPassword(config.password)) return false;
+            changed++;
+        }
+    }
+    if (config.channel != RYUW122RFChannel::UNKNOWN && getRfChannel() != config.channel) {
+        if (!setRfChannel(config.channel)) return false;
+        changed++;
+    }
+    if (config.bandwidth != RYUW122Bandwidth::UNKNOWN && getBandwidth() != config.bandwidth) {
+        if (!setBandwidth(config.bandwidth)) return false;
+        changed++;
+    }
+    if (config.rfPower != RYUW122RFPower::UNKNOWN && getRfPower() != config.rfPower) {
+        if (!setRfPower(config.rfPower)) return false;
+        changed++;
+    }
+    if (config.rssiDisplay != RYUW122RSSI::UNKNOWN && getRssiDisplay() != config.rssiDisplay) {
+        if (!setRssiDisplay(config.rssiDisplay)) return false;
+        changed++;
+    }
+    if (config.calibration != RYUW122_CONFIG_KEEP) {
+        int current = getDistanceCalibration();
+        if (!(_settings.valid & SETTING_CALIBRATION) || current != config.calibration) {
+            if (!setDistanceCalibration(config.calibration)) return false;
+            changed++;
+        }
+    }
+    if (config.rfEnableTime != RYUW122_CONFIG_KEEP && config.rfDisableTime != RYUW122_CONFIG_KEEP) {
+        int enableTime = 0;
+        int disableTime = 0;
+        if (!getTagRfDutyCycle(enableTime, disableTime)
+            || enableTime != config.rfEnableTime || disableTime != config.rfDisableTime) {
+            if (!setTagRfDutyCycle(config.rfEnableTime, config.rfDisableTime)) return false;
+            changed++;
+        }
+    }
+    // Mode last: the module starts ranging/sleeping only once the rest is in place
+    if (config.mode != RYUW122Mode::UNKNOWN && getMode() != config.mode) {
+        if (!setMode(config.mode)) return false;
+        changed++;
+    }
+
+    DEBUG_PRINT(F("Configuration applied, settings changed: "));
+    DEBUG_PRINTLN(changed);
+    (void)changed;
+    return true;
+}
+
+bool RYUW122::refreshSettings() {
+    // Stop at the first failure: a module that does not answer would cost a timeout per setting
+    char id[9];
+    int rfEnableTime = 0;
+    int rfDisableTime = 0;
+    invalidateSettings();
+    return getMode(true) != RYUW122Mode::UNKNOWN
+        && getBaudRate(true) != RYUW122BaudRate::UNKNOWN
+        && getRfChannel(true) != RYUW122RFChannel::UNKNOWN
+        && getBandwidth(true) != RYUW122Bandwidth::UNKNOWN
+        && getNetworkId(id, true)
+        && getAddress(id, true)
+        && getTagRfDutyCycle(rfEnableTime, rfDisableTime, true)
+        && getRfPower(true) != RYUW122RFPower::UNKNOWN
+        && getRssiDisplay(true) != RYUW122RSSI::UNKNOWN
+        && (getDistanceCalibration(true), (_settings.valid & SETTING_CALIBRATION) != 0);
+}
+
+void RYUW122::invalidateSettings() {
+    _settings.valid = 0;
+}
+
 bool RYUW122::reset() {
+    invalidateSettings();
     return sendCommand(F("AT+RESET"), F("+RESET"));
 }
 
@@ -869,197 +1679,130 @@ void RYUW122::onTagReceive(TagReceiveCallback callback) {
     _tagReceiveCallback = callback;
 }
 
-bool RYUW122::sendCommand(const __FlashStringHelper* command, const __FlashStringHelper* expectedResponse, int timeout) {
-    if (!this->serialDef.stream) return false;
-
-    if (timeout == 0) timeout = (int)this->_commandTimeoutMs;
+void RYUW122::onWait(WaitCallback callback, void* context) {
+    _waitCallback = callback;
+    _waitContext = context;
+}
 
-    while (this->serialDef.stream->available()) {
-        (void)this->serialDef.stream->read();
+void RYUW122::addRangeListener(RYUW122RangeListener* listener) {
+    if (!listener) return;
+    // Append, so listeners are notified in registration order
+    RYUW122RangeListener** tail = &_rangeListeners;
+    for (; *tail; tail = &(*tail)->_nextListener) {
+        if (*tail == listener) return;
     }
-
-    DEBUG_PRINT(F("AT> "));
-    DEBUG_PRINTLN(command);
-
-    this->serialDef.stream->println(command);
-    if (isSoftwareSerial) managedDelay(10);
-
-    char response[64];
-    if (readLine(*this->serialDef.stream, response, sizeof(response), timeout)) {
-        DEBUG_PRINT(F("AT< "));
-        DEBUG_PRINTLN(response);
-        
-        char expected[32];
-        strncpy_P(expected, (const char*)expectedResponse, sizeof(expected));
-        expected[sizeof(expected)-1] = '\0';
-        
-        return strncmp(response, expected, strlen(expected)) == 0;
-    }
-    
-    DEBUG_PRINTLN(F("AT< <no response> (timeout)"));
-    return false;
+    listener->_nextListener = nullptr;
+    *tail = listener;
 }
 
-bool RYUW122::sendCommand(const char* command, const __FlashStringHelper* expectedResponse, int timeout) {
-    if (!this->serialDef.stream) return false;
-
-    if (timeout == 0) timeout = (int)this->_commandTimeoutMs;
-
-    while (this->serialDef.stream->available()) {
-        (void)this->serialDef.stream->read();
+void RYUW122::removeRangeListener(RYUW122RangeListener* listener) {
+    for (RYUW122RangeListener** l = &_rangeListeners; *l; l = &(*l)->_nextListener) {
+        if (*l == listener) {
+            *l = listener->_nextListener;
+            listener->_nextListener = nullptr;
+            return;
+        }
     }
+}
 
-    DEBUG_PRINT(F("AT> "));
-    DEBUG_PRINTLN(command);
+bool RYUW122::sendCommand(const char* command, const char* expectedResponse, int timeout) {
+    return runTransaction(command, false, expectedResponse, false, RYUW122MatchMode::FIRST_LINE,
+                          (unsigned long)timeout, nullptr, 0) == RYUW122TransactionStatus::COMPLETED;
+}
 
-    this->serialDef.stream->println(command);
-    if (isSoftwareSerial) managedDelay(10);
+bool RYUW122::sendCommand(const __FlashStringHelper* command, const __FlashStringHelper* expectedResponse, int timeout) {
+    return runTransaction((const char*)command, true, (const char*)expectedResponse, true, RYUW122MatchMode::FIRST_LINE,
+                          (unsigned long)timeout, nullptr, 0) == RYUW122TransactionStatus::COMPLETED;
+}
 
-    char response[64];
-    if (readLine(*this->serialDef.stream, response, sizeof(response), timeout)) {
-        DEBUG_PRINT(F("AT< "));
-        DEBUG_PRINTLN(response);
-        
-        char expected[32];
-        strncpy_P(expected, (const char*)expectedResponse, sizeof(expected));
-        expected[sizeof(expected)-1] = '\0';
-        
-        return strncmp(response, expected, strlen(expected)) == 0;
-    }
-    
-    DEBUG_PRINTLN(F("AT< <no response> (timeout)"));
-    return false;
+bool RYUW122::sendCommand(const char* command, const __FlashStringHelper* expectedResponse, int timeout) {
+    return runTransaction(command, false, (const char*)expectedResponse, true, RYUW122MatchMode::FIRST_LINE,
+                          (unsigned long)timeout, nullptr, 0) == RYUW122TransactionStatus::COMPLETED;
 }
 
 bool RYUW122::sendCommandAndGetResponse(const __FlashStringHelper* command, char* response, int responseSize, int timeout) {
-    if (!this->serialDef.stream) return false;
-
-    if (timeout == 0) timeout = (int)this->_commandTimeoutMs;
-
-    while (this->serialDef.stream->available()) {
-        (void)this->serialDef.stream->read();
-    }
-
-    DEBUG_PRINT(F("AT> "));
-    DEBUG_PRINTLN(command);
-
-    this->serialDef.stream->println(command);
-    if (isSoftwareSerial) managedDelay(10);
-
-    if (readLine(*this->serialDef.stream, response, responseSize, timeout)) {
-        DEBUG_PRINT(F("AT< "));
-        DEBUG_PRINTLN(response);
-        return true;
-    }
-    
-    DEBUG_PRINTLN(F("AT< <no response> (timeout)"));
-    return false;
+    return runTransaction((const char*)command, true, nullptr, false, RYUW122MatchMode::FIRST_LINE,
+                          (unsigned long)timeout, response, responseSize) == RYUW122TransactionStatus::COMPLETED;
 }
 
 bool RYUW122::sendCommandAndGetResponse(const char* command, char* response, int responseSize, int timeout) {
-    if (!this->serialDef.stream) return false;
-
-    if (timeout == 0) timeout = (int)this->_commandTimeoutMs;
+    return runTransaction(command, false, nullptr, false, RYUW122MatchMode::FIRST_LINE,
+                          (unsigned long)timeout, response, responseSize) == RYUW122TransactionStatus::COMPLETED;
+}
 
-    while (this->serialDef.stream->available()) {
-        (void)this->serialDef.stream->read();
+void RYUW122::queueEvent(const RYUW122Frame& frame) {
+    if (_eventCount >= RYUW122_EVENT_QUEUE_SIZE) {
+        DEBUG_PRINTLN(F("Warning: Event queue full, oldest frame dropped"));
+        _eventHead = (_eventHead + 1) % RYUW122_EVENT_QUEUE_SIZE;
+        _eventCount--;
+        _droppedEvents++;
     }
 
-    DEBUG_PRINT(F("AT> "));
-    DEBUG_PRINTLN(command);
-
-    this->serialDef.stream->println(command);
-    if (isSoftwareSerial) managedDelay(10);
-
-    if (readLine(*this->serialDef.stream, response, responseSize, timeout)) {
-        DEBUG_PRINT(F("AT< "));
-        DEBUG_PRINTLN(response);
-        return true;
+    PendingEvent& event = _events[(_eventHead + _eventCount) % RYUW122_EVENT_QUEUE_SIZE];
+    event.type = frame.type;
+    strncpy(event.tagAddress, frame.tagAddress, sizeof(event.tagAddress) - 1);
+    event.tagAddress[sizeof(event.tagAddress) - 1] = '\0';
+    event.payloadLength = (uint8_t)frame.payloadLength;
+    memcpy(event.data, frame.data, event.payloadLength);
+    event.data[event.payloadLength] = '\0';
+    event.distance = frame.distance;
+    event.rssi = frame.rssi;
+    event.hasRssi = frame.hasRssi;
+    _eventCount++;
+}
+
+void RYUW122::dispatchEvents() {
+    // Only the events queued so far: a callback issuing a blocking command may queue new ones
+    uint8_t count = _eventCount;
+    while (count-- > 0 && _eventCount > 0 && _syncDepth == 0) {
+        // Copy the event out: a callback may reuse its slot
+        PendingEvent event = _events[_eventHead];
+        _eventHead = (_eventHead + 1) % RYUW122_EVENT_QUEUE_SIZE;
+        _eventCount--;
+
+        RYUW122Frame frame;
+        frame.type = event.type;
+        frame.tagAddress = event.tagAddress;
+        frame.data = event.data;
+        frame.payloadLength = event.payloadLength;
+        frame.distance = event.distance;
+        frame.rssi = event.rssi;
+        frame.hasRssi = event.hasRssi;
+
+        if (frame.type == RYUW122FrameType::ANCHOR_RCV) {
+            dispatchAnchorReceive(frame);
+        } else {
+            dispatchTagReceive(frame);
+        }
     }
-    
-    DEBUG_PRINTLN(F("AT< <no response> (timeout)"));
-    return false;
 }
 
-void RYUW122::parseAnchorReceive(char* response) {
-    // Parse the response once
-    /* use compile-time length to avoid runtime strlen on literal */
-    char* ptr = response + (sizeof("+ANCHOR_RCV=") - 1);
-    char* tagAddress = strSepComma(&ptr);
-    char* payloadStr = strSepComma(&ptr);
-    char* tagData = strSepComma(&ptr);
-    char* distanceStr = strSepComma(&ptr);
-    char* rssiStr = strSepComma(&ptr);
-    int payloadLength = payloadStr ? safeAtoi(payloadStr, 0) : 0;
-    int distance = distanceStr ? safeAtoi(distanceStr, 0) : 0;
-    int rssi = 0;
-
-    if (rssiStr && *rssiStr != '\0') {
-        int val = safeAtoi(rssiStr, 0);
-        if (val < -100) val = -100; // Clamp to -100
-        rssi = val;
-    } else {
-        // If RSSI is missing or empty, default to 0
-        rssi = 0;
-    }
-
+void RYUW122::dispatchAnchorReceive(const RYUW122Frame& frame) {
     // Trigger original callback if registered
     if (_anchorReceiveCallback) {
-        _anchorReceiveCallback(tagAddress ? tagAddress : "", payloadLength, tagData ? tagData : "", distance, rssi);
+        _anchorReceiveCallback(frame.tagAddress, frame.payloadLength, frame.data, frame.distance, frame.rssi);
     }
 
     // Trigger simplified callbacks if registered
-    if (_simpleMessageCallback && tagData && strlen(tagData) > 0) {
-        _simpleMessageCallback(tagAddress ? tagAddress : "", tagData, rssi);
+    if (_simpleMessageCallback && frame.payloadLength > 0) {
+        _simpleMessageCallback(frame.tagAddress, frame.data, frame.rssi);
     }
 
     if (_simpleDistanceCallback) {
-        _simpleDistanceCallback(tagAddress ? tagAddress : "",
-                               convertDistance(distance, _preferredUnit),
-                               _preferredUnit, rssi);
+        _simpleDistanceCallback(frame.tagAddress,
+                               convertDistance(frame.distance, _preferredUnit),
+                               _preferredUnit, frame.rssi);
     }
 }
 
-void RYUW122::parseTagReceive(char* response) {
+void RYUW122::dispatchTagReceive(const RYUW122Frame& frame) {
     if (_tagReceiveCallback) {
-        // +TAG_RCV=<payloadLength>,<data>,<rssi>
-        /* use compile-time length to avoid runtime strlen on literal */
-        char* ptr = response + (sizeof("+TAG_RCV=") - 1);
-        char* payloadStr = strSepComma(&ptr);
-        char* data = strSepComma(&ptr);
-        char* rssiStr = strSepComma(&ptr);
-        int payloadLength = payloadStr ? safeAtoi(payloadStr, 0) : 0;
-        int rssi = 0;
-
-        if (rssiStr && *rssiStr != '\0') {
-            int val = safeAtoi(rssiStr, 0);
-            if (val < -100) val = -100; // Clamp to -100
-            rssi = val;
-        } else {
-            rssi = 0;
-        }
-
-        _tagReceiveCallback(payloadLength, data ? data : "", rssi);
+        _tagReceiveCallback(frame.payloadLength, frame.data, frame.rssi);
     }
 
     // Also trigger simplified callback if registered
     if (_simpleMessageCallback) {
-        /* use compile-time length to avoid runtime strlen on literal */
-        char* ptr = response + (sizeof("+TAG_RCV=") - 1);
-        strSepComma(&ptr); // Skip payload length
-        char* data = strSepComma(&ptr);
-        char* rssiStr = strSepComma(&ptr);
-        int rssi = 0;
-
-        if (rssiStr && *rssiStr != '\0') {
-            int val = safeAtoi(rssiStr, 0);
-            if (val < -100) val = -100; // Clamp to -100
-            rssi = val;
-        } else {
-            rssi = 0;
-        }
-
-        _simpleMessageCallback("ANCHOR", data ? data : "", rssi);
+        _simpleMessageCallback("ANCHOR", frame.data, frame.rssi);
     }
 }
 
@@ -1196,9 +1939,7 @@ int RYUW122::getMultipleDistances(const char** tagAddresses, int numTags, float*
             DEBUG_PRINT(F("Failed to measure distance to "));
             DEBUG_PRINTLN(tagAddresses[i]);
         }
-
-        // Small delay between measurements
-        managedDelay(100);
+        // The next AT+ANCHOR_SEND goes out right away: the exchange above has already completed
     }
 
     return successCount;
@@ -1209,6 +1950,86 @@ bool RYUW122::begin(RYUW122BaudRate baudRate) {
     return begin();
 }
 
+bool RYUW122::beginSerial(RYUW122BaudRate baudRate) {
+    if (this->hs) {
+#ifdef HARDWARE_SERIAL_SELECTABLE_PIN
+        if(this->mcuTxPin != -1 && this->mcuRxPin != -1) {
+            DEBUG_PRINTLN(F("Hardware Serial with custom TX/RX pins"));
+            this->serialDef.begin(*this->hs, (uint32_t)baudRate, this->serialConfig, this->mcuRxPin, this->mcuTxPin);
+        }else{
+            this->serialDef.begin(*this->hs, (uint32_t)baudRate, this->serialConfig);
+        }
+#endif
+#ifndef HARDWARE_SERIAL_SELECTABLE_PIN
+        this->serialDef.begin(*this->hs, (uint32_t)baudRate);
+#endif
+#ifdef ACTIVATE_SOFTWARE_SERIAL
+    } else if (this->ss) {
+        this->serialDef.begin(*this->ss, (uint32_t)baudRate);
+#endif
+    } else {
+        // A generic Stream is configured by the application
+        return false;
+    }
+
+    this->bpsRate = baudRate;
+    this->serialDef.stream->setTimeout((unsigned long)this->_streamTimeoutMs);
+    // Bytes assembled at the previous rate are garbage
+    _rxLength = 0;
+    _rxOverflow = false;
+    _rxChunkLength = 0;
+    _rxChunkPos = 0;
+    return true;
+}
+
+bool RYUW122::probeBaudRate() {
+    RYUW122TransactionStatus status = runTransaction(PSTR("AT"), true, PSTR("+OK"), true, RYUW122MatchMode::FIRST_LINE,
+                                                     RYUW122_BAUD_PROBE_TIMEOUT, nullptr, 0);
+    // A line left in the module by a probe at a wrong rate makes it answer +ERR: the rate is right anyway
+    return status == RYUW122TransactionStatus::COMPLETED || status == RYUW122TransactionStatus::MODULE_ERROR;
+}
+
+bool RYUW122::detectBaudRate() {
+    static const RYUW122BaudRate rates[] = { RYUW122BaudRate::B_115200, RYUW122BaudRate::B_57600, RYUW122BaudRate::B_9600 };
+    const RYUW122BaudRate configured = this->bpsRate;
+
+    // The configured rate first: it is the most likely one
+    bool found = probeBaudRate();
+    for (uint8_t i = 0; !found && i < sizeof(rates) / sizeof(rates[0]); i++) {
+        if (rates[i] == configured) continue;
+        // Without control of the host UART there is nothing else to try
+        if (!beginSerial(rates[i])) break;
+        found = probeBaudRate();
+    }
+    if (!found) {
+        beginSerial(configured);
+        return false;
+    }
+
+    DEBUG_PRINT(F("Module found at "));
+    DEBUG_PRINTLN((long)this->bpsRate);
+    _settings.baudRate = this->bpsRate;
+    _settings.valid |= SETTING_BAUD_RATE;
+
+    if (_autoBaud != RYUW122AutoBaud::DETECT_AND_UPGRADE || (!this->hs
+#ifdef ACTIVATE_SOFTWARE_SERIAL
+            && !this->ss
+#endif
+            )) {
+        return true;
+    }
+
+    RYUW122BaudRate fastest = RYUW122BaudRate::B_115200;
+#ifdef ACTIVATE_SOFTWARE_SERIAL
+    if (this->ss) fastest = RYUW122_SOFTWARE_SERIAL_MAX_BAUD;
+#endif
+    if (this->bpsRate != fastest && !setBaudRate(fastest)) {
+        // Not fatal: the module still answers at the detected rate
+        DEBUG_PRINTLN(F("Warning: Could not upgrade the baud rate"));
+    }
+    return true;
+}
+
 // Toggle the configured reset pin: LOW for 5ms then HIGH
 void RYUW122::hardwareResetPin() const {
     digitalWrite(this->lowResetTriggerInputPin, LOW);
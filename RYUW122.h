@@ -46,6 +46,105 @@
 // Define the maximum payload length
 #define RYUW122_MAX_PAYLOAD_LENGTH 12
 
+// Size of the per-instance line accumulator used by loop() (longest module line + terminator)
+#ifndef RYUW122_RX_BUFFER_SIZE
+#define RYUW122_RX_BUFFER_SIZE 64
+#endif
+// The line is indexed with 8 bits: past 256 the index would wrap and long lines come out garbled
+static_assert(RYUW122_RX_BUFFER_SIZE >= 2 && RYUW122_RX_BUFFER_SIZE <= 256, "RYUW122_RX_BUFFER_SIZE must be 2 to 256");
+
+// Bytes moved from the serial driver at a time by loop(), at most 255 (see readAvailable())
+#ifndef RYUW122_RX_CHUNK_SIZE
+    #if defined(ARDUINO_ARCH_AVR)
+        #define RYUW122_RX_CHUNK_SIZE 16
+    #else
+        #define RYUW122_RX_CHUNK_SIZE 64
+    #endif
+#endif
+// _rxChunkLength and _rxChunkPos are 8 bits: a larger chunk would read as empty
+static_assert(RYUW122_RX_CHUNK_SIZE > 0 && RYUW122_RX_CHUNK_SIZE <= 255, "RYUW122_RX_CHUNK_SIZE must be 1 to 255");
+
+// The receive queue (RYUW122RxQueue.h) needs <atomic>: enabled where the toolchain ships it
+// (not avr-gcc, also on megaAVR), or by defining RYUW122_HAS_RX_QUEUE
+#ifndef RYUW122_HAS_RX_QUEUE
+    #if defined(ESP32) || defined(RYUW122_HOST_BUILD)
+        #define RYUW122_HAS_RX_QUEUE
+    #elif defined(__has_include)
+        #if __has_include(<atomic>)
+            #define RYUW122_HAS_RX_QUEUE
+        #endif
+    #endif
+#endif
+
+// Number of AT transactions that can wait in the asynchronous queue (including the active one)
+#ifndef RYUW122_TRANSACTION_QUEUE_SIZE
+    #if defined(ARDUINO_ARCH_AVR)
+        #define RYUW122_TRANSACTION_QUEUE_SIZE 2
+    #else
+        #define RYUW122_TRANSACTION_QUEUE_SIZE 4
+    #endif
+#endif
+
+// Number of unsolicited frames kept while a blocking call waits; the next loop() dispatches them
+#ifndef RYUW122_EVENT_QUEUE_SIZE
+    #if defined(ARDUINO_ARCH_AVR)
+        #define RYUW122_EVENT_QUEUE_SIZE 4
+    #else
+        #define RYUW122_EVENT_QUEUE_SIZE 16
+    #endif
+#endif
+
+// Number of TAG addresses whose round trip time is tracked for the adaptive timeouts
+#ifndef RYUW122_MAX_TRACKED_TAGS
+    #if defined(ARDUINO_ARCH_AVR)
+        #define RYUW122_MAX_TRACKED_TAGS 4
+    #else
+        #define RYUW122_MAX_TRACKED_TAGS 16
+    #endif
+#endif
+
+// Default bounds of the adaptive ranging timeout in milliseconds (see setAdaptiveTimeout())
+#ifndef RYUW122_RTT_MIN_TIMEOUT
+#define RYUW122_RTT_MIN_TIMEOUT 50
+#endif
+#ifndef RYUW122_RTT_MAX_TIMEOUT
+#define RYUW122_RTT_MAX_TIMEOUT 2000
+#endif
+
+// Each missed answer doubles the timeout of the TAG, up to 2^RYUW122_RTT_MAX_BACKOFF times
+#ifndef RYUW122_RTT_MAX_BACKOFF
+#define RYUW122_RTT_MAX_BACKOFF 2
+#endif
+// Past that, one exchange every RYUW122_RTT_CEILING_PROBE missed in a row waits the ceiling: a TAG
+// whose round trip grew beyond the backed off estimate is heard again (a miss adds no sample)
+#ifndef RYUW122_RTT_CEILING_PROBE
+#define RYUW122_RTT_CEILING_PROBE 16
+#endif
+
+// Longest AT command stored in a queued transaction (AT+CPIN=<32 hex> is the longest one)
+#define RYUW122_MAX_COMMAND_LENGTH 48
+
+// Transaction id returned when a command could not be queued
+#define RYUW122_INVALID_TRANSACTION 0
+
+// Longest time a setter waits for the module to answer again after a change (polled with AT)
+#ifndef RYUW122_READY_TIMEOUT
+#define RYUW122_READY_TIMEOUT 200
+#endif
+
+// Time each baud rate is probed with AT by the auto-baud detection of begin()
+#ifndef RYUW122_BAUD_PROBE_TIMEOUT
+#define RYUW122_BAUD_PROBE_TIMEOUT 50
+#endif
+
+// Fastest rate the auto-baud upgrade selects on SoftwareSerial (115200 is not reliable on AVR)
+#ifndef RYUW122_SOFTWARE_SERIAL_MAX_BAUD
+#define RYUW122_SOFTWARE_SERIAL_MAX_BAUD RYUW122BaudRate::B_57600
+#endif
+
+// Integer fields of RYUW122Config with this value are left unchanged
+#define RYUW122_CONFIG_KEEP 0x7FFF
+
 // Measurement units for distance
 enum class MeasureUnit {
     CENTIMETERS,
@@ -79,12 +178,165 @@ struct TagDutyCycleResponse {
     int rfDisableTime;
 };
 
+/**
+ * @struct RYUW122Config
+ * @brief Desired module configuration for RYUW122::applyConfig().
+ * Fields left at their default (UNKNOWN, nullptr or RYUW122_CONFIG_KEEP) are not touched.
+ * @code
+ * RYUW122Config config;
+ * config.mode = RYUW122Mode::ANCHOR;
+ * config.networkId = "AABBCCDD";
+ * config.address = "A1A1A1A1";
+ * uwb.applyConfig(config);
+ * @endcode
+ */
+struct RYUW122Config {
+    RYUW122Mode mode = RYUW122Mode::UNKNOWN;
+    const char* networkId = nullptr;       ///< 8 bytes ASCII
+    const char* address = nullptr;         ///< 8 bytes ASCII
+    const char* password = nullptr;        ///< 32 hex characters
+    RYUW122RFChannel channel = RYUW122RFChannel::UNKNOWN;
+    RYUW122Bandwidth bandwidth = RYUW122Bandwidth::UNKNOWN;
+    RYUW122RFPower rfPower = RYUW122RFPower::UNKNOWN;
+    RYUW122RSSI rssiDisplay = RYUW122RSSI::UNKNOWN;
+    int calibration = RYUW122_CONFIG_KEEP;   ///< cm, -100 to +100
+    int rfEnableTime = RYUW122_CONFIG_KEEP;  ///< TAG RF duty cycle, ms (set together with rfDisableTime)
+    int rfDisableTime = RYUW122_CONFIG_KEEP;
+};
+
+/**
+ * @brief Kind of line decoded by RYUW122ParseFrame().
+ */
+enum class RYUW122FrameType {
+    INVALID,    ///< Not a frame, or a malformed one
+    ANCHOR_RCV, ///< +ANCHOR_RCV=<TAG Address>,<Payload Length>,<TAG Data>,<Distance>[,<RSSI>]
+    TAG_RCV     ///< +TAG_RCV=<Payload Length>,<Data>[,<RSSI>]
+};
+
+/**
+ * @struct RYUW122Frame
+ * @brief A received +ANCHOR_RCV/+TAG_RCV line decoded in a single pass.
+ * The string fields point into the parsed line, which is null-terminated in place (no copy).
+ */
+struct RYUW122Frame {
+    RYUW122FrameType type;
+    const char* tagAddress; ///< Sender TAG address (ANCHOR_RCV), "" for TAG_RCV
+    const char* data;       ///< Payload, exactly payloadLength bytes
+    int payloadLength;
+    int distance;           ///< Distance in cm (ANCHOR_RCV), 0 for TAG_RCV
+    int rssi;               ///< RSSI clamped to -100, 0 if the module does not report it
+    bool hasRssi;
+};
+
+/**
+ * @brief Validates and decodes a +ANCHOR_RCV/+TAG_RCV line, touching each byte once.
+ * The payload is delimited by its declared length, so it may contain commas. Integer fields
+ * are decoded inline and a unit suffix (e.g. "120 cm") is accepted.
+ * @param line The trimmed, null-terminated line; the address and data fields are terminated in place.
+ * @param frame The decoded frame (type INVALID on failure).
+ * @return True if the line is a well-formed frame.
+ */
+bool RYUW122ParseFrame(char* line, RYUW122Frame& frame);
+
+/**
+ * @struct RYUW122RxEntry
+ * @brief A module line assembled (and, for +ANCHOR_RCV/+TAG_RCV, decoded) outside the main loop.
+ */
+struct RYUW122RxEntry {
+    char text[RYUW122_RX_BUFFER_SIZE];   ///< The trimmed line, as received
+    char fields[RYUW122_RX_BUFFER_SIZE]; ///< Frames only: the line split by RYUW122ParseFrame()
+    RYUW122Frame frame;                  ///< Frames only: the decoded fields, pointing into fields
+    bool isFrame;
+    unsigned long timestampUs;           ///< micros() when the line was complete
+};
+
+class RYUW122RxQueue;
+
+/**
+ * @class RYUW122RangeListener
+ * @brief Receives every valid +ANCHOR_RCV measurement, whichever path consumed it.
+ *
+ * Listeners are fed before the callbacks and the transaction results: frames answering
+ * anchorSendDataSync()/anchorSendDataAsync() are reported as well as unsolicited ones.
+ * They are linked through the object itself, so registering one allocates nothing.
+ */
+class RYUW122RangeListener {
+public:
+    /**
+     * @brief Called for each decoded +ANCHOR_RCV frame.
+     * @param frame The decoded frame (its strings are valid only during the call).
+     * @param timestampUs micros() when the line was received.
+     */
+    virtual void onRange(const RYUW122Frame& frame, unsigned long timestampUs) = 0;
+
+protected:
+    ~RYUW122RangeListener() {}
+
+private:
+    friend class RYUW122;
+    RYUW122RangeListener* _nextListener = nullptr;
+};
+
+/**
+ * @brief How the lines received after an AT command are matched against the expected response.
+ */
+enum class RYUW122MatchMode {
+    FIRST_LINE,      ///< The first response line completes the transaction; it succeeds if it starts with the expected prefix
+    WAIT_FOR_PREFIX, ///< Lines are skipped until one starts with the expected prefix
+    AFTER_OK         ///< "+OK" must be received first, then a line starting with the expected prefix
+};
+
+/**
+ * @brief State of an asynchronous AT transaction.
+ */
+enum class RYUW122TransactionStatus {
+    QUEUED,              ///< Waiting for the previous transactions to finish
+    IN_PROGRESS,         ///< Command sent, waiting for the response
+    COMPLETED,           ///< Expected response received
+    UNEXPECTED_RESPONSE, ///< The module answered with a different response
+    MODULE_ERROR,        ///< The module answered +ERR=<n> (see RYUW122TransactionResult::error)
+    TIMEOUT,             ///< No matching response before the timeout
+    CANCELLED,           ///< Removed by cancelTransaction()
+    NOT_FOUND            ///< Unknown id (already finished or never queued)
+};
+
+/**
+ * @struct RYUW122TransactionResult
+ * @brief Outcome of an asynchronous AT transaction, passed to its completion callback.
+ */
+struct RYUW122TransactionResult {
+    uint16_t id;
+    RYUW122TransactionStatus status;
+    const char* response;  ///< Matched response line ("" if none); valid only during the callback
+    const RYUW122Frame* frame; ///< Decoded fields when the response is a +ANCHOR_RCV/+TAG_RCV frame, else nullptr
+    unsigned long elapsed; ///< Milliseconds between sending the command and completion
+    RYUW122ErrorCode error; ///< Code of the +ERR answer when status is MODULE_ERROR, else NONE
+};
+
+/**
+ * @struct RYUW122TagLatency
+ * @brief Round trip statistics of the AT+ANCHOR_SEND exchanges with a TAG, in milliseconds.
+ */
+struct RYUW122TagLatency {
+    char address[9];
+    unsigned long srtt;     ///< Smoothed round trip time
+    unsigned long rttvar;   ///< Smoothed mean deviation of the round trip time
+    unsigned long minRtt;
+    unsigned long maxRtt;
+    unsigned long timeout;  ///< Timeout of the next exchange: srtt + 4 rttvar, backed off and clamped
+    unsigned long samples;  ///< Answers measured
+    unsigned long timeouts; ///< Exchanges without answer
+};
+
+class RYUW122RetryPolicy;
 
 // Callback function types
+typedef void (*TransactionCallback)(const RYUW122TransactionResult& result, void* context);
 typedef void (*AnchorReceiveCallback)(const char* tagAddress, int payloadLength, const char* tagData, int distance, int rssi);
 typedef void (*TagReceiveCallback)(int payloadLength, const char* data, int rssi);
 typedef void (*SimpleMessageCallback)(const char* fromAddress, const char* message, int rssi);
 typedef void (*SimpleDistanceCallback)(const char* fromAddress, float distance, MeasureUnit unit, int rssi);
+typedef void (*WaitCallback)(void* context);
 
 class RYUW122 {
 public:
@@ -116,6 +368,8 @@ public:
      */
     explicit RYUW122(Stream* serial);
 
+    virtual ~RYUW122() {}
+
         /**
      * @brief Initializes the RYUW122 module.
      * @param baudRate The baud rate for the serial communication.
@@ -130,11 +384,167 @@ public:
      */
     bool begin(RYUW122BaudRate baudRate);
 
+    /**
+     * @brief Enables the baud rate detection of begin() (call it before begin()).
+     * begin() first probes the configured rate, then 115200, 57600 and 9600, and fails if the
+     * module answers at none; with DETECT_AND_UPGRADE it then moves module and host UART to
+     * 115200 (RYUW122_SOFTWARE_SERIAL_MAX_BAUD on SoftwareSerial). The host UART can only be
+     * changed by the library when it was given as HardwareSerial or SoftwareSerial: with a
+     * generic Stream only the current rate is checked.
+     * @param mode OFF (default), DETECT or DETECT_AND_UPGRADE.
+     */
+    void setAutoBaud(RYUW122AutoBaud mode) { _autoBaud = mode; }
+
     /**
      * @brief Checks for incoming data and processes it. This should be called in the main loop.
+     * @note Non-blocking: only the bytes already buffered by the serial driver are consumed.
+     * A partial line is kept in an internal accumulator and completed on the next call.
      */
     void loop();
 
+#ifdef RYUW122_HAS_RX_QUEUE
+    /**
+     * @brief Takes the received lines from a queue filled outside the main loop (nullptr: back to the stream).
+     * The bytes are then read by the producer of the queue (RYUW122UartReceiver on ESP32, a
+     * thread on the host) and loop() only dispatches the lines, already assembled and decoded.
+     * Attach it after begin(); the producer must be started again after a baud rate change.
+     */
+    void setReceiveQueue(RYUW122RxQueue* queue) { _rxQueue = queue; }
+#endif
+
+    // ========================================
+    // ASYNCHRONOUS AT TRANSACTIONS
+    // ========================================
+
+    /**
+     * @brief Queues an AT command without waiting for its response.
+     * The command is sent as soon as the previous transactions are finished; loop() moves it forward
+     * and the callback is invoked once the response arrives or the timeout expires.
+     * @param command The AT command string to send (without line terminator).
+     * @param expectedResponse The expected response prefix ("" or nullptr accepts any response line).
+     * @param callback Completion callback (can be nullptr).
+     * @param context User pointer passed back to the callback.
+     * @param timeout Timeout in milliseconds from the moment the command is sent (0 = library default).
+     * @param mode How the response lines are matched against expectedResponse.
+     * @return The transaction id, or RYUW122_INVALID_TRANSACTION if the queue is full or the command invalid.
+     */
+    uint16_t submitCommand(const char* command, const char* expectedResponse, TransactionCallback callback,
+                           void* context = nullptr, unsigned long timeout = 0,
+                           RYUW122MatchMode mode = RYUW122MatchMode::FIRST_LINE);
+
+    /**
+     * @brief Sends data from an ANCHOR to a TAG without blocking.
+     * The transaction completes when the +ANCHOR_RCV of the addressed TAG arrives; its fields are in result.frame
+     * (the frame is split in place, so result.response then holds only the header up to the TAG address).
+     * @param tagAddress The address of the target TAG (must be 8 bytes ASCII).
+     * @param payloadLength The length of the data to send (0-12 bytes maximum).
+     * @param data The data to send (ASCII format).
+     * @param callback Completion callback (can be nullptr).
+     * @param context User pointer passed back to the callback.
+     * @param timeout Timeout in milliseconds (default 0: adaptive, see setAdaptiveTimeout()).
+     * @return The transaction id, or RYUW122_INVALID_TRANSACTION on invalid parameters or full queue.
+     */
+    uint16_t anchorSendDataAsync(const char* tagAddress, int payloadLength, const char* data, TransactionCallback callback,
+                                 void* context = nullptr, unsigned long timeout = 0);
+
+    /**
+     * @brief Sends data from a TAG without blocking; completes on the +OK confirmation.
+     * @param payloadLength The length of the data to send (0-12 bytes maximum).
+     * @param data The data to send (ASCII format).
+     * @param callback Completion callback (can be nullptr).
+     * @param context User pointer passed back to the callback.
+     * @param timeout Timeout in milliseconds (default 1000ms).
+     * @return The transaction id, or RYUW122_INVALID_TRANSACTION on invalid parameters or full queue.
+     */
+    uint16_t tagSendDataAsync(int payloadLength, const char* data, TransactionCallback callback,
+                              void* context = nullptr, unsigned long timeout = 1000);
+
+    /**
+     * @brief Gets the state of a queued transaction.
+     * @param id The transaction id.
+     * @return QUEUED or IN_PROGRESS while pending, NOT_FOUND once finished (the result goes to the callback).
+     */
+    RYUW122TransactionStatus getTransactionStatus(uint16_t id) const;
+
+    /**
+     * @brief Cancels a pending transaction; its callback is invoked with CANCELLED.
+     * @param id The transaction id.
+     * @return True if the transaction was pending and has been cancelled.
+     */
+    bool cancelTransaction(uint16_t id);
+
+    /**
+     * @brief Gets the number of transactions queued or in progress.
+     */
+    uint8_t getPendingTransactions() const;
+
+    /**
+     * @brief Gets the error reported by the module to the last blocking call.
+     * Every transaction, blocking or not, completes as soon as the module answers +ERR=<n>
+     * instead of waiting for its timeout; the asynchronous ones report it in their result.error.
+     * @return The code of the +ERR answer, NONE if the last blocking call was not refused by the module.
+     */
+    RYUW122ErrorCode getLastError() const { return _lastError; }
+
+    /**
+     * @brief Gets the number of unsolicited frames waiting to be dispatched.
+     * Frames received while a blocking call waits for its answer are kept (up to
+     * RYUW122_EVENT_QUEUE_SIZE) and passed to the callbacks by the next loop().
+     */
+    uint8_t getQueuedEvents() const { return _eventCount; }
+
+    /**
+     * @brief Gets the number of unsolicited frames lost because the event queue was full.
+     */
+    unsigned long getDroppedEvents() const { return _droppedEvents; }
+
+    /**
+     * @brief Sets the bounds of the adaptive timeout of the ranging exchanges.
+     * When an ANCHOR exchange is started with timeout 0 (the default), its timeout comes from the
+     * round trips measured with that TAG, as TCP does: smoothed RTT + 4 times its mean deviation.
+     * A TAG never answered uses the statistics of all the TAGs, and each missed answer doubles
+     * the timeout of the TAG (up to 4 times) until it answers again. A TAG that keeps missing
+     * waits the ceiling once every RYUW122_RTT_CEILING_PROBE exchanges, in case it became slower.
+     * @param floor Shortest timeout in milliseconds (default RYUW122_RTT_MIN_TIMEOUT, 50).
+     * @param ceiling Longest timeout, also used before any answer (default RYUW122_RTT_MAX_TIMEOUT, 2000).
+     */
+    void setAdaptiveTimeout(unsigned long floor, unsigned long ceiling);
+
+    /**
+     * @brief Gets the timeout the next exchange with a TAG will use.
+     */
+    unsigned long getTagTimeout(const char* tagAddress) const;
+
+    /**
+     * @brief Gets the round trip statistics of a TAG.
+     * @return False if the TAG is not tracked (never ranged, or evicted by RYUW122_MAX_TRACKED_TAGS newer ones).
+     */
+    bool getTagLatency(const char* tagAddress, RYUW122TagLatency& latency) const;
+
+    /**
+     * @brief Gets the statistics of the index-th tracked TAG (0 to getTagLatencyCount() - 1).
+     */
+    bool getTagLatencyAt(uint8_t index, RYUW122TagLatency& latency) const;
+    uint8_t getTagLatencyCount() const { return _rttCount; }
+
+    /**
+     * @brief Forgets all the round trip statistics (e.g. after a change of bandwidth or duty cycle).
+     */
+    void resetTagLatency();
+
+    /**
+     * @brief Attaches a retry policy to the ranging exchanges (nullptr to detach).
+     * Timed out exchanges are sent again, failing TAGs are held back with an exponential
+     * backoff and the TAGs that stopped answering are only probed now and then (see RYUW122RetryPolicy).
+     */
+    void setRetryPolicy(RYUW122RetryPolicy* policy) { _retryPolicy = policy; }
+
+    /**
+     * @brief Checks whether the retry policy lets an exchange with a TAG through now.
+     * @return Always true without a retry policy.
+     */
+    bool isTagAllowed(const char* tagAddress) const;
+
     /**
      * @brief Sets the operating mode of the module.
      * @param mode The desired operating mode (TAG, ANCHOR, or SLEEP).
@@ -144,12 +554,15 @@ public:
 
     /**
      * @brief Gets the current operating mode of the module.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return The current operating mode.
      */
-    RYUW122Mode getMode();
+    RYUW122Mode getMode(bool forceRefresh = false);
 
     /**
      * @brief Sets the UART baud rate.
+     * The host UART follows the module when the library owns it (HardwareSerial or SoftwareSerial);
+     * with a generic Stream the application must change its rate.
      * @param baudRate The desired baud rate.
      * @return True if the baud rate was set successfully, false otherwise.
      */
@@ -157,9 +570,10 @@ public:
 
     /**
      * @brief Gets the current UART baud rate.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return The current baud rate.
      */
-    RYUW122BaudRate getBaudRate();
+    RYUW122BaudRate getBaudRate(bool forceRefresh = false);
 
     /**
      * @brief Sets the RF channel.
@@ -170,9 +584,10 @@ public:
 
     /**
      * @brief Gets the current RF channel.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return The current RF channel.
      */
-    RYUW122RFChannel getRfChannel();
+    RYUW122RFChannel getRfChannel(bool forceRefresh = false);
 
     /**
      * @brief Sets the data rate (bandwidth).
@@ -183,9 +598,10 @@ public:
 
     /**
      * @brief Gets the current data rate (bandwidth).
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return The current data rate.
      */
-    RYUW122Bandwidth getBandwidth();
+    RYUW122Bandwidth getBandwidth(bool forceRefresh = false);
 
     /**
      * @brief Sets the network ID.
@@ -197,9 +613,10 @@ public:
     /**
      * @brief Gets the current network ID.
      * @param networkId A buffer to store the network ID.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return True if the network ID was retrieved successfully, false otherwise.
      */
-    bool getNetworkId(char* networkId);
+    bool getNetworkId(char* networkId, bool forceRefresh = false);
 
     /**
      * @brief Sets the address of the module.
@@ -211,9 +628,10 @@ public:
     /**
      * @brief Gets the current address of the module.
      * @param address A buffer to store the address.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return True if the address was retrieved successfully, false otherwise.
      */
-    bool getAddress(char* address);
+    bool getAddress(char* address, bool forceRefresh = false);
 
     /**
      * @brief Gets the unique ID of the module.
@@ -248,15 +666,17 @@ public:
      * @brief Gets the current RF duty cycle for the TAG.
      * @param rfEnableTime A variable to store the RF enable time.
      * @param rfDisableTime A variable to store the RF disable time.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return True if the duty cycle was retrieved successfully, false otherwise.
      */
-    bool getTagRfDutyCycle(int& rfEnableTime, int& rfDisableTime);
+    bool getTagRfDutyCycle(int& rfEnableTime, int& rfDisableTime, bool forceRefresh = false);
 
     /**
      * @brief Gets the current RF duty cycle for the TAG and returns it in a struct.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return A TagDutyCycleResponse struct containing the success status and values.
      */
-    TagDutyCycleResponse getTagRfDutyCycle();
+    TagDutyCycleResponse getTagRfDutyCycle(bool forceRefresh = false);
 
     /**
      * @brief Sets the RF output power.
@@ -267,9 +687,10 @@ public:
 
     /**
      * @brief Gets the current RF output power.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return The current RF output power.
      */
-    RYUW122RFPower getRfPower();
+    RYUW122RFPower getRfPower(bool forceRefresh = false);
 
     /**
      * @brief Sends data from an ANCHOR to a TAG.
@@ -288,22 +709,22 @@ public:
      * @param responseData Buffer to store the received data from TAG (minimum 13 bytes).
      * @param distance Pointer to store the calculated distance in cm (can be NULL).
      * @param rssi Pointer to store the RSSI value (can be NULL).
-     * @param timeout Timeout in milliseconds (default 2000ms).
+     * @param timeout Timeout in milliseconds (default 0: adaptive, see setAdaptiveTimeout()).
      * @return True if data was sent and response received successfully, false otherwise.
      * @note This is a blocking call that waits for both +OK and +ANCHOR_RCV responses.
      * @note The payload difference between Anchor and TAG cannot exceed 3 bytes for accurate distance calculation.
      */
-    bool anchorSendDataSync(const char* tagAddress, int payloadLength, const char* data, char* responseData, int* distance = nullptr, int* rssi = nullptr, unsigned long timeout = 2000);
+    bool anchorSendDataSync(const char* tagAddress, int payloadLength, const char* data, char* responseData, int* distance = nullptr, int* rssi = nullptr, unsigned long timeout = 0);
 
     /**
      * @brief Sends data from an ANCHOR to a TAG and waits for a response, returned in a struct.
      * @param tagAddress The address of the target TAG (must be 8 bytes ASCII).
      * @param payloadLength The length of the data to send (0-12 bytes).
      * @param data The data to send.
-     * @param timeout Timeout in milliseconds (default 2000ms).
+     * @param timeout Timeout in milliseconds (default 0: adaptive, see setAdaptiveTimeout()).
      * @return An AnchorResponse struct containing success status, response data, distance, and RSSI.
      */
-    AnchorResponse anchorSendDataSync(const char* tagAddress, int payloadLength, const char* data, unsigned long timeout = 2000);
+    AnchorResponse anchorSendDataSync(const char* tagAddress, int payloadLength, const char* data, unsigned long timeout = 0);
 
     /**
      * @brief Sends data from a TAG.
@@ -334,9 +755,10 @@ public:
 
     /**
      * @brief Gets the current RSSI display setting.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return The current RSSI display setting.
      */
-    RYUW122RSSI getRssiDisplay();
+    RYUW122RSSI getRssiDisplay(bool forceRefresh = false);
 
     /**
      * @brief Calibrates the distance measurement.
@@ -347,9 +769,10 @@ public:
 
     /**
      * @brief Gets the current distance calibration value.
+     * @param forceRefresh Query the module instead of answering from the settings cache.
      * @return The current distance calibration value.
      */
-    int getDistanceCalibration();
+    int getDistanceCalibration(bool forceRefresh = false);
 
     /**
      * @brief Gets the firmware version of the module.
@@ -358,6 +781,28 @@ public:
      */
     bool getFirmwareVersion(char* version);
 
+    /**
+     * @brief Brings the module to the given configuration, sending only the settings that differ.
+     * The current values come from the settings cache (read once by begin()); the password, which
+     * is not cached, is read only if the configuration sets one. The mode is applied last.
+     * @param config The desired configuration.
+     * @return True if every requested setting is in place, false at the first failure.
+     */
+    bool applyConfig(const RYUW122Config& config);
+
+    /**
+     * @brief Reads all the module settings into the settings cache.
+     * Called by begin(); the getters then answer from RAM unless forceRefresh is set.
+     * @return True if every setting was read, false if the module stopped answering.
+     */
+    bool refreshSettings();
+
+    /**
+     * @brief Marks the settings cache as stale: each getter queries the module again on its next call.
+     * Use it after changing settings with raw AT commands.
+     */
+    void invalidateSettings();
+
     /**
      * @brief Resets the module to its factory settings.
      * @return True if the reset was successful, false otherwise.
@@ -388,6 +833,23 @@ public:
      */
     void onTagReceive(TagReceiveCallback callback);
 
+    /**
+     * @brief Adds a listener fed with every +ANCHOR_RCV measurement (e.g. a RYUW122RangeHistory).
+     * @param listener The listener; it must outlive the registration. Adding it twice has no effect.
+     */
+    void addRangeListener(RYUW122RangeListener* listener);
+
+    /**
+     * @brief Removes a listener added with addRangeListener().
+     */
+    void removeRangeListener(RYUW122RangeListener* listener);
+
+    /**
+     * @brief Registers a function called over and over while a blocking command waits for its answer.
+     * RYUW122Group uses it to keep the other modules of the board running meanwhile.
+     */
+    void onWait(WaitCallback callback, void* context = nullptr);
+
     // ========================================
     // SIMPLIFIED HIGH-LEVEL API
     // ========================================
@@ -396,25 +858,25 @@ public:
      * @brief Gets distance from a TAG in the specified unit (ANCHOR mode only).
      * @param tagAddress The address of the target TAG (8 bytes ASCII).
      * @param unit The desired measurement unit (default: CENTIMETERS).
-     * @param timeout Timeout in milliseconds (default 2000ms).
+     * @param timeout Timeout in milliseconds (default 0: adaptive, see setAdaptiveTimeout()).
      * @return Distance in the specified unit, or -1.0 on error.
      * @note This is a blocking call. The module must be in ANCHOR mode.
      */
-    float getDistanceFrom(const char* tagAddress, MeasureUnit unit = MeasureUnit::CENTIMETERS, unsigned long timeout = 2000);
+    float getDistanceFrom(const char* tagAddress, MeasureUnit unit = MeasureUnit::CENTIMETERS, unsigned long timeout = 0);
 
     /**
      * @brief Sends a text message to a TAG from ANCHOR.
      * @param tagAddress The target TAG address (8 bytes ASCII).
-     * @param message The message to send (max 12 characters).
-     * @param timeout Timeout in milliseconds (default 2000ms).
+     * @param message The message to send (max 12 characters, see RYUW122Transfer for longer ones).
+     * @param timeout Timeout in milliseconds (default 0: adaptive, see setAdaptiveTimeout()).
      * @return True if message was sent and acknowledged, false otherwise.
      * @note This is a blocking call. The module must be in ANCHOR mode.
      */
-    bool sendMessageToTag(const char* tagAddress, const char* message, unsigned long timeout = 2000);
+    bool sendMessageToTag(const char* tagAddress, const char* message, unsigned long timeout = 0);
 
     /**
      * @brief Sends a text message from TAG (will be transmitted when ANCHOR requests).
-     * @param message The message to send (max 12 characters).
+     * @param message The message to send (max 12 characters, see RYUW122Transfer for longer ones).
      * @param timeout Timeout in milliseconds (default 1000ms).
      * @return True if message was stored successfully, false otherwise.
      * @note This is a blocking call. The module must be in TAG mode.
@@ -446,13 +908,44 @@ public:
      * @param numTags Number of TAGs to query (typically 3 for 2D positioning).
      * @param distances Array to store the measured distances.
      * @param unit The desired measurement unit (default: CENTIMETERS).
-     * @param timeout Timeout in milliseconds per TAG (default 2000ms).
+     * @param timeout Timeout in milliseconds per TAG (default 0: adaptive, see setAdaptiveTimeout()).
      * @return Number of successful distance measurements.
+     * @note This is a blocking call; for continuous polling use RYUW122RangingScheduler.
      */
     int getMultipleDistances(const char** tagAddresses, int numTags, float* distances,
-                            MeasureUnit unit = MeasureUnit::CENTIMETERS, unsigned long timeout = 2000);
+                            MeasureUnit unit = MeasureUnit::CENTIMETERS, unsigned long timeout = 0);
+
+    /**
+     * @brief Sets the default timeout of the AT commands (also bounds the settings read by begin()).
+     * @param ms Timeout in milliseconds (default 2000ms).
+     */
+    void setCommandTimeout(unsigned long ms);
+    unsigned long getCommandTimeout() const;
+
+    void setStreamTimeout(unsigned long ms);
+    unsigned long getStreamTimeout() const;
+
+protected:
+    /**
+     * @brief Moves up to size bytes already buffered by the serial driver into buffer; never waits.
+     * All the bytes from the module are read through this function, all the commands are written
+     * through writeCommand(). Here they go through the Stream interface, one virtual call per
+     * byte; RYUW122T (RYUW122Transport.h) reaches its transport type directly.
+     * @return The bytes read, 0 if none is available.
+     */
+    virtual int readAvailable(uint8_t* buffer, int size);
+
+    /**
+     * @brief Sends a command line to the module, followed by CRLF.
+     */
+    virtual void writeCommand(const char* command);
 
 private:
+#ifdef RYUW122_HOST_BUILD
+    // Host benchmarks (extras/host/bench) measure the private parsers directly
+    friend class RYUW122Bench;
+#endif
+
     HardwareSerial* hs;
 
 #ifdef ACTIVATE_SOFTWARE_SERIAL
@@ -486,6 +979,25 @@ private:
     void hardwareResetPin() const;
 
     RYUW122BaudRate bpsRate = RYUW122BaudRate::B_115200;
+    RYUW122AutoBaud _autoBaud = RYUW122AutoBaud::OFF;
+
+    /**
+     * @brief (Re)starts the host UART at the given rate.
+     * @return False if the stream is not owned by the library (generic Stream): its rate is unchanged.
+     */
+    bool beginSerial(RYUW122BaudRate baudRate);
+
+    /**
+     * @brief Finds the rate the module answers at and, if requested, upgrades it.
+     * @return True if the module answered at one of the rates.
+     */
+    bool detectBaudRate();
+
+    /**
+     * @brief Sends AT once with a short timeout.
+     * @return True if the module answered (+OK or +ERR: both prove that the rate matches).
+     */
+    bool probeBaudRate();
 
     struct NeedsStream {
         template<typename T>
@@ -534,10 +1046,115 @@ private:
     NeedsStream serialDef;
 
     char _buffer[64];
+
+    // Shadow copy of the module settings; a bit in `valid` is set once the field matches the module
+    static const uint16_t SETTING_MODE        = 0x0001;
+    static const uint16_t SETTING_BAUD_RATE   = 0x0002;
+    static const uint16_t SETTING_CHANNEL     = 0x0004;
+    static const uint16_t SETTING_BANDWIDTH   = 0x0008;
+    static const uint16_t SETTING_NETWORK_ID  = 0x0010;
+    static const uint16_t SETTING_ADDRESS     = 0x0020;
+    static const uint16_t SETTING_TAG_DUTY    = 0x0040;
+    static const uint16_t SETTING_RF_POWER    = 0x0080;
+    static const uint16_t SETTING_RSSI        = 0x0100;
+    static const uint16_t SETTING_CALIBRATION = 0x0200;
+
+    struct Settings {
+        uint16_t valid;
+        RYUW122Mode mode;
+        RYUW122BaudRate baudRate;
+        RYUW122RFChannel channel;
+        RYUW122Bandwidth bandwidth;
+        RYUW122RFPower rfPower;
+        RYUW122RSSI rssiDisplay;
+        int calibration;
+        int rfEnableTime;
+        int rfDisableTime;
+        char networkId[9];
+        char address[9];
+    };
+    Settings _settings = {};
+
+    // Incremental receive state used by loop(): a line is assembled here across calls, then dispatched from a copy
+    char _rxLine[RYUW122_RX_BUFFER_SIZE];
+    uint8_t _rxLength = 0;
+    bool _rxOverflow = false;
+    // Nesting level of processIncoming() (a callback may issue a blocking command)
+    uint8_t _rxDepth = 0;
+    // Bytes read from the stream and not yet assembled; a nested processIncoming() goes on from here
+    uint8_t _rxChunk[RYUW122_RX_CHUNK_SIZE];
+    uint8_t _rxChunkLength = 0;
+    uint8_t _rxChunkPos = 0;
+#ifdef RYUW122_HAS_RX_QUEUE
+    RYUW122RxQueue* _rxQueue = nullptr;
+#endif
+
+    // A queued AT transaction; the queue is a ring of fixed slots, the head is the active one
+    struct Transaction {
+        uint16_t id;
+        bool started;
+        bool okReceived;
+        uint8_t attempts;       // times the command was sent again by the retry policy
+        RYUW122MatchMode mode;
+        unsigned long timeout;
+        unsigned long startTime;
+        TransactionCallback callback;
+        void* context;
+        char command[RYUW122_MAX_COMMAND_LENGTH];
+        char expected[24];
+    };
+    Transaction _transactions[RYUW122_TRANSACTION_QUEUE_SIZE];
+    uint8_t _txnHead = 0;
+    uint8_t _txnCount = 0;
+    uint16_t _nextTransactionId = 1;
+    // > 0 while a blocking call waits for its transaction (unsolicited frames are not dispatched)
+    uint8_t _syncDepth = 0;
+    // An unsolicited frame received during a blocking call; the strings are copied out of the line
+    struct PendingEvent {
+        RYUW122FrameType type;
+        char tagAddress[9];
+        char data[RYUW122_MAX_PAYLOAD_LENGTH + 1];
+        uint8_t payloadLength;
+        int distance;
+        int rssi;
+        bool hasRssi;
+    };
+    PendingEvent _events[RYUW122_EVENT_QUEUE_SIZE];
+    uint8_t _eventHead = 0;
+    uint8_t _eventCount = 0;
+    unsigned long _droppedEvents = 0;
+
+    // Round trip estimator of a TAG (Jacobson/Karels): srtt and rttvar are scaled by 8 and 4
+    struct RttEstimator {
+        char address[9];
+        uint32_t srtt8;
+        uint32_t rttvar4;
+        uint16_t minRtt;
+        uint16_t maxRtt;
+        uint16_t samples;
+        uint16_t timeouts;
+        uint8_t backoff;        // answers missed in a row (the doublings stop at RYUW122_RTT_MAX_BACKOFF)
+        unsigned long lastUsed; // millis(), the least recently used one is replaced when full
+    };
+    RttEstimator _rtt[RYUW122_MAX_TRACKED_TAGS];
+    uint8_t _rttCount = 0;
+    // All the TAGs together: the starting point of a TAG never answered
+    RttEstimator _rttAll = {};
+    unsigned long _rttFloor = RYUW122_RTT_MIN_TIMEOUT;
+    unsigned long _rttCeiling = RYUW122_RTT_MAX_TIMEOUT;
+
+    RYUW122RetryPolicy* _retryPolicy = nullptr;
+
+    // +ERR code of the last command sent (NONE when it was not refused)
+    RYUW122ErrorCode _lastError = RYUW122ErrorCode::NONE;
+
     AnchorReceiveCallback _anchorReceiveCallback = nullptr;
+    RYUW122RangeListener* _rangeListeners = nullptr;
     TagReceiveCallback _tagReceiveCallback = nullptr;
     SimpleMessageCallback _simpleMessageCallback = nullptr;
     SimpleDistanceCallback _simpleDistanceCallback = nullptr;
+    WaitCallback _waitCallback = nullptr;
+    void* _waitContext = nullptr;
     MeasureUnit _preferredUnit = MeasureUnit::CENTIMETERS;
 
     // Timeout configuration (milliseconds)
@@ -546,13 +1163,6 @@ private:
     // Stream timeout passed to Stream::setTimeout() (used by readStringUntil etc.)
     unsigned long _streamTimeoutMs = 500; // 500 ms default for stream read timeouts
 
-    // Timeout setters/getters
-    void setCommandTimeout(unsigned long ms);
-    unsigned long getCommandTimeout() const;
-
-    void setStreamTimeout(unsigned long ms);
-    unsigned long getStreamTimeout() const;
-
 private:
     /**
      * @brief Sends an AT command and checks for expected response.
@@ -580,16 +1190,114 @@ private:
     bool sendCommandAndGetResponse(const __FlashStringHelper* command, char* response, int responseSize, int timeout = 0);
 
     /**
-     * @brief Parses incoming ANCHOR_RCV messages and triggers callback.
-     * @param response The response string to parse.
+     * @brief Drains the bytes already available on the stream into the line accumulator.
+     * Each completed (and trimmed) line is passed to handleLine(); never waits for data.
+     * The bytes are fetched RYUW122_RX_CHUNK_SIZE at a time with readAvailable().
+     */
+    void processIncoming();
+
+#ifdef RYUW122_HAS_RX_QUEUE
+    /**
+     * @brief Dispatches the lines queued by the receive queue, the ones already there only.
+     */
+    void processQueue();
+#endif
+
+    /**
+     * @brief Dispatches a complete unsolicited line to the matching parser.
+     * @param line The trimmed, null-terminated line.
+     * @param entry The queue entry of the line, with the frame already decoded (or nullptr).
+     */
+    void handleLine(const char* line, RYUW122RxEntry* entry = nullptr);
+
+    /**
+     * @brief Reserves a slot at the tail of the transaction queue.
+     * @return The slot (id assigned, command/expected empty) or nullptr if the queue is full.
+     */
+    Transaction* allocateTransaction(RYUW122MatchMode mode, unsigned long timeout, TransactionCallback callback,
+                                     void* context);
+
+    /**
+     * @brief Starts the head transaction if idle and expires it on timeout.
+     */
+    void serviceTransactions();
+
+    // Outcome of offering a received line to the active transaction
+    enum TransactionMatch {
+        TXN_NOT_MATCHED, // not for the transaction (unsolicited or unrelated)
+        TXN_CONSUMED,    // intermediate answer (the +OK of an AT+ANCHOR_SEND)
+        TXN_COMPLETED,   // expected answer
+        TXN_UNEXPECTED,  // a different answer ends the transaction
+        TXN_ERROR        // +ERR=<n>: the module refused the command
+    };
+
+    /**
+     * @brief Checks a received line against the active transaction without modifying it.
      */
-    void parseAnchorReceive(char* response);
+    TransactionMatch matchTransaction(const char* line);
 
     /**
-     * @brief Parses incoming TAG_RCV messages and triggers callback.
-     * @param response The response string to parse.
+     * @brief Removes the head transaction, invokes its callback and starts the next one.
      */
-    void parseTagReceive(char* response);
+    void completeTransaction(RYUW122TransactionStatus status, const char* response, const RYUW122Frame* frame,
+                             RYUW122ErrorCode error = RYUW122ErrorCode::NONE);
+
+    /**
+     * @brief Checks whether a transaction is a ranging exchange: an AT+ANCHOR_SEND that waits for the
+     * +ANCHOR_RCV of its TAG, not one done at the +OK of the module (anchorSendData(), submitCommand()).
+     */
+    static bool isRangingExchange(const Transaction& t);
+
+    /**
+     * @brief Finds the round trip estimator of a TAG.
+     * @return The estimator, or nullptr if the TAG is not tracked.
+     */
+    const RttEstimator* findRtt(const char* tagAddress) const;
+
+    /**
+     * @brief Accounts the outcome of an AT+ANCHOR_SEND exchange.
+     * @param answered True if the +ANCHOR_RCV arrived, false on timeout.
+     * @param elapsed Milliseconds from the command to the answer.
+     */
+    void updateRtt(const char* tagAddress, bool answered, unsigned long elapsed);
+
+    /**
+     * @brief Timeout derived from an estimator (nullptr for a TAG never seen).
+     */
+    unsigned long rttTimeout(const RttEstimator* estimator) const;
+
+    /**
+     * @brief Blocks until a transaction queued with the given parameters has finished.
+     * This is the engine behind every blocking command: loop() work keeps running while waiting.
+     * @param response Buffer receiving the matched line (can be nullptr).
+     * @param frame Receives the decoded fields when the answer is a +ANCHOR_RCV/+TAG_RCV frame (can be nullptr).
+     * @return The final status of the transaction.
+     */
+    RYUW122TransactionStatus runTransaction(const char* command, bool commandInFlash,
+                                            const char* expected, bool expectedInFlash, RYUW122MatchMode mode, unsigned long timeout,
+                                            char* response, int responseSize, AnchorResponse* frame = nullptr);
+
+    /**
+     * @brief Copies an unsolicited frame into the event queue, replacing the oldest one if full.
+     */
+    void queueEvent(const RYUW122Frame& frame);
+
+    /**
+     * @brief Passes the queued frames to the callbacks, oldest first (not while a blocking call waits).
+     */
+    void dispatchEvents();
+
+    /**
+     * @brief Triggers the ANCHOR callbacks for a decoded +ANCHOR_RCV frame.
+     * @param frame The decoded frame.
+     */
+    void dispatchAnchorReceive(const RYUW122Frame& frame);
+
+    /**
+     * @brief Triggers the TAG callbacks for a decoded +TAG_RCV frame.
+     * @param frame The decoded frame.
+     */
+    void dispatchTagReceive(const RYUW122Frame& frame);
 
     /**
      * @brief Checks for available data on the serial stream.
@@ -603,6 +1311,13 @@ private:
      */
     int read();
 
+    /**
+     * @brief Polls the module with AT until it answers, after a setting has been changed.
+     * @param timeout Longest time to wait in milliseconds.
+     * @return True if the module answered in time.
+     */
+    bool waitReady(unsigned long timeout = RYUW122_READY_TIMEOUT);
+
     /**
      * @brief Non-blocking delay implementation using millis().
      * @param timeout Time to wait in milliseconds.
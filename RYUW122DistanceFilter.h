@@ -0,0 +1,401 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Zero-heap per-TAG distance filtering pipeline for the RYUW122 library
+ */
+
+#ifndef RYUW122_DISTANCE_FILTER_H
+#define RYUW122_DISTANCE_FILTER_H
+
+#include "RYUW122.h"
+
+/*
+ * Filter stages work on integer distances in cm and keep their state in fixed point, so
+ * they run on AVR without floating point. Each stage implements
+ *
+ *     int32_t update(int32_t cm, uint32_t dtMs);   // dtMs: time since the previous sample
+ *     void reset();
+ *
+ * and can be used alone or chained with RYUW122FilterChain. The parameters are given as
+ * template arguments and can be changed at run time with the setters.
+ */
+
+/**
+ * @class RYUW122MedianFilter
+ * @brief Rolling median of the last Window samples; removes isolated outliers.
+ *
+ * The window is kept sorted, so a sample costs one removal and one insertion (at most
+ * Window moves, constant for a given window).
+ *
+ * @tparam Window Number of samples (1-32); odd values give a true median.
+ */
+template <uint8_t Window = 3>
+class RYUW122MedianFilter {
+    static_assert(Window > 0 && Window <= 32, "Window must be 1-32");
+
+public:
+    RYUW122MedianFilter() { reset(); }
+
+    int32_t update(int32_t cm, uint32_t dtMs) {
+        (void)dtMs;
+        int16_t value = cm > 32767 ? 32767 : (cm < -32768 ? -32768 : (int16_t)cm);
+
+        uint8_t i = _count;
+        if (_count == Window) {
+            // Drop the oldest sample from the sorted window
+            int16_t oldest = _ring[_head];
+            i = 0;
+            while (_sorted[i] != oldest) i++;
+            while (i + 1 < Window) { _sorted[i] = _sorted[i + 1]; i++; }
+        } else {
+            _count++;
+        }
+        _ring[_head] = value;
+        _head = (uint8_t)((_head + 1) % Window);
+
+        // Insertion into the sorted window (i is the free slot at its end)
+        while (i > 0 && _sorted[i - 1] > value) { _sorted[i] = _sorted[i - 1]; i--; }
+        _sorted[i] = value;
+
+        if (_count & 1) return _sorted[_count / 2];
+        return ((int32_t)_sorted[_count / 2 - 1] + _sorted[_count / 2]) / 2;
+    }
+
+    void reset() { _head = 0; _count = 0; }
+
+private:
+    int16_t _ring[Window];
+    int16_t _sorted[Window];
+    uint8_t _head;
+    uint8_t _count;
+};
+
+/**
+ * @class RYUW122EmaFilter
+ * @brief Exponential moving average: out += alpha * (in - out).
+ *
+ * The first sample initializes the average. The state has 1/16 cm resolution.
+ *
+ * @tparam AlphaPercent Weight of the new sample, 1-100 (100 = no smoothing).
+ */
+template <uint8_t AlphaPercent = 50>
+class RYUW122EmaFilter {
+    static_assert(AlphaPercent > 0 && AlphaPercent <= 100, "AlphaPercent must be 1-100");
+
+public:
+    RYUW122EmaFilter() { setAlpha(AlphaPercent); reset(); }
+
+    int32_t update(int32_t cm, uint32_t dtMs) {
+        (void)dtMs;
+        int32_t sample = cm * 16;
+        if (!_primed) {
+            _state = sample;
+            _primed = true;
+        } else {
+            _state += ((sample - _state) * _alpha) / 256;
+        }
+        return roundQ4(_state);
+    }
+
+    void reset() { _primed = false; _state = 0; }
+
+    void setAlpha(uint8_t alphaPercent) {
+        if (alphaPercent == 0) alphaPercent = 1;
+        if (alphaPercent > 100) alphaPercent = 100;
+        _alpha = (int16_t)(((uint16_t)alphaPercent * 256 + 50) / 100);
+    }
+
+private:
+    static int32_t roundQ4(int32_t v) { return v >= 0 ? (v + 8) / 16 : -((-v + 8) / 16); }
+
+    int32_t _state;
+    int16_t _alpha; // 1/256 units
+    bool _primed;
+};
+
+#ifndef RYUW122_KALMAN_MAX_GAP
+#define RYUW122_KALMAN_MAX_GAP 2000 // ms
+#endif
+
+/**
+ * @class RYUW122KalmanFilter
+ * @brief 1D constant-velocity Kalman filter (distance and radial speed).
+ *
+ * Tracks a moving TAG without the lag of an average: the prediction uses the estimated
+ * speed and the real time between samples. The process noise is a white acceleration of
+ * standard deviation AccelerationNoise. The state and the covariance are fixed point
+ * (1/256 cm, 1/256 cm/s, 1/256 cm^2 units) with 64-bit intermediate products; no floats.
+ * A gap longer than RYUW122_KALMAN_MAX_GAP restarts the filter from the next sample.
+ *
+ * @tparam MeasurementNoise Standard deviation of a measurement in cm (module: ~10 cm).
+ * @tparam AccelerationNoise Standard deviation of the acceleration in cm/s^2 (walking: ~100).
+ */
+template <uint16_t MeasurementNoise = 10, uint16_t AccelerationNoise = 100>
+class RYUW122KalmanFilter {
+public:
+    RYUW122KalmanFilter() { setNoise(MeasurementNoise, AccelerationNoise); reset(); }
+
+    int32_t update(int32_t cm, uint32_t dtMs) {
+        int32_t z = cm * 256;
+        if (!_primed || dtMs > RYUW122_KALMAN_MAX_GAP) {
+            _x = z;
+            _v = 0;
+            _p00 = _r;
+            _p01 = 0;
+            _p11 = (int32_t)100 * 100 * 256; // initial speed uncertainty: 100 cm/s
+            _primed = true;
+            return cm;
+        }
+
+        // Predict: x += v * dt, P = F P F' + Q
+        int64_t dt = dtMs;
+        int64_t a = (int64_t)_q * dt * dt / 1000000;   // sigma_a^2 * dt^2
+        int64_t q01 = a * dt / 2000;                    // sigma_a^2 * dt^3 / 2
+        int64_t q00 = q01 * dt / 2000;                  // sigma_a^2 * dt^4 / 4
+        _x += (int32_t)((int64_t)_v * dt / 1000);
+        // Clamped before the update: p00 * p00 must fit 64 bits (a long gap at the largest noise reaches ~5e9)
+        int64_t p00 = clampCovariance(_p00 + (2 * (int64_t)_p01 * dt + (int64_t)_p11 * dt * dt / 1000) / 1000 + q00);
+        int64_t p01 = clampCovariance(_p01 + (int64_t)_p11 * dt / 1000 + q01);
+        int64_t p11 = clampCovariance(_p11 + a);
+
+        // Update with the measurement
+        int64_t s = p00 + _r;
+        int64_t y = (int64_t)z - _x;
+        _x += (int32_t)(p00 * y / s);
+        _v += (int32_t)(p01 * y / s);
+        _p00 = clampCovariance(p00 - p00 * p00 / s);
+        _p01 = clampCovariance(p01 - p00 * p01 / s);
+        _p11 = clampCovariance(p11 - p01 * p01 / s);
+
+        return _x >= 0 ? (_x + 128) / 256 : -((-_x + 128) / 256);
+    }
+
+    void reset() { _primed = false; _x = 0; _v = 0; _p00 = 0; _p01 = 0; _p11 = 0; }
+
+    /**
+     * @param measurementNoise Standard deviation of a measurement in cm.
+     * @param accelerationNoise Standard deviation of the acceleration in cm/s^2 (max 1000).
+     */
+    void setNoise(uint16_t measurementNoise, uint16_t accelerationNoise) {
+        if (measurementNoise == 0) measurementNoise = 1;
+        if (accelerationNoise > 1000) accelerationNoise = 1000;
+        _r = (int32_t)measurementNoise * measurementNoise * 256;
+        _q = (int32_t)accelerationNoise * accelerationNoise * 256;
+    }
+
+    /**
+     * @brief Estimated radial speed in cm/s (positive: the TAG is moving away).
+     */
+    int32_t getVelocity() const { return _v / 256; }
+
+private:
+    static int32_t clampCovariance(int64_t p) {
+        if (p > 0x3FFFFFFF) return 0x3FFFFFFF;
+        if (p < -0x3FFFFFFF) return -0x3FFFFFFF;
+        return (int32_t)p;
+    }
+
+    int32_t _x, _v;           // 1/256 cm, 1/256 cm/s
+    int32_t _p00, _p01, _p11; // 1/256 units
+    int32_t _r, _q;           // 1/256 cm^2, 1/256 cm^2/s^4
+    bool _primed;
+};
+
+/**
+ * @class RYUW122RateLimiter
+ * @brief Limits the change of the output to MaxSpeed cm/s; rejects physically impossible jumps.
+ *
+ * @tparam MaxSpeed Maximum change in cm per second (a walking person: ~200).
+ */
+template <uint16_t MaxSpeed = 200>
+class RYUW122RateLimiter {
+public:
+    RYUW122RateLimiter() { setMaxSpeed(MaxSpeed); reset(); }
+
+    int32_t update(int32_t cm, uint32_t dtMs) {
+        if (!_primed) {
+            _last = cm;
+            _primed = true;
+            return cm;
+        }
+        if (dtMs > 60000) dtMs = 60000;
+        int32_t step = (int32_t)((uint32_t)_maxSpeed * dtMs / 1000);
+        if (step < 1) step = 1;
+        if (cm > _last + step) cm = _last + step;
+        else if (cm < _last - step) cm = _last - step;
+        _last = cm;
+        return cm;
+    }
+
+    void reset() { _primed = false; _last = 0; }
+    void setMaxSpeed(uint16_t cmPerSecond) { _maxSpeed = cmPerSecond; }
+
+private:
+    int32_t _last;
+    uint16_t _maxSpeed;
+    bool _primed;
+};
+
+/**
+ * @class RYUW122FilterChain
+ * @brief Runs a sample through the stages in order: RYUW122FilterChain<A, B, C> is C(B(A(x))).
+ *
+ * @code
+ * RYUW122FilterChain<RYUW122MedianFilter<5>, RYUW122KalmanFilter<10, 100> > chain;
+ * int32_t cm = chain.update(rawCm, millis() - lastMs);
+ * chain.stage<1>().setNoise(15, 50);   // stages are reachable by position
+ * @endcode
+ */
+template <typename... Stages>
+class RYUW122FilterChain;
+
+template <>
+class RYUW122FilterChain<> {
+public:
+    int32_t update(int32_t cm, uint32_t dtMs) { (void)dtMs; return cm; }
+    void reset() {}
+};
+
+template <uint8_t Index, typename... Stages>
+struct RYUW122FilterStageAt;
+
+template <typename First, typename... Rest>
+class RYUW122FilterChain<First, Rest...> {
+public:
+    int32_t update(int32_t cm, uint32_t dtMs) { return _rest.update(_first.update(cm, dtMs), dtMs); }
+    void reset() { _first.reset(); _rest.reset(); }
+
+    First& first() { return _first; }
+    RYUW122FilterChain<Rest...>& rest() { return _rest; }
+
+    template <uint8_t Index>
+    typename RYUW122FilterStageAt<Index, First, Rest...>::Type& stage() {
+        return RYUW122FilterStageAt<Index, First, Rest...>::get(*this);
+    }
+
+private:
+    First _first;
+    RYUW122FilterChain<Rest...> _rest;
+};
+
+template <typename First, typename... Rest>
+struct RYUW122FilterStageAt<0, First, Rest...> {
+    typedef First Type;
+    static Type& get(RYUW122FilterChain<First, Rest...>& chain) { return chain.first(); }
+};
+
+template <uint8_t Index, typename First, typename... Rest>
+struct RYUW122FilterStageAt<Index, First, Rest...> {
+    typedef typename RYUW122FilterStageAt<Index - 1, Rest...>::Type Type;
+    static Type& get(RYUW122FilterChain<First, Rest...>& chain) {
+        return RYUW122FilterStageAt<Index - 1, Rest...>::get(chain.rest());
+    }
+};
+
+/**
+ * @class RYUW122DistanceFilter
+ * @brief One filter chain per TAG, fed by the driver with every +ANCHOR_RCV.
+ *
+ * Registered as a range listener, it filters each measurement before the ANCHOR callbacks,
+ * the transaction callbacks and the ranging scheduler results run, so they can read the
+ * filtered distance directly. The time between samples comes from the arrival timestamps.
+ *
+ * @code
+ * RYUW122DistanceFilter<3, RYUW122MedianFilter<3>, RYUW122EmaFilter<60> > filter;
+ * uwb.addRangeListener(&filter);
+ *
+ * void onRangingResult(const RYUW122RangingResult& result, void* context) {
+ *     int32_t cm = filter.getDistance(result.tagAddress);
+ * }
+ * @endcode
+ *
+ * @tparam MaxTags Number of TAGs filtered (1-127); TAGs are added on their first measurement.
+ * @tparam Stages The filter stages, applied in order.
+ */
+template <uint8_t MaxTags, typename... Stages>
+class RYUW122DistanceFilter : public RYUW122RangeListener {
+    static_assert(MaxTags > 0 && MaxTags <= 127, "MaxTags must be 1-127");
+
+public:
+    RYUW122DistanceFilter() : _tagCount(0) {}
+
+    void onRange(const RYUW122Frame& frame, unsigned long timestampUs) override {
+        int8_t tag = getTagIndex(frame.tagAddress);
+        if (tag < 0) tag = addTag(frame.tagAddress);
+        if (tag < 0) return; // full: TAGs beyond MaxTags are ignored
+
+        uint32_t dtMs = _count[tag] ? (uint32_t)(timestampUs - _lastUs[tag]) / 1000 : 0;
+        _distance[tag] = _chains[tag].update(frame.distance, dtMs);
+        _lastUs[tag] = (uint32_t)timestampUs;
+        if (_count[tag] < 0xFFFF) _count[tag]++;
+    }
+
+    /**
+     * @brief Reserves a slot for a TAG, so that its index is known before its first measurement.
+     * @return The TAG index, or -1 if the address is invalid or the filter is full.
+     */
+    int8_t addTag(const char* tagAddress) {
+        int8_t tag = getTagIndex(tagAddress);
+        if (tag >= 0) return tag;
+        if (!tagAddress || strlen(tagAddress) != 8 || _tagCount >= MaxTags) return -1;
+        strcpy(_address[_tagCount], tagAddress);
+        reset(_tagCount);
+        return (int8_t)_tagCount++;
+    }
+
+    int8_t getTagIndex(const char* tagAddress) const {
+        if (!tagAddress) return -1;
+        for (uint8_t t = 0; t < _tagCount; t++) {
+            if (strcmp(_address[t], tagAddress) == 0) return (int8_t)t;
+        }
+        return -1;
+    }
+
+    uint8_t getTagCount() const { return _tagCount; }
+    const char* getTagAddress(uint8_t tag) const { return tag < _tagCount ? _address[tag] : ""; }
+
+    /**
+     * @brief Filtered distance in cm, or -1 if the TAG has no measurement yet.
+     */
+    int32_t getDistance(uint8_t tag) const { return tag < _tagCount && _count[tag] ? _distance[tag] : -1; }
+    int32_t getDistance(const char* tagAddress) const {
+        int8_t tag = getTagIndex(tagAddress);
+        return tag < 0 ? -1 : getDistance((uint8_t)tag);
+    }
+
+    /**
+     * @brief Measurements filtered for a TAG since its last reset.
+     */
+    uint16_t getCount(uint8_t tag) const { return tag < _tagCount ? _count[tag] : 0; }
+
+    /**
+     * @brief The filter chain of a TAG, to tune its stages at run time.
+     */
+    RYUW122FilterChain<Stages...>& getChain(uint8_t tag) { return _chains[tag]; }
+
+    /**
+     * @brief Restarts the filters of a TAG (its slot stays reserved).
+     */
+    void reset(uint8_t tag) {
+        if (tag >= MaxTags) return;
+        _chains[tag].reset();
+        _distance[tag] = -1;
+        _lastUs[tag] = 0;
+        _count[tag] = 0;
+    }
+
+    void reset() {
+        for (uint8_t t = 0; t < _tagCount; t++) reset(t);
+    }
+
+private:
+    RYUW122FilterChain<Stages...> _chains[MaxTags];
+    int32_t _distance[MaxTags];
+    uint32_t _lastUs[MaxTags];
+    uint16_t _count[MaxTags];
+    char _address[MaxTags][9];
+    uint8_t _tagCount;
+};
+
+#endif // RYUW122_DISTANCE_FILTER_H
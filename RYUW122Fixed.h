@@ -0,0 +1,93 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Q16.16 fixed-point number for the RYUW122 positioning on FPU-less boards
+ */
+
+#ifndef RYUW122_FIXED_H
+#define RYUW122_FIXED_H
+
+#include <stdint.h>
+
+/**
+ * @class RYUW122Fixed
+ * @brief Signed Q16.16 fixed-point number (range +/-32768, resolution 1/65536).
+ *
+ * A drop-in replacement for float in the positioning kernel: the operators use 32-bit
+ * additions and 64-bit products, so an 8-bit AVR runs them several times faster than
+ * the emulated float. Results are not saturated; the kernel keeps its values in a range
+ * close to 1 (see RYUW122Multilateration.h).
+ */
+class RYUW122Fixed {
+public:
+    static const uint8_t FRACTION_BITS = 16;
+    static const int32_t ONE = (int32_t)1 << FRACTION_BITS;
+
+    RYUW122Fixed() : _raw(0) {}
+    RYUW122Fixed(int value) : _raw((int32_t)value * ONE) {}
+    explicit RYUW122Fixed(float value) : _raw((int32_t)(value * ONE + (value >= 0.0f ? 0.5f : -0.5f))) {}
+
+    static RYUW122Fixed fromRaw(int32_t raw) { RYUW122Fixed f; f._raw = raw; return f; }
+
+    /**
+     * @brief numerator / denominator without floating point (e.g. fromRatio(cm, 100) for meters).
+     */
+    static RYUW122Fixed fromRatio(int32_t numerator, int32_t denominator) {
+        return fromRaw((int32_t)(((int64_t)numerator * ONE) / denominator));
+    }
+
+    int32_t raw() const { return _raw; }
+    float toFloat() const { return (float)_raw / ONE; }
+    explicit operator float() const { return toFloat(); }
+
+    RYUW122Fixed operator-() const { return fromRaw(-_raw); }
+    RYUW122Fixed operator+(RYUW122Fixed o) const { return fromRaw(_raw + o._raw); }
+    RYUW122Fixed operator-(RYUW122Fixed o) const { return fromRaw(_raw - o._raw); }
+    RYUW122Fixed operator*(RYUW122Fixed o) const {
+        int64_t product = (int64_t)_raw * o._raw;
+        return fromRaw((int32_t)((product + (ONE >> 1)) >> FRACTION_BITS));
+    }
+    RYUW122Fixed operator/(RYUW122Fixed o) const {
+        if (o._raw == 0) return fromRaw(_raw >= 0 ? INT32_MAX : INT32_MIN);
+        return fromRaw((int32_t)(((int64_t)_raw << FRACTION_BITS) / o._raw));
+    }
+
+    RYUW122Fixed& operator+=(RYUW122Fixed o) { _raw += o._raw; return *this; }
+    RYUW122Fixed& operator-=(RYUW122Fixed o) { _raw -= o._raw; return *this; }
+    RYUW122Fixed& operator*=(RYUW122Fixed o) { return *this = *this * o; }
+    RYUW122Fixed& operator/=(RYUW122Fixed o) { return *this = *this / o; }
+
+    bool operator<(RYUW122Fixed o) const { return _raw < o._raw; }
+    bool operator>(RYUW122Fixed o) const { return _raw > o._raw; }
+    bool operator<=(RYUW122Fixed o) const { return _raw <= o._raw; }
+    bool operator>=(RYUW122Fixed o) const { return _raw >= o._raw; }
+    bool operator==(RYUW122Fixed o) const { return _raw == o._raw; }
+    bool operator!=(RYUW122Fixed o) const { return _raw != o._raw; }
+
+    /**
+     * @brief Square root (0 for negative values), bit by bit on the 48-bit scaled value.
+     */
+    static RYUW122Fixed sqrt(RYUW122Fixed value) {
+        if (value._raw <= 0) return RYUW122Fixed();
+        uint64_t x = (uint64_t)value._raw << FRACTION_BITS;
+        uint64_t result = 0;
+        uint64_t bit = (uint64_t)1 << 46;
+        while (bit > x) bit >>= 2;
+        while (bit != 0) {
+            if (x >= result + bit) {
+                x -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return fromRaw((int32_t)result);
+    }
+
+private:
+    int32_t _raw;
+};
+
+#endif // RYUW122_FIXED_H
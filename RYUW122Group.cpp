@@ -0,0 +1,141 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Several RYUW122 modules driven from one loop: implementation
+ */
+
+#include "RYUW122Group.h"
+
+RYUW122Group::RYUW122Group() {
+    _statsStart = millis();
+}
+
+int8_t RYUW122Group::add(RYUW122& uwb, RYUW122RangingScheduler* scheduler) {
+    if (_count >= RYUW122_GROUP_MAX_MODULES) return -1;
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_members[i].uwb == &uwb) return -1;
+    }
+
+    Member& member = _members[_count];
+    member.group = this;
+    member.uwb = &uwb;
+    member.scheduler = scheduler;
+    member.busy = false;
+    member.measurements = 0;
+    member.services = 0;
+    member.busyTime = 0;
+    member.maxService = 0;
+    uwb.addRangeListener(&member);
+    uwb.onWait(waitCallback, &member);
+    return (int8_t)_count++;
+}
+
+bool RYUW122Group::begin() {
+    bool ok = true;
+    for (uint8_t i = 0; i < _count; i++) {
+        Member& member = _members[i];
+        // The others run while this one waits for its answers
+        member.busy = true;
+        if (!member.uwb->begin()) {
+            DEBUG_PRINT(F("Group: module "));
+            DEBUG_PRINT(i);
+            DEBUG_PRINTLN(F(" did not start"));
+            ok = false;
+        }
+        member.busy = false;
+    }
+    return ok;
+}
+
+void RYUW122Group::start() {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_members[i].scheduler) _members[i].scheduler->start();
+    }
+}
+
+void RYUW122Group::stop() {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_members[i].scheduler) _members[i].scheduler->stop();
+    }
+}
+
+void RYUW122Group::loop() {
+    serviceAll();
+}
+
+void RYUW122Group::serviceAll() {
+    if (_count == 0) return;
+    uint8_t first = _next;
+    _next = (uint8_t)((_next + 1) % _count);
+    for (uint8_t i = 0; i < _count; i++) {
+        service(_members[(first + i) % _count]);
+    }
+}
+
+void RYUW122Group::service(Member& member) {
+    if (member.busy) return;
+    member.busy = true;
+
+    unsigned long outerNested = _nestedTime;
+    _nestedTime = 0;
+    unsigned long start = micros();
+
+    if (member.scheduler) {
+        member.scheduler->loop();
+    } else {
+        member.uwb->loop();
+    }
+
+    unsigned long elapsed = micros() - start;
+    unsigned long own = elapsed - _nestedTime;
+    _nestedTime = outerNested + elapsed;
+
+    member.services++;
+    member.busyTime += own;
+    if (own > member.maxService) member.maxService = own;
+    member.busy = false;
+}
+
+void RYUW122Group::waitCallback(void* context) {
+    Member* member = static_cast<Member*>(context);
+    // A blocking call of a module: the other modules go on meanwhile
+    bool busy = member->busy;
+    member->busy = true;
+    member->group->serviceAll();
+    member->busy = busy;
+}
+
+void RYUW122Group::Member::onRange(const RYUW122Frame& frame, unsigned long timestampUs) {
+    (void)frame;
+    (void)timestampUs;
+    measurements++;
+}
+
+RYUW122GroupStats RYUW122Group::getStats(uint8_t index) const {
+    RYUW122GroupStats stats = {};
+    if (index >= _count) return stats;
+
+    const Member& member = _members[index];
+    stats.measurements = member.measurements;
+    stats.services = member.services;
+    stats.busyTime = member.busyTime;
+    stats.maxService = member.maxService;
+
+    unsigned long elapsed = millis() - _statsStart;
+    if (elapsed > 0) {
+        stats.measurementRate = member.measurements * 1000.0f / elapsed;
+        stats.load = member.busyTime / (elapsed * 1000.0f);
+    }
+    return stats;
+}
+
+void RYUW122Group::resetStats() {
+    for (uint8_t i = 0; i < _count; i++) {
+        _members[i].measurements = 0;
+        _members[i].services = 0;
+        _members[i].busyTime = 0;
+        _members[i].maxService = 0;
+    }
+    _statsStart = millis();
+}
@@ -0,0 +1,129 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Several RYUW122 modules driven from one loop
+ */
+
+#ifndef RYUW122_GROUP_H
+#define RYUW122_GROUP_H
+
+#include "RYUW122.h"
+#include "RYUW122RangingScheduler.h"
+
+// Number of modules a group can drive (one per UART of the board)
+#ifndef RYUW122_GROUP_MAX_MODULES
+    #if defined(ARDUINO_ARCH_AVR)
+        #define RYUW122_GROUP_MAX_MODULES 2
+    #else
+        #define RYUW122_GROUP_MAX_MODULES 4
+    #endif
+#endif
+
+/**
+ * @brief Figures of one module of a group, since the last resetStats().
+ */
+struct RYUW122GroupStats {
+    unsigned long measurements;  ///< +ANCHOR_RCV received (one per answered exchange)
+    unsigned long services;      ///< Times the group ran the module (loop() or its scheduler)
+    unsigned long busyTime;      ///< Microseconds spent in the module, without the other modules run meanwhile
+    unsigned long maxService;    ///< Longest single run in microseconds (a blocking call shows up here)
+    float measurementRate;       ///< Measurements per second
+    float load;                  ///< Share of the elapsed time spent in the module (0 to 1)
+};
+
+/**
+ * @class RYUW122Group
+ * @brief Drives several modules (one per UART) from a single loop(), without one stalling the others.
+ *
+ * Each module keeps its own transaction queue, so the ranging exchanges of the modules are in
+ * flight at the same time: the group loop() runs every module in turn (the start rotates at
+ * each pass, so none always goes first), through its RYUW122RangingScheduler when it has one.
+ *
+ * The group also registers itself with onWait() on each module: while a blocking call of a
+ * module (anchorSendDataSync(), a setter...) waits for its answer, the other modules keep
+ * running. A module that is already running (or waiting) is never entered again.
+ *
+ * @code
+ * RYUW122T<HardwareSerial> uwb1(&Serial1), uwb2(&Serial2);
+ * RYUW122RangingScheduler ranging1(uwb1), ranging2(uwb2);
+ * RYUW122Group group;
+ *
+ * void setup() {
+ *     group.add(uwb1, &ranging1);
+ *     group.add(uwb2, &ranging2);
+ *     group.begin();                       // begin() of every module
+ *     ...                                  // addTag() and setMode(ANCHOR) on each
+ *     group.start();                       // start() of every scheduler
+ * }
+ * void loop() { group.loop(); }
+ * @endcode
+ *
+ * The modules stay owned by the sketch (nothing is allocated); each one is a range listener
+ * of its module (for the statistics) and takes its onWait() slot.
+ */
+class RYUW122Group {
+public:
+    RYUW122Group();
+
+    /**
+     * @brief Adds a module, with the scheduler that ranges through it (if any).
+     * @return The index of the module, -1 if the group is full or the module is already in it.
+     */
+    int8_t add(RYUW122& uwb, RYUW122RangingScheduler* scheduler = nullptr);
+
+    uint8_t getCount() const { return _count; }
+    RYUW122& get(uint8_t index) { return *_members[index].uwb; }
+    RYUW122RangingScheduler* getScheduler(uint8_t index) { return _members[index].scheduler; }
+
+    /**
+     * @brief Calls begin() of every module (each one keeps the others running while it waits).
+     * @return True if all of them started.
+     */
+    bool begin();
+
+    /**
+     * @brief Starts / stops the schedulers of the modules.
+     */
+    void start();
+    void stop();
+
+    /**
+     * @brief Runs every module once; call it in the main loop instead of the loop() of the modules.
+     */
+    void loop();
+
+    RYUW122GroupStats getStats(uint8_t index) const;
+    void resetStats();
+
+private:
+    struct Member : public RYUW122RangeListener {
+        void onRange(const RYUW122Frame& frame, unsigned long timestampUs) override;
+
+        RYUW122Group* group;
+        RYUW122* uwb;
+        RYUW122RangingScheduler* scheduler;
+        bool busy;                  // running or waiting: not entered again
+        unsigned long measurements;
+        unsigned long services;
+        unsigned long busyTime;
+        unsigned long maxService;
+    };
+
+    static void waitCallback(void* context);
+
+    /**
+     * @brief Runs each module once, except the busy ones, starting from the next in turn.
+     */
+    void serviceAll();
+    void service(Member& member);
+
+    Member _members[RYUW122_GROUP_MAX_MODULES];
+    uint8_t _count = 0;
+    uint8_t _next = 0;
+    // Time of the modules run inside the current one (its blocking wait), not accounted to it
+    unsigned long _nestedTime = 0;
+    unsigned long _statsStart = 0;
+};
+
+#endif // RYUW122_GROUP_H
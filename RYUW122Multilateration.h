@@ -0,0 +1,344 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Multilateration kernel of the RYUW122 positioning, for float and fixed point
+ */
+
+#ifndef RYUW122_MULTILATERATION_H
+#define RYUW122_MULTILATERATION_H
+
+#include <stdint.h>
+#include <math.h>
+
+#include "RYUW122Fixed.h"
+
+// Maximum number of reference nodes (known positions) used by a solver
+#ifndef RYUW122_POSITIONING_MAX_ANCHORS
+    #if defined(ARDUINO_ARCH_AVR)
+        #define RYUW122_POSITIONING_MAX_ANCHORS 4
+    #else
+        #define RYUW122_POSITIONING_MAX_ANCHORS 8
+    #endif
+#endif
+
+// Gauss-Newton iterations per solve
+#ifndef RYUW122_POSITIONING_MAX_ITERATIONS
+#define RYUW122_POSITIONING_MAX_ITERATIONS 10
+#endif
+
+enum class RYUW122PositionStatus : uint8_t {
+    OK,
+    NOT_ENOUGH_RANGES,      ///< Fewer fresh ranges than needed for the dimensions
+    DEGENERATE_GEOMETRY,    ///< The reference nodes do not span the space (e.g. collinear in 2D)
+    NOT_CONVERGED           ///< The refinement did not settle in RYUW122_POSITIONING_MAX_ITERATIONS
+};
+
+/**
+ * @struct RYUW122ScalarTraits
+ * @brief What the kernel needs from a number type besides the arithmetic operators.
+ */
+template <typename Scalar>
+struct RYUW122ScalarTraits;
+
+template <>
+struct RYUW122ScalarTraits<float> {
+    static float sqrt(float v) { return sqrtf(v); }
+    static float fromFloat(float v) { return v; }
+    static float fromRatio(int32_t numerator, int32_t denominator) { return (float)numerator / denominator; }
+    static float toFloat(float v) { return v; }
+    static float pivotEpsilon() { return 1e-6f; }   // relative to the largest diagonal element
+    static float resolution() { return 0.0f; }
+    static float infinity() { return INFINITY; }
+};
+
+template <>
+struct RYUW122ScalarTraits<RYUW122Fixed> {
+    static RYUW122Fixed sqrt(RYUW122Fixed v) { return RYUW122Fixed::sqrt(v); }
+    static RYUW122Fixed fromFloat(float v) { return RYUW122Fixed(v); }
+    static RYUW122Fixed fromRatio(int32_t numerator, int32_t denominator) { return RYUW122Fixed::fromRatio(numerator, denominator); }
+    static float toFloat(RYUW122Fixed v) { return v.toFloat(); }
+    static RYUW122Fixed pivotEpsilon() { return RYUW122Fixed::fromRaw(16); }
+    static RYUW122Fixed resolution() { return RYUW122Fixed::fromRaw(16); }  // quantization noise of a step
+    static RYUW122Fixed infinity() { return RYUW122Fixed::fromRaw(INT32_MAX); }
+};
+
+/**
+ * @struct RYUW122MultilaterationNode
+ * @brief A reference node with its range, as given to the kernel.
+ */
+template <typename Scalar>
+struct RYUW122MultilaterationNode {
+    Scalar coord[3];
+    Scalar range;
+    Scalar weight;   ///< Relative weight (inverse of the range variance)
+};
+
+/**
+ * @struct RYUW122MultilaterationResult
+ */
+template <typename Scalar>
+struct RYUW122MultilaterationResult {
+    Scalar position[3];
+    Scalar residual;   ///< Weighted RMS of the range residuals
+    Scalar gdop;
+    RYUW122PositionStatus status;
+};
+
+/**
+ * @brief Solves a x = b in place (x returned in b) for a symmetric positive definite n x n
+ * matrix (n <= 3), by Cholesky factorization.
+ * @return False if the matrix is singular or ill-conditioned.
+ */
+template <typename Scalar>
+bool RYUW122SolveSymmetric(Scalar a[3][3], Scalar* b, uint8_t n) {
+    typedef RYUW122ScalarTraits<Scalar> Traits;
+    Scalar scale = Scalar(0);
+    for (uint8_t i = 0; i < n; i++) {
+        if (a[i][i] > scale) scale = a[i][i];
+    }
+    if (scale <= Scalar(0)) return false;
+
+    // a = L L', L stored in the lower triangle; one division per column (slow on AVR)
+    Scalar inverse[3];
+    for (uint8_t j = 0; j < n; j++) {
+        Scalar d = a[j][j];
+        for (uint8_t k = 0; k < j; k++) d -= a[j][k] * a[j][k];
+        if (d <= scale * Traits::pivotEpsilon()) return false;
+        a[j][j] = Traits::sqrt(d);
+        inverse[j] = Scalar(1) / a[j][j];
+        for (uint8_t i = j + 1; i < n; i++) {
+            Scalar s = a[i][j];
+            for (uint8_t k = 0; k < j; k++) s -= a[i][k] * a[j][k];
+            a[i][j] = s * inverse[j];
+        }
+    }
+
+    // Forward (L y = b) and back (L' x = y) substitution
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t k = 0; k < i; k++) b[i] -= a[i][k] * b[k];
+        b[i] *= inverse[i];
+    }
+    for (int8_t i = n - 1; i >= 0; i--) {
+        for (uint8_t k = i + 1; k < n; k++) b[i] -= a[k][i] * b[k];
+        b[i] *= inverse[i];
+    }
+    return true;
+}
+
+/**
+ * Subtracting the range equation of the first node from the others gives the linear system
+ * 2 (a_i - a_0) . p = r_0^2 - r_i^2 + |a_i|^2 - |a_0|^2, solved in the weighted least squares sense.
+ */
+template <typename Scalar>
+bool RYUW122LinearMultilateration(const RYUW122MultilaterationNode<Scalar>* nodes, uint8_t count,
+                                  uint8_t n, Scalar* p) {
+    const RYUW122MultilaterationNode<Scalar>& ref = nodes[0];
+    Scalar refNorm = Scalar(0);
+    for (uint8_t k = 0; k < n; k++) refNorm += ref.coord[k] * ref.coord[k];
+
+    Scalar normal[3][3];
+    Scalar rhs[3];
+    for (uint8_t r = 0; r < 3; r++) {
+        rhs[r] = Scalar(0);
+        for (uint8_t c = 0; c < 3; c++) normal[r][c] = Scalar(0);
+    }
+    for (uint8_t i = 1; i < count; i++) {
+        const RYUW122MultilaterationNode<Scalar>& a = nodes[i];
+        Scalar row[3];
+        Scalar norm = Scalar(0);
+        for (uint8_t k = 0; k < n; k++) {
+            row[k] = (a.coord[k] - ref.coord[k]) * Scalar(2);
+            norm += a.coord[k] * a.coord[k];
+        }
+        Scalar b = ref.range * ref.range - a.range * a.range + norm - refNorm;
+        Scalar w = a.weight * ref.weight / (a.weight + ref.weight);
+        for (uint8_t r = 0; r < n; r++) {
+            Scalar wr = w * row[r];
+            for (uint8_t c = 0; c < n; c++) normal[r][c] += wr * row[c];
+            rhs[r] += wr * b;
+        }
+    }
+    if (!RYUW122SolveSymmetric(normal, rhs, n)) return false;
+    for (uint8_t k = 0; k < n; k++) p[k] = rhs[k];
+    return true;
+}
+
+/**
+ * @brief Weighted least squares position from count ranges (2D or 3D).
+ *
+ * The nodes are first moved to the origin of the first one and scaled by a power of two
+ * so that every coordinate and range is close to 1: this keeps the squares of the linear
+ * system in range for fixed point and costs nothing in float. The linearized solution (or
+ * the guess, when the geometry does not allow it) is then refined with damped Gauss-Newton
+ * iterations on the true range equations. All the work arrays are on the stack.
+ *
+ * @param nodes The nodes with a range; at most RYUW122_POSITIONING_MAX_ANCHORS are used.
+ * @param guess Previous position, or nullptr.
+ */
+template <typename Scalar>
+RYUW122MultilaterationResult<Scalar> RYUW122Multilaterate(const RYUW122MultilaterationNode<Scalar>* nodes,
+                                                          uint8_t count, uint8_t dimensions,
+                                                          const Scalar* guess) {
+    typedef RYUW122ScalarTraits<Scalar> Traits;
+    const uint8_t n = dimensions == 3 ? 3 : 2;
+
+    RYUW122MultilaterationResult<Scalar> result;
+    for (uint8_t k = 0; k < 3; k++) result.position[k] = Scalar(0);
+    result.residual = Scalar(0);
+    result.gdop = Scalar(0);
+
+    if (count > RYUW122_POSITIONING_MAX_ANCHORS) count = RYUW122_POSITIONING_MAX_ANCHORS;
+    if (count < n || (count == n && !guess)) {
+        result.status = RYUW122PositionStatus::NOT_ENOUGH_RANGES;
+        return result;
+    }
+
+    // Normalization: origin on the first node, scale = power of two above every extent
+    Scalar origin[3];
+    for (uint8_t k = 0; k < 3; k++) origin[k] = k < n ? nodes[0].coord[k] : Scalar(0);
+    Scalar extent = Scalar(0);
+    Scalar maxWeight = Scalar(0);
+    for (uint8_t i = 0; i < count; i++) {
+        for (uint8_t k = 0; k < n; k++) {
+            Scalar d = nodes[i].coord[k] - origin[k];
+            if (d < Scalar(0)) d = -d;
+            if (d > extent) extent = d;
+        }
+        if (nodes[i].range > extent) extent = nodes[i].range;
+        if (nodes[i].weight > maxWeight) maxWeight = nodes[i].weight;
+    }
+    Scalar scale = Scalar(1);
+    while (scale < extent) scale = scale * Scalar(2);
+    if (maxWeight <= Scalar(0)) maxWeight = Scalar(1);
+
+    Scalar inverseScale = Scalar(1) / scale;
+    Scalar inverseWeight = Scalar(1) / maxWeight;
+    // Zeroed: only the first count entries are used, which the compiler cannot tell
+    RYUW122MultilaterationNode<Scalar> local[RYUW122_POSITIONING_MAX_ANCHORS] = {};
+    for (uint8_t i = 0; i < count; i++) {
+        for (uint8_t k = 0; k < 3; k++) local[i].coord[k] = k < n ? (nodes[i].coord[k] - origin[k]) * inverseScale : Scalar(0);
+        local[i].range = nodes[i].range * inverseScale;
+        local[i].weight = nodes[i].weight * inverseWeight;
+    }
+
+    // Starting point: linearized solution, else the guess
+    Scalar p[3] = { Scalar(0), Scalar(0), Scalar(0) };
+    if (count <= n || !RYUW122LinearMultilateration(local, count, n, p)) {
+        if (guess) {
+            for (uint8_t k = 0; k < n; k++) p[k] = (guess[k] - origin[k]) * inverseScale;
+        } else if (n == 3 && RYUW122LinearMultilateration(local, count, 2, p)) {
+            // Nodes on one plane (typically all on the ceiling): the linear system has no height
+            // information, start 1 m below the plane and let the refinement find the height
+            Scalar height = Scalar(0);
+            for (uint8_t i = 0; i < count; i++) height += local[i].coord[2];
+            p[2] = height / Scalar((int)count) - inverseScale;
+        } else {
+            result.status = RYUW122PositionStatus::DEGENERATE_GEOMETRY;
+            return result;
+        }
+    }
+
+    // Damped Gauss-Newton on f_i(p) = |p - a_i| - r_i
+    Scalar tolerance = Traits::fromFloat(1e-4f) * inverseScale; // 0.1 mm
+    if (tolerance < Traits::resolution()) tolerance = Traits::resolution();
+    bool converged = false;
+    for (uint8_t iteration = 0; iteration < RYUW122_POSITIONING_MAX_ITERATIONS; iteration++) {
+        Scalar h[3][3];
+        Scalar g[3];
+        for (uint8_t r = 0; r < 3; r++) {
+            g[r] = Scalar(0);
+            for (uint8_t c = 0; c < 3; c++) h[r][c] = Scalar(0);
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            const RYUW122MultilaterationNode<Scalar>& a = local[i];
+            Scalar d[3];
+            Scalar dist = Scalar(0);
+            for (uint8_t k = 0; k < n; k++) {
+                d[k] = p[k] - a.coord[k];
+                dist += d[k] * d[k];
+            }
+            dist = Traits::sqrt(dist);
+            if (dist <= tolerance) continue; // on top of the node: no direction information
+            Scalar f = dist - a.range;
+            Scalar j[3];
+            Scalar inverse = Scalar(1) / dist;
+            for (uint8_t k = 0; k < n; k++) j[k] = d[k] * inverse;
+            for (uint8_t r = 0; r < n; r++) {
+                Scalar wj = a.weight * j[r];
+                for (uint8_t c = 0; c < n; c++) h[r][c] += wj * j[c];
+                g[r] -= wj * f;
+            }
+        }
+
+        Scalar damping = Scalar(0);
+        for (uint8_t k = 0; k < n; k++) damping += h[k][k];
+        damping = damping * Traits::fromFloat(1e-4f) / Scalar((int)n);
+        for (uint8_t k = 0; k < n; k++) h[k][k] += damping;
+
+        if (!RYUW122SolveSymmetric(h, g, n)) {
+            result.status = RYUW122PositionStatus::DEGENERATE_GEOMETRY;
+            return result;
+        }
+
+        bool small = true;
+        for (uint8_t k = 0; k < n; k++) {
+            p[k] += g[k];
+            if (g[k] > tolerance || g[k] < -tolerance) small = false;
+        }
+        if (small) {
+            converged = true;
+            break;
+        }
+    }
+
+    // Residual and GDOP at the solution
+    Scalar sumSquares = Scalar(0);
+    Scalar sumWeights = Scalar(0);
+    Scalar geometry[3][3];
+    for (uint8_t r = 0; r < 3; r++) {
+        for (uint8_t c = 0; c < 3; c++) geometry[r][c] = Scalar(0);
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        const RYUW122MultilaterationNode<Scalar>& a = local[i];
+        Scalar d[3];
+        Scalar dist = Scalar(0);
+        for (uint8_t k = 0; k < n; k++) {
+            d[k] = p[k] - a.coord[k];
+            dist += d[k] * d[k];
+        }
+        dist = Traits::sqrt(dist);
+        Scalar f = dist - a.range;
+        sumSquares += a.weight * f * f;
+        sumWeights += a.weight;
+        if (dist <= tolerance) continue;
+        Scalar j[3];
+        Scalar inverse = Scalar(1) / dist;
+        for (uint8_t k = 0; k < n; k++) j[k] = d[k] * inverse;
+        for (uint8_t r = 0; r < n; r++) {
+            for (uint8_t c = 0; c < n; c++) geometry[r][c] += j[r] * j[c];
+        }
+    }
+
+    // trace((G'G)^-1), one column of the inverse at a time
+    Scalar gdop = Scalar(0);
+    bool singular = false;
+    for (uint8_t k = 0; k < n && !singular; k++) {
+        Scalar column[3] = { Scalar(0), Scalar(0), Scalar(0) };
+        column[k] = Scalar(1);
+        Scalar factor[3][3];
+        for (uint8_t r = 0; r < 3; r++) {
+            for (uint8_t c = 0; c < 3; c++) factor[r][c] = geometry[r][c];
+        }
+        if (RYUW122SolveSymmetric(factor, column, n)) gdop += column[k];
+        else singular = true;
+    }
+
+    for (uint8_t k = 0; k < n; k++) result.position[k] = p[k] * scale + origin[k];
+    result.residual = sumWeights > Scalar(0) ? Traits::sqrt(sumSquares / sumWeights) * scale : Scalar(0);
+    result.gdop = singular ? Traits::infinity() : Traits::sqrt(gdop);
+    result.status = converged ? RYUW122PositionStatus::OK : RYUW122PositionStatus::NOT_CONVERGED;
+    return result;
+}
+
+#endif // RYUW122_MULTILATERATION_H
@@ -0,0 +1,317 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Compile-time payload schemas packing typed fields into the 12-byte RYUW122 data
+ */
+
+#ifndef RYUW122_PAYLOAD_H
+#define RYUW122_PAYLOAD_H
+
+#include "RYUW122.h"
+
+// Bits carried by a full payload: 6 per character (URL-safe base64 alphabet, no ',')
+#define RYUW122_PAYLOAD_BITS (RYUW122_MAX_PAYLOAD_LENGTH * 6)
+
+/**
+ * @class RYUW122PayloadBits
+ * @brief Bit stream behind the payload schemas: fields are packed MSB first, then
+ * written 6 bits per character with the alphabet A-Z a-z 0-9 - _.
+ *
+ * The alphabet has no ',', no space and no control character, so the data survives the
+ * AT+TAG_SEND / AT+ANCHOR_SEND commands and the +ANCHOR_RCV / +TAG_RCV frames untouched.
+ */
+class RYUW122PayloadBits {
+public:
+    RYUW122PayloadBits() : _position(0) { memset(_bytes, 0, sizeof(_bytes)); }
+
+    void write(uint32_t value, uint8_t bits) {
+        while (bits-- > 0) {
+            if (_position < RYUW122_PAYLOAD_BITS && ((value >> bits) & 1)) {
+                _bytes[_position >> 3] |= (uint8_t)(0x80 >> (_position & 7));
+            }
+            _position++;
+        }
+    }
+
+    // Bits past the end of the received characters read as 0
+    uint32_t read(uint8_t bits) {
+        uint32_t value = 0;
+        while (bits-- > 0) {
+            uint8_t bit = _position < RYUW122_PAYLOAD_BITS ? (_bytes[_position >> 3] >> (7 - (_position & 7))) & 1 : 0;
+            value = (value << 1) | bit;
+            _position++;
+        }
+        return value;
+    }
+
+    uint16_t getPosition() const { return _position; }
+
+    /**
+     * @brief Writes the bits written so far as characters (null terminated).
+     * @return The number of characters, the payload length.
+     */
+    uint8_t toChars(char* out) const {
+        uint8_t length = (uint8_t)((_position + 5) / 6);
+        if (length > RYUW122_MAX_PAYLOAD_LENGTH) length = RYUW122_MAX_PAYLOAD_LENGTH;
+        for (uint8_t i = 0; i < length; i++) {
+            uint8_t sextet = 0;
+            for (uint8_t b = 0; b < 6; b++) {
+                uint16_t position = i * 6 + b;
+                sextet = (uint8_t)((sextet << 1) | ((_bytes[position >> 3] >> (7 - (position & 7))) & 1));
+            }
+            out[i] = encodeChar(sextet);
+        }
+        out[length] = '\0';
+        return length;
+    }
+
+    /**
+     * @brief Loads received characters and rewinds the stream.
+     * @return False if the length is invalid or a character is out of the alphabet.
+     */
+    bool fromChars(const char* data, int length) {
+        memset(_bytes, 0, sizeof(_bytes));
+        _position = 0;
+        if (!data || length < 0 || length > RYUW122_MAX_PAYLOAD_LENGTH) return false;
+        for (int i = 0; i < length; i++) {
+            int sextet = decodeChar(data[i]);
+            if (sextet < 0) return false;
+            write((uint32_t)sextet, 6);
+        }
+        _position = 0;
+        return true;
+    }
+
+    static char encodeChar(uint8_t sextet) {
+        if (sextet < 26) return (char)('A' + sextet);
+        if (sextet < 52) return (char)('a' + sextet - 26);
+        if (sextet < 62) return (char)('0' + sextet - 52);
+        return sextet == 62 ? '-' : '_';
+    }
+
+    static int decodeChar(char c) {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '-') return 62;
+        if (c == '_') return 63;
+        return -1;
+    }
+
+private:
+    uint8_t _bytes[(RYUW122_PAYLOAD_BITS + 7) / 8];
+    uint16_t _position;
+};
+
+/**
+ * @brief Unsigned integer of Bits bits (1-32); larger values are saturated.
+ */
+template <uint8_t Bits>
+struct RYUW122UInt {
+    static_assert(Bits > 0 && Bits <= 32, "RYUW122UInt: Bits must be 1-32");
+    typedef uint32_t Type;
+    static const uint16_t MAX_BITS = Bits;
+    static const uint32_t MAX_VALUE = Bits == 32 ? 0xFFFFFFFFUL : ((uint32_t)1 << (Bits % 32)) - 1;
+
+    static void write(RYUW122PayloadBits& bits, Type value) {
+        if (value > MAX_VALUE) value = MAX_VALUE;
+        bits.write(value, Bits);
+    }
+    static Type read(RYUW122PayloadBits& bits) { return bits.read(Bits); }
+};
+
+/**
+ * @brief Signed integer of Bits bits (2-32, two's complement); out of range values are saturated.
+ */
+template <uint8_t Bits>
+struct RYUW122SInt {
+    static_assert(Bits > 1 && Bits <= 32, "RYUW122SInt: Bits must be 2-32");
+    typedef int32_t Type;
+    static const uint16_t MAX_BITS = Bits;
+    static const int32_t MAX_VALUE = (int32_t)(((uint32_t)1 << (Bits - 1)) - 1);
+    static const int32_t MIN_VALUE = -MAX_VALUE - 1;
+
+    static void write(RYUW122PayloadBits& bits, Type value) {
+        if (value > MAX_VALUE) value = MAX_VALUE;
+        if (value < MIN_VALUE) value = MIN_VALUE;
+        bits.write((uint32_t)value, Bits);
+    }
+    static Type read(RYUW122PayloadBits& bits) {
+        uint32_t raw = bits.read(Bits);
+        if (Bits < 32 && (raw & ((uint32_t)1 << (Bits - 1)))) raw |= ~(uint32_t)MAX_VALUE; // sign extension
+        return (int32_t)raw;
+    }
+};
+
+/**
+ * @brief Wrapping counter of Bits bits (1-32), for sequence numbers: only the low bits are sent.
+ */
+template <uint8_t Bits>
+struct RYUW122Counter {
+    static_assert(Bits > 0 && Bits <= 32, "RYUW122Counter: Bits must be 1-32");
+    typedef uint32_t Type;
+    static const uint16_t MAX_BITS = Bits;
+    static const uint32_t MASK = RYUW122UInt<Bits>::MAX_VALUE;
+
+    static void write(RYUW122PayloadBits& bits, Type value) { bits.write(value & MASK, Bits); }
+    static Type read(RYUW122PayloadBits& bits) { return bits.read(Bits); }
+
+    /**
+     * @brief Steps from older to newer across the wrap (1 = consecutive, more = lost frames).
+     */
+    static uint32_t distance(Type newer, Type older) { return (newer - older) & MASK; }
+};
+
+/**
+ * @brief Fixed-point value: value * Scale - Offset is sent as an unsigned Bits bits integer.
+ *
+ * The resolution is 1/Scale and the range Offset/Scale to (Offset + 2^Bits - 1)/Scale,
+ * saturated. E.g. a battery of 2.50 to 5.05 V at 10 mV is RYUW122Scaled<8, 100, 250>,
+ * an acceleration of -4 to +4 g at 1/64 g is RYUW122Scaled<9, 64, -256>.
+ */
+template <uint8_t Bits, int32_t Scale, int32_t Offset = 0>
+struct RYUW122Scaled {
+    static_assert(Bits > 0 && Bits <= 24, "RYUW122Scaled: Bits must be 1-24 (float precision)");
+    static_assert(Scale > 0, "RYUW122Scaled: Scale must be positive");
+    typedef float Type;
+    static const uint16_t MAX_BITS = Bits;
+
+    static void write(RYUW122PayloadBits& bits, Type value) {
+        float raw = value * Scale - Offset;
+        uint32_t max = RYUW122UInt<Bits>::MAX_VALUE;
+        uint32_t scaled = raw <= 0.0f ? 0 : raw >= (float)max ? max : (uint32_t)(raw + 0.5f);
+        bits.write(scaled, Bits);
+    }
+    static Type read(RYUW122PayloadBits& bits) { return ((float)bits.read(Bits) + Offset) / Scale; }
+};
+
+/**
+ * @brief Boolean flag, one bit.
+ */
+struct RYUW122Flag {
+    typedef bool Type;
+    static const uint16_t MAX_BITS = 1;
+
+    static void write(RYUW122PayloadBits& bits, Type value) { bits.write(value ? 1 : 0, 1); }
+    static Type read(RYUW122PayloadBits& bits) { return bits.read(1) != 0; }
+};
+
+/**
+ * @brief Variable length unsigned integer: groups of Chunk bits, each preceded by a continuation bit.
+ *
+ * Small values take one group (e.g. 0-15 in 5 bits with the default Chunk of 4), up to
+ * MaxChunks groups; larger values are saturated. The schema reserves the worst case, but the
+ * payload is only as long as the bits actually written: put it last to shorten the frame.
+ */
+template <uint8_t Chunk = 4, uint8_t MaxChunks = 4>
+struct RYUW122VarUInt {
+    static_assert(Chunk > 0 && MaxChunks > 0 && Chunk * MaxChunks <= 32, "RYUW122VarUInt: Chunk * MaxChunks must be 1-32");
+    typedef uint32_t Type;
+    static const uint16_t MAX_BITS = (Chunk + 1) * MaxChunks;
+
+    static void write(RYUW122PayloadBits& bits, Type value) {
+        uint32_t max = RYUW122UInt<Chunk * MaxChunks>::MAX_VALUE;
+        if (value > max) value = max;
+        for (uint8_t i = 0; i < MaxChunks; i++) {
+            uint32_t rest = Chunk * (i + 1) < 32 ? value >> (Chunk * (i + 1)) : 0;
+            bool more = rest != 0 && i + 1 < MaxChunks;
+            bits.write(more ? 1 : 0, 1);
+            bits.write((value >> (Chunk * i)) & RYUW122UInt<Chunk>::MAX_VALUE, Chunk);
+            if (!more) return;
+        }
+    }
+    static Type read(RYUW122PayloadBits& bits) {
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < MaxChunks; i++) {
+            bool more = bits.read(1) != 0;
+            value |= bits.read(Chunk) << (Chunk * i);
+            if (!more) break;
+        }
+        return value;
+    }
+};
+
+/**
+ * @class RYUW122PayloadSchema
+ * @brief A payload layout made of typed fields, checked at compile time against the 72 bits
+ * (12 characters) of a RYUW122 payload.
+ *
+ * A TAG packs sequence number, battery and IMU data in the data it attaches to every ranging
+ * reply, and the ANCHOR gets them with the distance, with no extra exchange:
+ *
+ * @code
+ * typedef RYUW122PayloadSchema<
+ *     RYUW122Counter<8>,                 // sequence number
+ *     RYUW122Scaled<8, 100, 250>,        // battery, 2.50-5.05 V at 10 mV
+ *     RYUW122Scaled<9, 64, -256>,        // acceleration X, -4..+4 g
+ *     RYUW122Scaled<9, 64, -256>,        // acceleration Y
+ *     RYUW122Scaled<9, 64, -256>,        // acceleration Z
+ *     RYUW122Flag                        // moving
+ * > Telemetry;                           // 44 bits: 8 characters
+ *
+ * // TAG
+ * char data[Telemetry::LENGTH + 1];
+ * uint8_t length = Telemetry::encode(data, sequence++, battery, ax, ay, az, moving);
+ * uwb.tagSendData(length, data);
+ *
+ * // ANCHOR, e.g. in a range listener or a transaction callback
+ * uint32_t sequence; float battery, ax, ay, az; bool moving;
+ * if (Telemetry::decode(frame.data, frame.payloadLength, sequence, battery, ax, ay, az, moving)) { ... }
+ * @endcode
+ *
+ * The values are passed in field order, with the Type of each field (uint32_t, int32_t, float or bool).
+ */
+template <typename... Fields>
+struct RYUW122PayloadSchema;
+
+template <>
+struct RYUW122PayloadSchema<> {
+    static const uint16_t BITS = 0;
+    static void pack(RYUW122PayloadBits&) {}
+    static void unpack(RYUW122PayloadBits&) {}
+};
+
+template <typename Field, typename... Rest>
+struct RYUW122PayloadSchema<Field, Rest...> {
+    typedef RYUW122PayloadSchema<Rest...> Tail;
+
+    /// Worst-case size of the fields in bits
+    static const uint16_t BITS = Field::MAX_BITS + Tail::BITS;
+    /// Worst-case payload length in characters
+    static const uint8_t LENGTH = (BITS + 5) / 6;
+    static_assert(BITS <= RYUW122_PAYLOAD_BITS, "Payload schema larger than the 12 characters of a RYUW122 payload");
+
+    /**
+     * @brief Packs the values into out (at least LENGTH + 1 characters, null terminated).
+     * @return The payload length to send.
+     */
+    static uint8_t encode(char* out, typename Field::Type value, typename Rest::Type... rest) {
+        RYUW122PayloadBits bits;
+        pack(bits, value, rest...);
+        return bits.toChars(out);
+    }
+
+    /**
+     * @brief Unpacks a received payload into the values.
+     * @return False if the data is not a payload of this schema (bad character or too short).
+     */
+    static bool decode(const char* data, int length, typename Field::Type& value, typename Rest::Type&... rest) {
+        RYUW122PayloadBits bits;
+        if (!bits.fromChars(data, length)) return false;
+        unpack(bits, value, rest...);
+        return bits.getPosition() <= length * 6;
+    }
+
+    static void pack(RYUW122PayloadBits& bits, typename Field::Type value, typename Rest::Type... rest) {
+        Field::write(bits, value);
+        Tail::pack(bits, rest...);
+    }
+
+    static void unpack(RYUW122PayloadBits& bits, typename Field::Type& value, typename Rest::Type&... rest) {
+        value = Field::read(bits);
+        Tail::unpack(bits, rest...);
+    }
+};
+
+#endif // RYUW122_PAYLOAD_H
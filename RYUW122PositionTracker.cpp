@@ -0,0 +1,225 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Constant-velocity EKF position tracker implementation
+ */
+
+#include "RYUW122PositionTracker.h"
+
+#include <math.h>
+
+// Ranges older than this are not used for the first fix
+#define RYUW122_TRACKER_INIT_AGE 500000UL // us
+// Consecutive rejected ranges after which the track is considered lost
+#define RYUW122_TRACKER_MAX_REJECTS 8
+
+RYUW122PositionTracker::RYUW122PositionTracker(uint8_t dimensions) : _dimensions(dimensions == 3 ? 3 : 2) {
+    reset();
+}
+
+int RYUW122PositionTracker::addAnchor(const char* address, float x, float y, float z) {
+    if (!address || strlen(address) != 8) {
+        DEBUG_PRINTLN(F("Error: Anchor Address must be 8 bytes ASCII"));
+        return -1;
+    }
+    int index = getAnchorIndex(address);
+    if (index < 0) {
+        if (_anchorCount >= RYUW122_POSITIONING_MAX_ANCHORS) {
+            DEBUG_PRINTLN(F("Error: Tracker anchor set is full"));
+            return -1;
+        }
+        index = _anchorCount++;
+        strcpy(_anchors[index].address, address);
+    }
+
+    Anchor& anchor = _anchors[index];
+    anchor.coord[0] = x;
+    anchor.coord[1] = y;
+    anchor.coord[2] = _dimensions == 3 ? z : 0.0f;
+    anchor.range = -1.0f;
+    anchor.rangeTime = 0;
+    return index;
+}
+
+bool RYUW122PositionTracker::removeAnchor(const char* address) {
+    int index = getAnchorIndex(address);
+    if (index < 0) return false;
+    for (uint8_t i = index; i + 1 < _anchorCount; i++) {
+        _anchors[i] = _anchors[i + 1];
+    }
+    _anchorCount--;
+    return true;
+}
+
+void RYUW122PositionTracker::clearAnchors() {
+    _anchorCount = 0;
+    reset();
+}
+
+int RYUW122PositionTracker::getAnchorIndex(const char* address) const {
+    if (!address) return -1;
+    for (uint8_t i = 0; i < _anchorCount; i++) {
+        if (strcmp(_anchors[i].address, address) == 0) return i;
+    }
+    return -1;
+}
+
+void RYUW122PositionTracker::onUpdate(TrackUpdateCallback callback, void* context) {
+    _updateCallback = callback;
+    _updateContext = context;
+}
+
+void RYUW122PositionTracker::reset() {
+    _tracking = false;
+    _consecutiveRejects = 0;
+    for (uint8_t i = 0; i < MAX_STATE; i++) {
+        _state[i] = 0.0f;
+        for (uint8_t j = 0; j < MAX_STATE; j++) _covariance[i][j] = 0.0f;
+    }
+}
+
+void RYUW122PositionTracker::onRange(const RYUW122Frame& frame, unsigned long timestampUs) {
+    updateRange(frame.tagAddress, frame.distance / 100.0f, timestampUs);
+}
+
+bool RYUW122PositionTracker::initialize(unsigned long timestampUs) {
+    RYUW122MultilaterationNode<float> nodes[RYUW122_POSITIONING_MAX_ANCHORS];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < _anchorCount; i++) {
+        const Anchor& anchor = _anchors[i];
+        if (anchor.range < 0.0f || (timestampUs - anchor.rangeTime) > RYUW122_TRACKER_INIT_AGE) continue;
+        for (uint8_t k = 0; k < 3; k++) nodes[count].coord[k] = anchor.coord[k];
+        nodes[count].range = anchor.range;
+        nodes[count].weight = 1.0f;
+        count++;
+    }
+
+    RYUW122MultilaterationResult<float> fix = RYUW122Multilaterate(nodes, count, _dimensions, (const float*)nullptr);
+    if (fix.status != RYUW122PositionStatus::OK) return false;
+
+    const uint8_t d = _dimensions;
+    reset();
+    // The ranges of the fix span up to RYUW122_TRACKER_INIT_AGE: start with a generous uncertainty
+    float positionVariance = fix.residual * fix.residual + 4.0f * _rangeVariance;
+    for (uint8_t k = 0; k < d; k++) {
+        _state[k] = fix.position[k];
+        _covariance[k][k] = positionVariance;
+        _covariance[d + k][d + k] = 1.0f; // 1 m/s
+    }
+    _stateTime = timestampUs;
+    _tracking = true;
+    return true;
+}
+
+/**
+ * P = F P F' + Q with F = [I dt*I; 0 I], Q the white acceleration noise of each axis.
+ * With P = [A B; B' C] (position, velocity blocks): A += dt (B + B') + dt^2 C, B += dt C.
+ */
+void RYUW122PositionTracker::propagate(float dt) {
+    const uint8_t d = _dimensions;
+    for (uint8_t k = 0; k < d; k++) _state[k] += _state[d + k] * dt;
+
+    for (uint8_t i = 0; i < d; i++) {
+        for (uint8_t j = 0; j < d; j++) {
+            _covariance[i][j] += dt * (_covariance[i][d + j] + _covariance[d + i][j]) + dt * dt * _covariance[d + i][d + j];
+        }
+    }
+    for (uint8_t i = 0; i < d; i++) {
+        for (uint8_t j = 0; j < d; j++) {
+            _covariance[i][d + j] += dt * _covariance[d + i][d + j];
+            _covariance[d + j][i] = _covariance[i][d + j];
+        }
+    }
+
+    float dt2 = dt * dt;
+    for (uint8_t k = 0; k < d; k++) {
+        _covariance[k][k] += _accelerationVariance * dt2 * dt2 / 4.0f;
+        _covariance[k][d + k] += _accelerationVariance * dt2 * dt / 2.0f;
+        _covariance[d + k][k] += _accelerationVariance * dt2 * dt / 2.0f;
+        _covariance[d + k][d + k] += _accelerationVariance * dt2;
+    }
+}
+
+bool RYUW122PositionTracker::updateRange(const char* address, float distance, unsigned long timestampUs) {
+    int index = getAnchorIndex(address);
+    if (index < 0 || distance < 0.0f) return false;
+    Anchor& anchor = _anchors[index];
+    anchor.range = distance;
+    anchor.rangeTime = timestampUs;
+
+    if (_tracking && (timestampUs - _stateTime) > _maxGapUs) _tracking = false;
+    if (!_tracking) {
+        // The first fix already includes this range
+        if (!initialize(timestampUs)) return false;
+        _updateCount++;
+        if (_updateCallback) _updateCallback(getState(), _updateContext);
+        return true;
+    }
+    propagate((float)(timestampUs - _stateTime) / 1e6f);
+    _stateTime = timestampUs;
+
+    // Scalar measurement h(x) = |p - a|, H = [u 0] with u the unit vector from the node
+    const uint8_t d = _dimensions;
+    const uint8_t n = 2 * d;
+    float u[3];
+    float predicted = 0.0f;
+    for (uint8_t k = 0; k < d; k++) {
+        u[k] = _state[k] - anchor.coord[k];
+        predicted += u[k] * u[k];
+    }
+    predicted = sqrtf(predicted);
+    if (predicted < 1e-3f) return false; // on top of the node: no direction information
+    for (uint8_t k = 0; k < d; k++) u[k] /= predicted;
+
+    float ph[MAX_STATE] = { 0.0f }; // P H'
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t k = 0; k < d; k++) ph[i] += _covariance[i][k] * u[k];
+    }
+    float innovationVariance = _rangeVariance;
+    for (uint8_t k = 0; k < d; k++) innovationVariance += u[k] * ph[k];
+
+    float innovation = distance - predicted;
+    if (_gate > 0.0f && innovation * innovation > _gate * _gate * innovationVariance) {
+        _rejectedCount++;
+        if (++_consecutiveRejects >= RYUW122_TRACKER_MAX_REJECTS) _tracking = false;
+        return false;
+    }
+    _consecutiveRejects = 0;
+
+    // x += K y, P -= K H P with K = P H' / S
+    for (uint8_t i = 0; i < n; i++) _state[i] += ph[i] * innovation / innovationVariance;
+    for (uint8_t i = 0; i < n; i++) {
+        for (uint8_t j = 0; j < n; j++) _covariance[i][j] -= ph[i] * ph[j] / innovationVariance;
+    }
+
+    _updateCount++;
+    if (_updateCallback) _updateCallback(getState(), _updateContext);
+    return true;
+}
+
+RYUW122TrackState RYUW122PositionTracker::stateAt(unsigned long timestampUs) const {
+    const uint8_t d = _dimensions;
+    RYUW122TrackState state = {};
+    state.valid = _tracking;
+    state.timestamp = timestampUs;
+    if (!_tracking) return state;
+
+    float dt = (float)(long)(timestampUs - _stateTime) / 1e6f;
+    float position[3] = { 0.0f, 0.0f, 0.0f };
+    float velocity[3] = { 0.0f, 0.0f, 0.0f };
+    float variance = 0.0f;
+    for (uint8_t k = 0; k < d; k++) {
+        velocity[k] = _state[d + k];
+        position[k] = _state[k] + velocity[k] * dt;
+        variance += _covariance[k][k] + 2.0f * dt * _covariance[k][d + k] + dt * dt * _covariance[d + k][d + k];
+    }
+    state.x = position[0];
+    state.y = position[1];
+    state.z = position[2];
+    state.vx = velocity[0];
+    state.vy = velocity[1];
+    state.vz = velocity[2];
+    state.accuracy = sqrtf(variance > 0.0f ? variance : 0.0f);
+    return state;
+}
@@ -0,0 +1,164 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Constant-velocity EKF position tracker fed by single ranges
+ */
+
+#ifndef RYUW122_POSITION_TRACKER_H
+#define RYUW122_POSITION_TRACKER_H
+
+#include "RYUW122.h"
+#include "RYUW122Multilateration.h"
+
+/**
+ * @struct RYUW122TrackState
+ * @brief Position and velocity estimated by the tracker, in meters and m/s.
+ */
+struct RYUW122TrackState {
+    float x, y, z;            ///< z is 0 in 2D
+    float vx, vy, vz;
+    float accuracy;           ///< Standard deviation of the position error (m), from the covariance
+    bool valid;               ///< False until the tracker has its first fix
+    unsigned long timestamp;  ///< micros() the state refers to
+};
+
+// Called after each range accepted by the tracker
+typedef void (*TrackUpdateCallback)(const RYUW122TrackState& state, void* context);
+
+/**
+ * @class RYUW122PositionTracker
+ * @brief Extended Kalman filter tracking position and velocity from individual ranges.
+ *
+ * A snapshot solver (RYUW122Positioning) needs a full set of ranges, which with round-robin
+ * polling are never taken at the same instant. The tracker instead predicts the state to
+ * the arrival time of each +ANCHOR_RCV with a constant-velocity model and corrects it with
+ * that single range, so the position updates at the full ranging rate and motion between
+ * ranges is accounted for. Each update is a scalar measurement: no matrix inversion.
+ *
+ * The first fix comes from the multilateration of the latest ranges; a gap longer than
+ * setMaxGap() or too many consecutive rejected ranges start over from a new fix. Ranges
+ * whose innovation exceeds the gate (default 4 sigma) are rejected as outliers.
+ *
+ * @code
+ * RYUW122PositionTracker tracker;                 // 2D
+ * tracker.addAnchor("T1T1T1T1", 0.0, 0.0);
+ * tracker.addAnchor("T2T2T2T2", 5.3, 0.0);
+ * tracker.addAnchor("T3T3T3T3", 5.3, 3.65);
+ * uwb.addRangeListener(&tracker);
+ * ...
+ * RYUW122TrackState now = tracker.predict(micros()); // e.g. at the display refresh rate
+ * @endcode
+ */
+class RYUW122PositionTracker : public RYUW122RangeListener {
+public:
+    /**
+     * @brief Constructor.
+     * @param dimensions 2 (x, y) or 3 (x, y, z).
+     */
+    explicit RYUW122PositionTracker(uint8_t dimensions = 2);
+
+    /**
+     * @brief Adds a reference node.
+     * @return The index of the node, or -1 if the address is invalid or the tracker is full.
+     */
+    int addAnchor(const char* address, float x, float y, float z = 0.0f);
+    bool removeAnchor(const char* address);
+    void clearAnchors();
+
+    uint8_t getAnchorCount() const { return _anchorCount; }
+    int getAnchorIndex(const char* address) const;
+
+    /**
+     * @brief Standard deviation of a range measurement (default 0.1 m).
+     */
+    void setRangeStdDev(float stdDev) { _rangeVariance = stdDev * stdDev; }
+
+    /**
+     * @brief Standard deviation of the acceleration of the target (default 1 m/s^2).
+     * Higher values follow manoeuvres faster, lower values smooth more.
+     */
+    void setAccelerationNoise(float stdDev) { _accelerationVariance = stdDev * stdDev; }
+
+    /**
+     * @brief Innovation gate in standard deviations (default 4, 0 disables the rejection).
+     */
+    void setGate(float sigmas) { _gate = sigmas; }
+
+    /**
+     * @brief Longest time without accepted ranges before the track is dropped (default 2000 ms).
+     */
+    void setMaxGap(unsigned long maxGap) { _maxGapUs = maxGap * 1000UL; }
+
+    /**
+     * @brief Feeds a range by hand.
+     * @param distance The distance in meters.
+     * @param timestampUs micros() of the measurement.
+     * @return True if the range updated the state.
+     */
+    bool updateRange(const char* address, float distance, unsigned long timestampUs);
+
+    void onRange(const RYUW122Frame& frame, unsigned long timestampUs) override;
+
+    /**
+     * @brief Registers the callback invoked after each accepted range.
+     */
+    void onUpdate(TrackUpdateCallback callback, void* context = nullptr);
+
+    bool isTracking() const { return _tracking; }
+
+    /**
+     * @brief The state at the last accepted range.
+     */
+    RYUW122TrackState getState() const { return stateAt(_stateTime); }
+
+    /**
+     * @brief The state extrapolated to the given micros(), without changing the filter.
+     */
+    RYUW122TrackState predict(unsigned long timestampUs) const { return stateAt(timestampUs); }
+
+    /**
+     * @brief Drops the track; the next ranges start from a new fix.
+     */
+    void reset();
+
+    unsigned long getUpdateCount() const { return _updateCount; }
+    unsigned long getRejectedCount() const { return _rejectedCount; }
+
+private:
+    static const uint8_t MAX_STATE = 6;
+
+    struct Anchor {
+        char address[9];
+        float coord[3];
+        float range;              // meters, < 0 if none
+        unsigned long rangeTime;  // micros()
+    };
+
+    bool initialize(unsigned long timestampUs);
+    void propagate(float dt);
+    RYUW122TrackState stateAt(unsigned long timestampUs) const;
+
+    uint8_t _dimensions;
+    Anchor _anchors[RYUW122_POSITIONING_MAX_ANCHORS];
+    uint8_t _anchorCount = 0;
+
+    float _rangeVariance = 0.01f;
+    float _accelerationVariance = 1.0f;
+    float _gate = 4.0f;
+    unsigned long _maxGapUs = 2000000UL;
+
+    bool _tracking = false;
+    float _state[MAX_STATE];              // positions, then velocities
+    float _covariance[MAX_STATE][MAX_STATE];
+    unsigned long _stateTime = 0;         // micros()
+    uint8_t _consecutiveRejects = 0;
+
+    unsigned long _updateCount = 0;
+    unsigned long _rejectedCount = 0;
+
+    TrackUpdateCallback _updateCallback = nullptr;
+    void* _updateContext = nullptr;
+};
+
+#endif // RYUW122_POSITION_TRACKER_H
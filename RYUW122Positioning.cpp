@@ -0,0 +1,131 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * N-anchor least-squares multilateration implementation
+ */
+
+#include "RYUW122Positioning.h"
+
+RYUW122Positioning::RYUW122Positioning(uint8_t dimensions) : _dimensions(dimensions == 3 ? 3 : 2) {}
+
+int RYUW122Positioning::addAnchor(const char* address, float x, float y, float z) {
+    if (!address || strlen(address) != 8) {
+        DEBUG_PRINTLN(F("Error: Anchor Address must be 8 bytes ASCII"));
+        return -1;
+    }
+    int index = getAnchorIndex(address);
+    if (index < 0) {
+        if (_anchorCount >= RYUW122_POSITIONING_MAX_ANCHORS) {
+            DEBUG_PRINTLN(F("Error: Positioning anchor set is full"));
+            return -1;
+        }
+        index = _anchorCount++;
+        strcpy(_anchors[index].address, address);
+        _anchors[index].weight = Scalar(100); // 0.1 m standard deviation
+    }
+
+    Anchor& anchor = _anchors[index];
+    anchor.coord[0] = Traits::fromFloat(x);
+    anchor.coord[1] = Traits::fromFloat(y);
+    anchor.coord[2] = Traits::fromFloat(_dimensions == 3 ? z : 0.0f);
+    anchor.range = Scalar(-1);
+    anchor.rangeTime = 0;
+    return index;
+}
+
+bool RYUW122Positioning::removeAnchor(const char* address) {
+    int index = getAnchorIndex(address);
+    if (index < 0) return false;
+    for (uint8_t i = index; i + 1 < _anchorCount; i++) {
+        _anchors[i] = _anchors[i + 1];
+    }
+    _anchorCount--;
+    return true;
+}
+
+void RYUW122Positioning::clearAnchors() {
+    _anchorCount = 0;
+    _havePrevious = false;
+}
+
+int RYUW122Positioning::getAnchorIndex(const char* address) const {
+    if (!address) return -1;
+    for (uint8_t i = 0; i < _anchorCount; i++) {
+        if (strcmp(_anchors[i].address, address) == 0) return i;
+    }
+    return -1;
+}
+
+const char* RYUW122Positioning::getAnchorAddress(uint8_t index) const {
+    return index < _anchorCount ? _anchors[index].address : "";
+}
+
+void RYUW122Positioning::setAnchorStdDev(uint8_t index, float stdDev) {
+    if (index >= _anchorCount) return;
+    if (stdDev < 0.01f) stdDev = 0.01f;
+    if (stdDev > 100.0f) stdDev = 100.0f;
+    _anchors[index].weight = Traits::fromFloat(1.0f / (stdDev * stdDev));
+}
+
+int RYUW122Positioning::storeRange(const char* address, Scalar distance) {
+    int index = getAnchorIndex(address);
+    if (index < 0) return -1;
+    _anchors[index].range = distance;
+    _anchors[index].rangeTime = millis();
+    return index;
+}
+
+bool RYUW122Positioning::setRange(const char* address, float distance) {
+    return storeRange(address, Traits::fromFloat(distance)) >= 0;
+}
+
+void RYUW122Positioning::clearRanges() {
+    for (uint8_t i = 0; i < _anchorCount; i++) _anchors[i].range = Scalar(-1);
+}
+
+void RYUW122Positioning::onRange(const RYUW122Frame& frame, unsigned long timestampUs) {
+    (void)timestampUs;
+    if (storeRange(frame.tagAddress, Traits::fromRatio(frame.distance, 100)) < 0) return;
+    if (_positionCallback && solve()) _positionCallback(_position, _positionContext);
+}
+
+void RYUW122Positioning::onPosition(PositionCallback callback, void* context) {
+    _positionCallback = callback;
+    _positionContext = context;
+}
+
+bool RYUW122Positioning::solve() {
+    unsigned long now = millis();
+
+    RYUW122MultilaterationNode<Scalar> nodes[RYUW122_POSITIONING_MAX_ANCHORS];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < _anchorCount; i++) {
+        const Anchor& anchor = _anchors[i];
+        if (anchor.range < Scalar(0) || (now - anchor.rangeTime) > _maxRangeAge) continue;
+        for (uint8_t k = 0; k < 3; k++) nodes[count].coord[k] = anchor.coord[k];
+        nodes[count].range = anchor.range;
+        nodes[count].weight = anchor.weight;
+        count++;
+    }
+
+    RYUW122MultilaterationResult<Scalar> result =
+        RYUW122Multilaterate(nodes, count, _dimensions, _havePrevious ? _previous : nullptr);
+
+    _position.status = result.status;
+    _position.anchorsUsed = count;
+    _position.timestamp = now;
+    _position.valid = result.status == RYUW122PositionStatus::OK;
+    if (result.status == RYUW122PositionStatus::OK || result.status == RYUW122PositionStatus::NOT_CONVERGED) {
+        _position.x = Traits::toFloat(result.position[0]);
+        _position.y = Traits::toFloat(result.position[1]);
+        _position.z = _dimensions == 3 ? Traits::toFloat(result.position[2]) : 0.0f;
+        _position.residual = Traits::toFloat(result.residual);
+        _position.gdop = Traits::toFloat(result.gdop);
+    }
+    if (!_position.valid) return false;
+
+    for (uint8_t k = 0; k < 3; k++) _previous[k] = result.position[k];
+    _havePrevious = true;
+    return true;
+}
@@ -0,0 +1,177 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * N-anchor least-squares multilateration for the RYUW122 library
+ */
+
+#ifndef RYUW122_POSITIONING_H
+#define RYUW122_POSITIONING_H
+
+#include "RYUW122.h"
+
+#include "RYUW122Multilateration.h"
+
+// Number type of the solver: Q16.16 fixed point on the FPU-less AVR boards, float elsewhere
+#ifndef RYUW122_POSITIONING_FIXED_POINT
+    #if defined(ARDUINO_ARCH_AVR)
+        #define RYUW122_POSITIONING_FIXED_POINT 1
+    #else
+        #define RYUW122_POSITIONING_FIXED_POINT 0
+    #endif
+#endif
+
+#if RYUW122_POSITIONING_FIXED_POINT
+typedef RYUW122Fixed RYUW122PositioningScalar;
+#else
+typedef float RYUW122PositioningScalar;
+#endif
+
+/**
+ * @struct RYUW122Position
+ * @brief A solved position, in the same unit as the reference node coordinates (meters).
+ */
+struct RYUW122Position {
+    float x;
+    float y;
+    float z;                 ///< 0 in 2D
+    float residual;          ///< Weighted RMS of the range residuals, in meters
+    float gdop;              ///< Geometric dilution of precision of the nodes used
+    uint8_t anchorsUsed;     ///< Ranges that took part in the solution
+    bool valid;
+    RYUW122PositionStatus status;
+    unsigned long timestamp; ///< millis() of the solve
+};
+
+// Called after each successful automatic solve (see RYUW122Positioning::onPosition)
+typedef void (*PositionCallback)(const RYUW122Position& position, void* context);
+
+/**
+ * @class RYUW122Positioning
+ * @brief Solves a 2D or 3D position from the ranges to N reference nodes of known position.
+ *
+ * The solver starts from the closed-form linearized weighted least squares solution (or from
+ * the previous position when the geometry does not allow it) and refines it with damped
+ * Gauss-Newton iterations on the true range equations, so any number of nodes contributes
+ * and near-collinear layouts degrade gracefully instead of failing. It reports the residual
+ * and the GDOP of the solution. All the work arrays are fixed size; there is no heap use.
+ * The arithmetic is RYUW122PositioningScalar: Q16.16 fixed point when
+ * RYUW122_POSITIONING_FIXED_POINT is 1 (the default on AVR), float otherwise; ranges from
+ * the driver are converted from cm without floating point.
+ * In 3D, when the nodes lie on one plane (e.g. all on the ceiling), the first solution is
+ * searched below that plane.
+ *
+ * In this library the reference nodes are the devices polled by the ANCHOR (addressed as
+ * TAGs by AT+ANCHOR_SEND). Registered as a range listener, the solver takes their ranges
+ * straight from the driver; with a PositionCallback it solves again after each new range.
+ *
+ * @code
+ * RYUW122Positioning positioning;              // 2D
+ * positioning.addAnchor("T1T1T1T1", 0.0, 0.0);
+ * positioning.addAnchor("T2T2T2T2", 5.3, 0.0);
+ * positioning.addAnchor("T3T3T3T3", 5.3, 3.65);
+ * positioning.addAnchor("T4T4T4T4", 0.0, 3.65);
+ * uwb.addRangeListener(&positioning);
+ * ...
+ * if (positioning.solve()) {
+ *     const RYUW122Position& p = positioning.getPosition();
+ * }
+ * @endcode
+ */
+class RYUW122Positioning : public RYUW122RangeListener {
+public:
+    /**
+     * @brief Constructor.
+     * @param dimensions 2 (x, y) or 3 (x, y, z).
+     */
+    explicit RYUW122Positioning(uint8_t dimensions = 2);
+
+    /**
+     * @brief Adds a reference node.
+     * @param address The address of the node (8 bytes ASCII), as reported in +ANCHOR_RCV.
+     * @return The index of the node, or -1 if the address is invalid or the solver is full.
+     */
+    int addAnchor(const char* address, float x, float y, float z = 0.0f);
+
+    /**
+     * @brief Removes a reference node (the indexes of the following nodes shift down).
+     */
+    bool removeAnchor(const char* address);
+    void clearAnchors();
+
+    uint8_t getAnchorCount() const { return _anchorCount; }
+    int getAnchorIndex(const char* address) const;
+    const char* getAnchorAddress(uint8_t index) const;
+
+    /**
+     * @brief Sets the standard deviation of the ranges of a node (default 0.1 m, 0.01-100 m).
+     * Ranges are weighted by the inverse of their variance.
+     */
+    void setAnchorStdDev(uint8_t index, float stdDev);
+
+    /**
+     * @brief Sets how long a range stays usable (default 1000 ms).
+     * With round-robin polling the ranges of a solution are never simultaneous: a short
+     * age limits the error of a moving TAG, a long one keeps solving when nodes drop out.
+     */
+    void setMaxRangeAge(unsigned long maxAge) { _maxRangeAge = maxAge; }
+
+    /**
+     * @brief Sets a range by hand, e.g. after filtering it.
+     * @param distance The distance in meters.
+     * @return False if the address is not a reference node.
+     */
+    bool setRange(const char* address, float distance);
+
+    /**
+     * @brief Forgets all the ranges.
+     */
+    void clearRanges();
+
+    void onRange(const RYUW122Frame& frame, unsigned long timestampUs) override;
+
+    /**
+     * @brief Solves the position from the fresh ranges.
+     * @return True if the position is valid; see getPosition().status otherwise.
+     */
+    bool solve();
+
+    /**
+     * @brief The last solution (also when it failed, with valid = false).
+     */
+    const RYUW122Position& getPosition() const { return _position; }
+
+    /**
+     * @brief Solves automatically after every range received from the driver and calls
+     * the callback with each valid position.
+     */
+    void onPosition(PositionCallback callback, void* context = nullptr);
+
+private:
+    typedef RYUW122PositioningScalar Scalar;
+    typedef RYUW122ScalarTraits<Scalar> Traits;
+
+    struct Anchor {
+        char address[9];
+        Scalar coord[3];
+        Scalar weight;             // 1 / variance
+        Scalar range;              // meters, < 0 if none
+        unsigned long rangeTime;   // millis()
+    };
+
+    int storeRange(const char* address, Scalar distance);
+
+    uint8_t _dimensions;
+    Anchor _anchors[RYUW122_POSITIONING_MAX_ANCHORS];
+    uint8_t _anchorCount = 0;
+    unsigned long _maxRangeAge = 1000;
+
+    RYUW122Position _position = {};
+    bool _havePrevious = false;
+    Scalar _previous[3];
+
+    PositionCallback _positionCallback = nullptr;
+    void* _positionContext = nullptr;
+};
+
+#endif // RYUW122_POSITIONING_H
@@ -0,0 +1,144 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Fixed-capacity per-TAG ranging history for the RYUW122 library
+ */
+
+#ifndef RYUW122_RANGE_HISTORY_H
+#define RYUW122_RANGE_HISTORY_H
+
+#include "RYUW122.h"
+
+/**
+ * @class RYUW122RangeHistory
+ * @brief The last Depth measurements of up to MaxTags TAGs, without heap allocation.
+ *
+ * Each TAG has its own ring in structure-of-arrays layout (distance, RSSI, arrival time in
+ * micros, payload length), so a filter or a solver can walk one field of a window without
+ * copying. Registered as a range listener, the history is filled by the driver with every
+ * +ANCHOR_RCV, whether it answers anchorSendDataSync(), an asynchronous transaction or the
+ * ranging scheduler. TAGs are added on their first measurement, or up front with addTag().
+ *
+ * @code
+ * RYUW122RangeHistory<3, 8> history;
+ * uwb.addRangeListener(&history);
+ * ...
+ * int8_t tag = history.getTagIndex("T1T1T1T1");
+ * for (uint8_t age = 0; age < history.getCount(tag); age++) {
+ *     int16_t cm = history.getDistance(tag, age); // age 0 = newest
+ * }
+ * @endcode
+ *
+ * @tparam MaxTags Number of TAGs tracked (1-127).
+ * @tparam Depth Measurements kept per TAG (1-255); a power of two makes the ring indexing cheaper.
+ */
+template <uint8_t MaxTags, uint8_t Depth>
+class RYUW122RangeHistory : public RYUW122RangeListener {
+    static_assert(MaxTags > 0 && MaxTags <= 127, "MaxTags must be 1-127");
+    static_assert(Depth > 0, "Depth must be 1-255");
+
+public:
+    RYUW122RangeHistory() { clear(); _tagCount = 0; }
+
+    void onRange(const RYUW122Frame& frame, unsigned long timestampUs) override {
+        int8_t tag = getTagIndex(frame.tagAddress);
+        if (tag < 0) tag = addTag(frame.tagAddress);
+        if (tag < 0) return; // full: TAGs beyond MaxTags are ignored
+
+        uint8_t i = _head[tag];
+        int distance = frame.distance;
+        if (distance > 32767) distance = 32767;
+        if (distance < -32768) distance = -32768;
+        _distance[tag][i] = (int16_t)distance;
+        _rssi[tag][i] = (int8_t)(frame.rssi > 127 ? 127 : frame.rssi);
+        _timestampUs[tag][i] = (uint32_t)timestampUs;
+        _payloadLength[tag][i] = (uint8_t)frame.payloadLength;
+
+        _head[tag] = (uint8_t)((i + 1) % Depth);
+        if (_count[tag] < Depth) _count[tag]++;
+    }
+
+    /**
+     * @brief Reserves a slot for a TAG, so that its index is known before its first measurement.
+     * @return The TAG index, or -1 if the address is invalid or the history is full.
+     */
+    int8_t addTag(const char* tagAddress) {
+        int8_t tag = getTagIndex(tagAddress);
+        if (tag >= 0) return tag;
+        if (!tagAddress || strlen(tagAddress) != 8 || _tagCount >= MaxTags) return -1;
+        strcpy(_address[_tagCount], tagAddress);
+        _head[_tagCount] = 0;
+        _count[_tagCount] = 0;
+        return (int8_t)_tagCount++;
+    }
+
+    int8_t getTagIndex(const char* tagAddress) const {
+        if (!tagAddress) return -1;
+        for (uint8_t t = 0; t < _tagCount; t++) {
+            if (strcmp(_address[t], tagAddress) == 0) return (int8_t)t;
+        }
+        return -1;
+    }
+
+    uint8_t getTagCount() const { return _tagCount; }
+    const char* getTagAddress(uint8_t tag) const { return tag < _tagCount ? _address[tag] : ""; }
+
+    /**
+     * @brief Number of measurements stored for a TAG (up to Depth).
+     */
+    uint8_t getCount(uint8_t tag) const { return tag < _tagCount ? _count[tag] : 0; }
+
+    static constexpr uint8_t capacity() { return Depth; }
+
+    // ----- Access by age (0 = newest, getCount() - 1 = oldest); tag must be < getTagCount() -----
+
+    int16_t getDistance(uint8_t tag, uint8_t age = 0) const { return _distance[tag][indexOf(tag, age)]; }
+    int8_t getRssi(uint8_t tag, uint8_t age = 0) const { return _rssi[tag][indexOf(tag, age)]; }
+    uint32_t getTimestamp(uint8_t tag, uint8_t age = 0) const { return _timestampUs[tag][indexOf(tag, age)]; }
+    uint8_t getPayloadLength(uint8_t tag, uint8_t age = 0) const { return _payloadLength[tag][indexOf(tag, age)]; }
+
+    /**
+     * @brief Physical ring index of the measurement with the given age.
+     */
+    uint8_t indexOf(uint8_t tag, uint8_t age) const {
+        return (uint8_t)((_head[tag] + Depth - 1 - (age % Depth)) % Depth);
+    }
+
+    // ----- Raw rings, for reading a window in place -----
+    // The oldest measurement is at indexOf(tag, getCount(tag) - 1); indexes wrap at Depth.
+
+    const int16_t* getDistances(uint8_t tag) const { return _distance[tag]; }
+    const int8_t* getRssis(uint8_t tag) const { return _rssi[tag]; }
+    const uint32_t* getTimestamps(uint8_t tag) const { return _timestampUs[tag]; }
+    const uint8_t* getPayloadLengths(uint8_t tag) const { return _payloadLength[tag]; }
+
+    /**
+     * @brief Forgets the measurements of a TAG (its slot stays reserved).
+     */
+    void clear(uint8_t tag) {
+        if (tag >= MaxTags) return;
+        _head[tag] = 0;
+        _count[tag] = 0;
+    }
+
+    /**
+     * @brief Forgets the measurements of all the TAGs.
+     */
+    void clear() {
+        for (uint8_t t = 0; t < MaxTags; t++) clear(t);
+    }
+
+private:
+    int16_t _distance[MaxTags][Depth];
+    int8_t _rssi[MaxTags][Depth];
+    uint32_t _timestampUs[MaxTags][Depth];
+    uint8_t _payloadLength[MaxTags][Depth];
+
+    uint8_t _head[MaxTags];
+    uint8_t _count[MaxTags];
+    char _address[MaxTags][9];
+    uint8_t _tagCount;
+};
+
+#endif // RYUW122_RANGE_HISTORY_H
@@ -0,0 +1,253 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Pipelined multi-TAG ranging scheduler implementation
+ */
+
+#include "RYUW122RangingScheduler.h"
+
+RYUW122RangingScheduler::RYUW122RangingScheduler(RYUW122& uwb) : _uwb(uwb) {
+    _payload[0] = '\0';
+}
+
+int RYUW122RangingScheduler::addTag(const char* tagAddress) {
+    if (!tagAddress || strlen(tagAddress) != 8) {
+        DEBUG_PRINTLN(F("Error: TAG Address must be 8 bytes ASCII"));
+        return -1;
+    }
+    int index = getTagIndex(tagAddress);
+    if (index >= 0) return index;
+    if (_tagCount >= RYUW122_SCHEDULER_MAX_TAGS) {
+        DEBUG_PRINTLN(F("Error: Ranging scheduler is full"));
+        return -1;
+    }
+
+    TagSlot& slot = _tags[_tagCount];
+    strcpy(slot.address, tagAddress);
+    slot.lastDistance = -1;
+    slot.lastRssi = 0;
+    slot.lastUpdate = 0;
+    slot.interval = 0.0f;
+    slot.successCount = 0;
+    slot.failureCount = 0;
+    return _tagCount++;
+}
+
+bool RYUW122RangingScheduler::removeTag(const char* tagAddress) {
+    int index = getTagIndex(tagAddress);
+    if (index < 0) return false;
+
+    // The exchange in progress belongs to this TAG: drop it, the next loop() polls the following one
+    if (_inFlight != RYUW122_INVALID_TRANSACTION && index == _next) {
+        _uwb.cancelTransaction(_inFlight);
+    }
+
+    for (uint8_t i = index; i + 1 < _tagCount; i++) {
+        _tags[i] = _tags[i + 1];
+    }
+    _tagCount--;
+
+    if (index < _next) _next--;
+    if (_next >= _tagCount) _next = 0;
+    if (_tagCount == 0) stop();
+    return true;
+}
+
+void RYUW122RangingScheduler::clearTags() {
+    stop();
+    _tagCount = 0;
+    _next = 0;
+}
+
+const char* RYUW122RangingScheduler::getTagAddress(uint8_t index) const {
+    return index < _tagCount ? _tags[index].address : "";
+}
+
+int RYUW122RangingScheduler::getTagIndex(const char* tagAddress) const {
+    if (!tagAddress) return -1;
+    for (uint8_t i = 0; i < _tagCount; i++) {
+        if (strcmp(_tags[i].address, tagAddress) == 0) return i;
+    }
+    return -1;
+}
+
+bool RYUW122RangingScheduler::setPayload(const char* data) {
+    if (!data) data = "";
+    if (strlen(data) > RYUW122_MAX_PAYLOAD_LENGTH) {
+        DEBUG_PRINTLN(F("Error: Payload length must be 0-12 bytes"));
+        return false;
+    }
+    strcpy(_payload, data);
+    return true;
+}
+
+void RYUW122RangingScheduler::onResult(RangingResultCallback callback, void* context) {
+    _resultCallback = callback;
+    _resultContext = context;
+}
+
+void RYUW122RangingScheduler::onPayload(RangingPayloadCallback callback, void* context) {
+    _payloadCallback = callback;
+    _payloadContext = context;
+}
+
+void RYUW122RangingScheduler::onRoundComplete(RangingRoundCallback callback, void* context) {
+    _roundCallback = callback;
+    _roundContext = context;
+}
+
+bool RYUW122RangingScheduler::start() {
+    if (_tagCount == 0) return false;
+    if (!_running) {
+        _running = true;
+        _next = 0;
+    }
+    return true;
+}
+
+void RYUW122RangingScheduler::stop() {
+    _running = false;
+    if (_inFlight != RYUW122_INVALID_TRANSACTION) {
+        _uwb.cancelTransaction(_inFlight);
+    }
+}
+
+void RYUW122RangingScheduler::loop() {
+    _uwb.loop();
+    if (_running && _inFlight == RYUW122_INVALID_TRANSACTION) issueNext();
+}
+
+void RYUW122RangingScheduler::issueNext() {
+    while (_tagCount > 0) {
+        if (_next == 0) {
+            // Beginning of a round: honour the minimum round interval
+            if (_roundInterval > 0 && _roundCount > 0 && (millis() - _roundStart) < _roundInterval) return;
+            _roundStart = millis();
+            _roundSuccess = 0;
+            _roundIssued = 0;
+        }
+        if (_uwb.isTagAllowed(_tags[_next].address)) break;
+
+        // Held back by the retry policy: skipped without a result
+        if (++_next >= _tagCount) {
+            endRound();
+            return;
+        }
+    }
+    if (_tagCount == 0) return;
+
+    const char* payload = _payload;
+    char data[RYUW122_MAX_PAYLOAD_LENGTH + 1];
+    if (_payloadCallback) {
+        int length = _payloadCallback(_next, _tags[_next].address, data, _payloadContext);
+        if (length >= 0 && length <= RYUW122_MAX_PAYLOAD_LENGTH) {
+            data[length] = '\0';
+            payload = data;
+        }
+    }
+
+    _inFlight = _uwb.anchorSendDataAsync(_tags[_next].address, strlen(payload), payload,
+                                         transactionCallback, this, _timeout);
+    // If the transaction queue is full, the next loop() tries again
+    if (_inFlight != RYUW122_INVALID_TRANSACTION) _roundIssued++;
+}
+
+void RYUW122RangingScheduler::endRound() {
+    _next = 0;
+    // A round where every TAG was held back is no round
+    if (_roundIssued == 0) return;
+    _roundCount++;
+    _lastRoundDuration = millis() - _roundStart;
+    if (_roundCallback) _roundCallback(_roundSuccess, _lastRoundDuration, _roundContext);
+}
+
+void RYUW122RangingScheduler::transactionCallback(const RYUW122TransactionResult& result, void* context) {
+    static_cast<RYUW122RangingScheduler*>(context)->handleResult(result);
+}
+
+void RYUW122RangingScheduler::handleResult(const RYUW122TransactionResult& result) {
+    _inFlight = RYUW122_INVALID_TRANSACTION;
+    if (result.status == RYUW122TransactionStatus::CANCELLED || _next >= _tagCount) return;
+
+    uint8_t index = _next;
+    TagSlot& slot = _tags[index];
+
+    RYUW122RangingResult ranging;
+    ranging.index = index;
+    ranging.tagAddress = slot.address;
+    ranging.success = (result.status == RYUW122TransactionStatus::COMPLETED && result.frame != nullptr);
+    ranging.distance = ranging.success ? result.frame->distance : 0;
+    ranging.rssi = ranging.success ? result.frame->rssi : 0;
+    ranging.data = ranging.success ? result.frame->data : "";
+    ranging.payloadLength = ranging.success ? result.frame->payloadLength : 0;
+    ranging.elapsed = result.elapsed;
+
+    if (ranging.success) {
+        unsigned long now = millis();
+        if (slot.lastUpdate != 0) {
+            // Exponential moving average of the interval between measurements (alpha = 1/4)
+            float dt = (float)(now - slot.lastUpdate);
+            slot.interval = slot.interval > 0.0f ? slot.interval + (dt - slot.interval) / 4.0f : dt;
+        }
+        slot.lastUpdate = now;
+        slot.lastDistance = ranging.distance;
+        slot.lastRssi = ranging.rssi;
+        slot.successCount++;
+        _roundSuccess++;
+    } else {
+        slot.failureCount++;
+    }
+
+    if (_resultCallback) _resultCallback(ranging, _resultContext);
+
+    // The callback may have changed the TAG set or stopped the scheduler
+    if (_tagCount == 0) return;
+    if (++_next >= _tagCount) endRound();
+
+    // Issue the next exchange right away: the transaction slot has already been released
+    if (_running && _inFlight == RYUW122_INVALID_TRANSACTION) issueNext();
+}
+
+float RYUW122RangingScheduler::getUpdateRate(uint8_t index) const {
+    if (index >= _tagCount) return 0.0f;
+    const TagSlot& slot = _tags[index];
+    if (slot.interval <= 0.0f) return 0.0f;
+
+    // A TAG that stopped answering lowers its own rate as time goes by
+    float interval = slot.interval;
+    float sinceLast = (float)(millis() - slot.lastUpdate);
+    if (sinceLast > interval) interval = sinceLast;
+    return 1000.0f / interval;
+}
+
+unsigned long RYUW122RangingScheduler::getSuccessCount(uint8_t index) const {
+    return index < _tagCount ? _tags[index].successCount : 0;
+}
+
+unsigned long RYUW122RangingScheduler::getFailureCount(uint8_t index) const {
+    return index < _tagCount ? _tags[index].failureCount : 0;
+}
+
+int RYUW122RangingScheduler::getLastDistance(uint8_t index) const {
+    return index < _tagCount ? _tags[index].lastDistance : -1;
+}
+
+int RYUW122RangingScheduler::getLastRssi(uint8_t index) const {
+    return index < _tagCount ? _tags[index].lastRssi : 0;
+}
+
+unsigned long RYUW122RangingScheduler::getLastUpdate(uint8_t index) const {
+    return index < _tagCount ? _tags[index].lastUpdate : 0;
+}
+
+void RYUW122RangingScheduler::resetStats() {
+    for (uint8_t i = 0; i < _tagCount; i++) {
+        _tags[i].lastUpdate = 0;
+        _tags[i].interval = 0.0f;
+        _tags[i].successCount = 0;
+        _tags[i].failureCount = 0;
+    }
+    _roundCount = 0;
+    _lastRoundDuration = 0;
+}
@@ -0,0 +1,230 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Pipelined multi-TAG ranging scheduler for the RYUW122 library
+ */
+
+#ifndef RYUW122_RANGING_SCHEDULER_H
+#define RYUW122_RANGING_SCHEDULER_H
+
+#include "RYUW122.h"
+
+// Maximum number of TAGs a scheduler can poll
+#ifndef RYUW122_SCHEDULER_MAX_TAGS
+    #if defined(ARDUINO_ARCH_AVR)
+        #define RYUW122_SCHEDULER_MAX_TAGS 4
+    #else
+        #define RYUW122_SCHEDULER_MAX_TAGS 8
+    #endif
+#endif
+
+/**
+ * @struct RYUW122RangingResult
+ * @brief Outcome of one ranging exchange issued by the scheduler.
+ * The string fields are valid only during the callback.
+ */
+struct RYUW122RangingResult {
+    uint8_t index;           ///< Index of the TAG in the scheduler
+    const char* tagAddress;
+    bool success;            ///< False if the TAG did not answer in time
+    int distance;            ///< Distance in cm (valid if success)
+    int rssi;                ///< RSSI (valid if success, 0 if not reported)
+    const char* data;        ///< Payload returned by the TAG ("" on failure)
+    int payloadLength;
+    unsigned long elapsed;   ///< Milliseconds from the AT+ANCHOR_SEND to the answer (or timeout)
+};
+
+// Callback types for the scheduler
+typedef void (*RangingResultCallback)(const RYUW122RangingResult& result, void* context);
+typedef void (*RangingRoundCallback)(uint8_t successCount, unsigned long elapsed, void* context);
+// Fills data (RYUW122_MAX_PAYLOAD_LENGTH + 1 bytes) with the payload of the next poll of a TAG;
+// returns its length, or -1 to send the payload of setPayload()
+typedef int (*RangingPayloadCallback)(uint8_t index, const char* tagAddress, char* data, void* context);
+
+/**
+ * @class RYUW122RangingScheduler
+ * @brief Polls a set of TAGs back to back from an ANCHOR.
+ *
+ * Each AT+ANCHOR_SEND is issued as soon as the previous exchange has finished (answer or
+ * timeout), from the completion callback of the asynchronous transaction, so no time is
+ * lost between TAGs. Results are delivered through callbacks and the scheduler keeps the
+ * achieved update rate of each TAG. With a RYUW122RetryPolicy attached to the driver, the
+ * TAGs it holds back are skipped and the round goes on with the others.
+ *
+ * @code
+ * RYUW122RangingScheduler ranging(uwb);
+ * ranging.addTag("T1T1T1T1");
+ * ranging.addTag("T2T2T2T2");
+ * ranging.onResult(onRange);
+ * ranging.start();
+ *
+ * void loop() {
+ *     ranging.loop(); // also runs uwb.loop()
+ * }
+ * @endcode
+ */
+class RYUW122RangingScheduler {
+public:
+    /**
+     * @brief Constructor.
+     * @param uwb The driver of the ANCHOR module used for the exchanges.
+     */
+    explicit RYUW122RangingScheduler(RYUW122& uwb);
+
+    /**
+     * @brief Adds a TAG to the polling set.
+     * @param tagAddress The TAG address (8 bytes ASCII).
+     * @return The index of the TAG, or -1 if the address is invalid or the set is full.
+     */
+    int addTag(const char* tagAddress);
+
+    /**
+     * @brief Removes a TAG from the polling set (the indexes of the following TAGs shift down).
+     * @return True if the TAG was in the set.
+     */
+    bool removeTag(const char* tagAddress);
+
+    /**
+     * @brief Removes all the TAGs.
+     */
+    void clearTags();
+
+    uint8_t getTagCount() const { return _tagCount; }
+    const char* getTagAddress(uint8_t index) const;
+    int getTagIndex(const char* tagAddress) const;
+
+    /**
+     * @brief Sets the payload sent with each poll (default: none, ranging only).
+     * @param data Payload, up to RYUW122_MAX_PAYLOAD_LENGTH bytes.
+     * @return False if the payload is too long.
+     */
+    bool setPayload(const char* data);
+
+    /**
+     * @brief Registers a callback choosing the payload of each poll, e.g. to carry the fragments
+     * of a RYUW122Transfer with the ranging exchanges.
+     */
+    void onPayload(RangingPayloadCallback callback, void* context = nullptr);
+
+    /**
+     * @brief Sets how long to wait for each TAG before moving to the next one.
+     * The default 0 uses the adaptive timeout of the driver, from the round trips of each TAG
+     * (see RYUW122::setAdaptiveTimeout()): an absent TAG no longer stalls the round for long.
+     */
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+
+    /**
+     * @brief Sets the minimum time between the start of two rounds (default 0: back to back).
+     */
+    void setRoundInterval(unsigned long interval) { _roundInterval = interval; }
+
+    /**
+     * @brief Registers the callback invoked after each exchange.
+     */
+    void onResult(RangingResultCallback callback, void* context = nullptr);
+
+    /**
+     * @brief Registers the callback invoked when all the TAGs of a round have been polled.
+     */
+    void onRoundComplete(RangingRoundCallback callback, void* context = nullptr);
+
+    /**
+     * @brief Starts polling; the first exchange is issued by the next loop().
+     * @return False if there are no TAGs.
+     */
+    bool start();
+
+    /**
+     * @brief Stops polling and cancels the exchange in progress.
+     */
+    void stop();
+
+    bool isRunning() const { return _running; }
+
+    /**
+     * @brief Runs the driver loop and issues the next exchange when one is due.
+     * Call it from the sketch loop() instead of RYUW122::loop().
+     */
+    void loop();
+
+    // ----- Statistics -----
+
+    /**
+     * @brief Gets the achieved update rate of a TAG.
+     * The rate decays if the TAG stops answering.
+     * @return Successful measurements per second (0 before the second measurement).
+     */
+    float getUpdateRate(uint8_t index) const;
+
+    unsigned long getSuccessCount(uint8_t index) const;
+    unsigned long getFailureCount(uint8_t index) const;
+
+    /**
+     * @brief Gets the last distance measured for a TAG.
+     * @return Distance in cm, or -1 if the TAG never answered.
+     */
+    int getLastDistance(uint8_t index) const;
+    int getLastRssi(uint8_t index) const;
+
+    /**
+     * @brief Gets the millis() of the last successful measurement of a TAG (0 if none).
+     */
+    unsigned long getLastUpdate(uint8_t index) const;
+
+    unsigned long getRoundCount() const { return _roundCount; }
+
+    /**
+     * @brief Gets the duration of the last complete round in milliseconds.
+     */
+    unsigned long getLastRoundDuration() const { return _lastRoundDuration; }
+
+    /**
+     * @brief Resets the counters and the update rates.
+     */
+    void resetStats();
+
+private:
+    struct TagSlot {
+        char address[9];
+        int lastDistance;
+        int lastRssi;
+        unsigned long lastUpdate;
+        float interval;          // smoothed milliseconds between successful measurements
+        unsigned long successCount;
+        unsigned long failureCount;
+    };
+
+    static void transactionCallback(const RYUW122TransactionResult& result, void* context);
+    void handleResult(const RYUW122TransactionResult& result);
+    void issueNext();
+    void endRound();
+
+    RYUW122& _uwb;
+
+    TagSlot _tags[RYUW122_SCHEDULER_MAX_TAGS];
+    uint8_t _tagCount = 0;
+    uint8_t _next = 0;
+
+    char _payload[RYUW122_MAX_PAYLOAD_LENGTH + 1];
+    unsigned long _timeout = 0;
+    unsigned long _roundInterval = 0;
+
+    bool _running = false;
+    uint16_t _inFlight = RYUW122_INVALID_TRANSACTION;
+
+    unsigned long _roundStart = 0;
+    uint8_t _roundSuccess = 0;
+    uint8_t _roundIssued = 0;
+    unsigned long _roundCount = 0;
+    unsigned long _lastRoundDuration = 0;
+
+    RangingResultCallback _resultCallback = nullptr;
+    void* _resultContext = nullptr;
+    RangingRoundCallback _roundCallback = nullptr;
+    void* _roundContext = nullptr;
+    RangingPayloadCallback _payloadCallback = nullptr;
+    void* _payloadContext = nullptr;
+};
+
+#endif // RYUW122_RANGING_SCHEDULER_H
@@ -0,0 +1,115 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Per-TAG retry, backoff and circuit breaker policy implementation
+ */
+
+#include "RYUW122RetryPolicy.h"
+
+void RYUW122RetryPolicy::setBackoff(unsigned long base, unsigned long max) {
+    _backoffBase = base;
+    _backoffMax = max < base ? base : max;
+}
+
+void RYUW122RetryPolicy::onStateChange(CircuitStateCallback callback, void* context) {
+    _stateCallback = callback;
+    _stateContext = context;
+}
+
+int RYUW122RetryPolicy::findTag(const char* tagAddress) const {
+    if (!tagAddress) return -1;
+    for (uint8_t i = 0; i < _tagCount; i++) {
+        if (strncmp(_tags[i].address, tagAddress, 8) == 0) return i;
+    }
+    return -1;
+}
+
+void RYUW122RetryPolicy::setState(TagSlot& slot, RYUW122CircuitState state) {
+    if (slot.state == state) return;
+    slot.state = state;
+    if (_stateCallback) _stateCallback(slot.address, state, _stateContext);
+}
+
+bool RYUW122RetryPolicy::isAllowed(const char* tagAddress, unsigned long now) const {
+    int index = findTag(tagAddress);
+    if (index < 0) return true;
+    const TagSlot& slot = _tags[index];
+    return (now - slot.holdStart) >= slot.holdTime;
+}
+
+bool RYUW122RetryPolicy::beginAttempt(const char* tagAddress, unsigned long now) {
+    int index = findTag(tagAddress);
+    if (index < 0) return true;
+    TagSlot& slot = _tags[index];
+    if ((now - slot.holdStart) < slot.holdTime) return false;
+
+    if (slot.state != RYUW122CircuitState::CLOSED) {
+        // One probe per open time: a probe that never reports (cancelled) does not block the TAG
+        slot.holdStart = now;
+        slot.holdTime = _openTime << slot.openShift;
+        setState(slot, RYUW122CircuitState::HALF_OPEN);
+    }
+    return true;
+}
+
+void RYUW122RetryPolicy::recordResult(const char* tagAddress, bool answered, unsigned long now) {
+    int index = findTag(tagAddress);
+
+    if (answered) {
+        if (index < 0) return;
+        // Back in coverage: the slot is released (answering TAGs need none)
+        TagSlot slot = _tags[index];
+        for (uint8_t i = index; i + 1 < _tagCount; i++) _tags[i] = _tags[i + 1];
+        _tagCount--;
+        if (slot.state != RYUW122CircuitState::CLOSED && _stateCallback) {
+            _stateCallback(slot.address, RYUW122CircuitState::CLOSED, _stateContext);
+        }
+        return;
+    }
+
+    if (index < 0) {
+        // Table full: the TAG keeps being ranged as if there were no policy
+        if (_tagCount >= RYUW122_RETRY_MAX_TAGS) return;
+        index = _tagCount++;
+        TagSlot& slot = _tags[index];
+        strncpy(slot.address, tagAddress, 8);
+        slot.address[8] = '\0';
+        slot.state = RYUW122CircuitState::CLOSED;
+        slot.failures = 0;
+        slot.openShift = 0;
+    }
+
+    TagSlot& slot = _tags[index];
+    slot.holdStart = now;
+    if (slot.failures < 0xFF) slot.failures++;
+
+    if (slot.state == RYUW122CircuitState::HALF_OPEN) {
+        // The probe failed: stay away longer
+        if (slot.openShift < RYUW122_RETRY_MAX_OPEN_SHIFT) slot.openShift++;
+        slot.holdTime = _openTime << slot.openShift;
+        setState(slot, RYUW122CircuitState::OPEN);
+    } else if (slot.state == RYUW122CircuitState::CLOSED && slot.failures >= _failureThreshold) {
+        slot.openShift = 0;
+        slot.holdTime = _openTime;
+        setState(slot, RYUW122CircuitState::OPEN);
+    } else if (slot.state == RYUW122CircuitState::CLOSED) {
+        // Exponential backoff: base, 2 base, 4 base... up to max
+        uint8_t shift = slot.failures - 1;
+        unsigned long backoff = shift < 16 ? (_backoffBase << shift) : _backoffMax;
+        slot.holdTime = backoff > _backoffMax || backoff < _backoffBase ? _backoffMax : backoff;
+    } else {
+        // A late failure while OPEN (an exchange started before the circuit opened)
+        slot.holdTime = _openTime << slot.openShift;
+    }
+}
+
+RYUW122CircuitState RYUW122RetryPolicy::getState(const char* tagAddress) const {
+    int index = findTag(tagAddress);
+    return index < 0 ? RYUW122CircuitState::CLOSED : _tags[index].state;
+}
+
+uint8_t RYUW122RetryPolicy::getFailures(const char* tagAddress) const {
+    int index = findTag(tagAddress);
+    return index < 0 ? 0 : _tags[index].failures;
+}
@@ -0,0 +1,141 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Per-TAG retry, backoff and circuit breaker policy for the RYUW122 ranging exchanges
+ */
+
+#ifndef RYUW122_RETRY_POLICY_H
+#define RYUW122_RETRY_POLICY_H
+
+#include "RYUW122.h"
+
+// Number of failing TAGs the policy can hold back at the same time (answering TAGs use no slot)
+#ifndef RYUW122_RETRY_MAX_TAGS
+#define RYUW122_RETRY_MAX_TAGS RYUW122_MAX_TRACKED_TAGS
+#endif
+
+// Each failed probe of an open circuit doubles its open time, up to 2^RYUW122_RETRY_MAX_OPEN_SHIFT times
+#define RYUW122_RETRY_MAX_OPEN_SHIFT 3
+
+/**
+ * @brief Circuit breaker state of a TAG.
+ */
+enum class RYUW122CircuitState {
+    CLOSED,    ///< The TAG answers (or has failed less than the threshold): it is ranged, with backoff after failures
+    OPEN,      ///< The TAG is considered gone: no exchange until the open time has elapsed
+    HALF_OPEN  ///< Open time elapsed: one probe exchange decides whether the TAG is back
+};
+
+// Called when a TAG changes circuit state (OPEN: gone missing, CLOSED: back)
+typedef void (*CircuitStateCallback)(const char* tagAddress, RYUW122CircuitState state, void* context);
+
+/**
+ * @class RYUW122RetryPolicy
+ * @brief Keeps missing TAGs from starving the ones in coverage.
+ *
+ * Attached to the driver with RYUW122::setRetryPolicy(), the policy applies to every ranging
+ * exchange, an AT+ANCHOR_SEND waiting for the +ANCHOR_RCV of the TAG (blocking, asynchronous and
+ * ranging scheduler). anchorSendData() ends at the +OK of the module and is not counted, nor is
+ * an exchange that timed out before the +OK:
+ *  - a timed out exchange is sent again up to setMaxRetries() times before it fails;
+ *  - after a failure the TAG is held back for an exponential backoff (base, 2 base, 4 base...);
+ *  - after setFailureThreshold() failures in a row the circuit opens: the TAG is not ranged
+ *    for setOpenTime(), then a single probe is let through (HALF_OPEN). An answer closes the
+ *    circuit, a failure opens it again for twice the time (up to 8 times).
+ *
+ * Held back exchanges fail at once without any traffic (the blocking calls return false, the
+ * asynchronous ones RYUW122_INVALID_TRANSACTION) and the scheduler skips those TAGs. Only
+ * failing TAGs use one of the RYUW122_RETRY_MAX_TAGS slots.
+ *
+ * @code
+ * RYUW122RetryPolicy policy;
+ * policy.setFailureThreshold(3);
+ * policy.onStateChange(onTagState);      // OPEN: TAG lost, CLOSED: TAG back
+ * uwb.setRetryPolicy(&policy);
+ * @endcode
+ */
+class RYUW122RetryPolicy {
+public:
+    /**
+     * @brief Exchanges sent again after a timeout before the failure is reported (default 1).
+     */
+    void setMaxRetries(uint8_t retries) { _maxRetries = retries; }
+    uint8_t getMaxRetries() const { return _maxRetries; }
+
+    /**
+     * @brief Backoff after a failure: base, doubled at each failure in a row, up to max (default 100 and 2000 ms).
+     */
+    void setBackoff(unsigned long base, unsigned long max);
+
+    /**
+     * @brief Failures in a row that open the circuit of a TAG (default 3).
+     */
+    void setFailureThreshold(uint8_t failures) { _failureThreshold = failures ? failures : 1; }
+
+    /**
+     * @brief Time an open circuit waits before the probe exchange (default 5000 ms).
+     */
+    void setOpenTime(unsigned long openTime) { _openTime = openTime; }
+
+    /**
+     * @brief Registers the callback invoked when a TAG changes circuit state.
+     */
+    void onStateChange(CircuitStateCallback callback, void* context = nullptr);
+
+    /**
+     * @brief Checks whether a TAG may be ranged now, without changing its state.
+     */
+    bool isAllowed(const char* tagAddress, unsigned long now) const;
+
+    /**
+     * @brief Called by the driver before an exchange: like isAllowed(), and lets the probe of an open circuit through.
+     * @return False if the exchange must not be sent.
+     */
+    bool beginAttempt(const char* tagAddress, unsigned long now);
+
+    /**
+     * @brief Called by the driver with the outcome of an exchange (after its retries).
+     * @param answered True if the +ANCHOR_RCV arrived.
+     */
+    void recordResult(const char* tagAddress, bool answered, unsigned long now);
+
+    RYUW122CircuitState getState(const char* tagAddress) const;
+
+    /**
+     * @brief Gets the failures in a row of a TAG (0 if it answers).
+     */
+    uint8_t getFailures(const char* tagAddress) const;
+
+    /**
+     * @brief Closes all the circuits (without events).
+     */
+    void reset() { _tagCount = 0; }
+
+private:
+    struct TagSlot {
+        char address[9];
+        RYUW122CircuitState state;
+        uint8_t failures;         // failures in a row
+        uint8_t openShift;        // failed probes in a row
+        unsigned long holdStart;  // millis() of the last failure or probe
+        unsigned long holdTime;   // no exchange before holdStart + holdTime
+    };
+
+    int findTag(const char* tagAddress) const;
+    void setState(TagSlot& slot, RYUW122CircuitState state);
+
+    uint8_t _maxRetries = 1;
+    unsigned long _backoffBase = 100;
+    unsigned long _backoffMax = 2000;
+    uint8_t _failureThreshold = 3;
+    unsigned long _openTime = 5000;
+
+    TagSlot _tags[RYUW122_RETRY_MAX_TAGS];
+    uint8_t _tagCount = 0;
+
+    CircuitStateCallback _stateCallback = nullptr;
+    void* _stateContext = nullptr;
+};
+
+#endif // RYUW122_RETRY_POLICY_H
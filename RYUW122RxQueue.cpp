@@ -0,0 +1,89 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Receive path of the RYUW122 driver run outside the main loop: implementation
+ */
+
+#include "RYUW122RxQueue.h"
+
+#ifdef RYUW122_HAS_RX_QUEUE
+
+RYUW122RxQueue::RYUW122RxQueue() : _head(0), _tail(0), _queued(0), _dropped(0), _maxDepth(0) {}
+
+void RYUW122RxQueue::feed(const uint8_t* data, size_t length) {
+    // Same rules as RYUW122::processIncoming(): whitespace trimmed, overlong lines dropped
+    for (size_t i = 0; i < length; i++) {
+        char c = (char)data[i];
+        if (c == '\n') {
+            while (_length > 0 && isspace((unsigned char)_line[_length - 1])) _length--;
+            _line[_length] = '\0';
+            if (!_overflow && _length > 0) pushLine();
+            _length = 0;
+            _overflow = false;
+            continue;
+        }
+
+        if (_length == 0 && isspace((unsigned char)c)) continue;
+
+        if (_length < sizeof(_line) - 1) {
+            _line[_length++] = c;
+        } else {
+            _overflow = true;
+        }
+    }
+}
+
+void RYUW122RxQueue::pushLine() {
+    uint16_t tail = _tail.load(std::memory_order_relaxed);
+    uint16_t depth = (uint16_t)(tail - _head.load(std::memory_order_acquire));
+    if (depth >= RYUW122_RX_QUEUE_SIZE) {
+        _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    RYUW122RxEntry& entry = _slots[tail & (RYUW122_RX_QUEUE_SIZE - 1)];
+    memcpy(entry.text, _line, _length + 1);
+    entry.timestampUs = micros();
+    entry.isFrame = strncmp_P(_line, PSTR("+ANCHOR_RCV="), 12) == 0 || strncmp_P(_line, PSTR("+TAG_RCV="), 9) == 0;
+    if (entry.isFrame) {
+        memcpy(entry.fields, _line, _length + 1);
+        RYUW122ParseFrame(entry.fields, entry.frame);
+    }
+
+    // Publishes the slot: the consumer sees it complete
+    _tail.store((uint16_t)(tail + 1), std::memory_order_release);
+
+    _queued.store(_queued.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (depth + 1 > _maxDepth.load(std::memory_order_relaxed)) {
+        _maxDepth.store((uint16_t)(depth + 1), std::memory_order_relaxed);
+    }
+}
+
+// Pointer into the fields of a slot moved to the copy
+static const char* rebase(const char* p, const RYUW122RxEntry& from, RYUW122RxEntry& to) {
+    if (p >= from.fields && p < from.fields + sizeof(from.fields)) return to.fields + (p - from.fields);
+    return p;
+}
+
+bool RYUW122RxQueue::pop(RYUW122RxEntry& entry) {
+    uint16_t head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire)) return false;
+
+    const RYUW122RxEntry& slot = _slots[head & (RYUW122_RX_QUEUE_SIZE - 1)];
+    entry = slot;
+    if (entry.isFrame) {
+        entry.frame.tagAddress = rebase(slot.frame.tagAddress, slot, entry);
+        entry.frame.data = rebase(slot.frame.data, slot, entry);
+    }
+
+    // Hands the slot back to the producer
+    _head.store((uint16_t)(head + 1), std::memory_order_release);
+    return true;
+}
+
+uint16_t RYUW122RxQueue::size() const {
+    return (uint16_t)(_tail.load(std::memory_order_acquire) - _head.load(std::memory_order_relaxed));
+}
+
+#endif // RYUW122_HAS_RX_QUEUE
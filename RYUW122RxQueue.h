@@ -0,0 +1,145 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Receive path of the RYUW122 driver run outside the main loop
+ */
+
+#ifndef RYUW122_RX_QUEUE_H
+#define RYUW122_RX_QUEUE_H
+
+#include "RYUW122.h"
+
+#ifdef RYUW122_HAS_RX_QUEUE
+
+#include <atomic>
+
+// Lines the receive queue holds until loop() takes them (a power of two)
+#ifndef RYUW122_RX_QUEUE_SIZE
+#define RYUW122_RX_QUEUE_SIZE 16
+#endif
+
+/**
+ * @class RYUW122RxQueue
+ * @brief Lock-free single-producer / single-consumer queue of received lines.
+ *
+ * The producer (a UART receive callback, an RTOS task, a thread) hands the bytes of the module
+ * to feed(): lines are assembled, +ANCHOR_RCV/+TAG_RCV frames decoded and timestamped there,
+ * as soon as they arrive. The driver is the consumer: attached with RYUW122::setReceiveQueue(),
+ * its loop() only takes the queued lines and runs the transactions and the callbacks, which
+ * therefore stay in the main loop.
+ *
+ * The two sides share only the head and tail indexes (acquire/release atomics): feed() is
+ * called by one context only, pop() by the driver only. When the queue is full the new line
+ * is dropped and counted.
+ * @code
+ * RYUW122RxQueue rxQueue;
+ * RYUW122UartReceiver receiver(Serial2, rxQueue);   // ESP32
+ *
+ * uwb.begin();
+ * receiver.begin();
+ * uwb.setReceiveQueue(&rxQueue);
+ * @endcode
+ */
+class RYUW122RxQueue {
+public:
+    RYUW122RxQueue();
+
+    // ----- Producer side -----
+
+    /**
+     * @brief Adds received bytes; each complete line is queued.
+     */
+    void feed(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Drops the partial line (e.g. after a baud rate change).
+     */
+    void resetLine() { _length = 0; _overflow = false; }
+
+    // ----- Consumer side -----
+
+    /**
+     * @brief Moves the oldest line into entry.
+     * @return False if the queue is empty.
+     */
+    bool pop(RYUW122RxEntry& entry);
+
+    /**
+     * @brief Gets the lines waiting in the queue.
+     */
+    uint16_t size() const;
+
+    // ----- Statistics (readable from both sides) -----
+
+    unsigned long getQueued() const { return _queued.load(std::memory_order_relaxed); }
+    unsigned long getDropped() const { return _dropped.load(std::memory_order_relaxed); }
+    uint16_t getMaxDepth() const { return _maxDepth.load(std::memory_order_relaxed); }
+
+private:
+    static_assert((RYUW122_RX_QUEUE_SIZE & (RYUW122_RX_QUEUE_SIZE - 1)) == 0,
+                  "RYUW122_RX_QUEUE_SIZE must be a power of two");
+
+    void pushLine();
+
+    RYUW122RxEntry _slots[RYUW122_RX_QUEUE_SIZE];
+    // Free running counters: the slot is the counter modulo the size
+    std::atomic<uint16_t> _head;  // next line to pop, written by the consumer
+    std::atomic<uint16_t> _tail;  // next slot to fill, written by the producer
+
+    // Line assembly, producer only
+    char _line[RYUW122_RX_BUFFER_SIZE];
+    uint8_t _length = 0;
+    bool _overflow = false;
+
+    std::atomic<unsigned long> _queued;
+    std::atomic<unsigned long> _dropped;
+    std::atomic<uint16_t> _maxDepth;
+};
+
+#if defined(ESP32)
+/**
+ * @class RYUW122UartReceiver
+ * @brief Feeds a RYUW122RxQueue from the receive callback of an ESP32 UART.
+ *
+ * HardwareSerial::onReceive() runs the callback in the event task of the UART driver as soon as
+ * data arrives (FIFO threshold or end of a burst): the lines are decoded there, without waiting
+ * for the next loop() and without polling available().
+ */
+class RYUW122UartReceiver {
+public:
+    RYUW122UartReceiver(HardwareSerial& serial, RYUW122RxQueue& queue) : _serial(serial), _queue(queue) {}
+
+    /**
+     * @brief Registers the receive callback (again after each begin() of the UART).
+     */
+    void begin() {
+        _queue.resetLine();
+        _serial.onReceive([this]() { drain(); });
+    }
+
+    void end() { _serial.onReceive(nullptr); }
+
+    /**
+     * @brief Moves the bytes in the UART buffer into the queue (called by the callback).
+     */
+    void drain() {
+        uint8_t buffer[RYUW122_RX_CHUNK_SIZE];
+        int count;
+        while ((count = _serial.available()) > 0) {
+            if (count > (int)sizeof(buffer)) count = sizeof(buffer);
+            size_t read = _serial.read(buffer, (size_t)count);
+            if (read == 0) break;
+            _queue.feed(buffer, read);
+        }
+    }
+
+private:
+    HardwareSerial& _serial;
+    RYUW122RxQueue& _queue;
+};
+#endif
+
+#endif // RYUW122_HAS_RX_QUEUE
+
+#endif // RYUW122_RX_QUEUE_H
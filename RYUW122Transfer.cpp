@@ -0,0 +1,327 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Segmented transfer implementation
+ */
+
+#include "RYUW122Transfer.h"
+
+// Frame: '~', then in base64 <type:2><id:4><fragment:6> and
+//  DATA/LAST: up to 6 message bytes
+//  ACK:       12-bit bitmap of the fragments received after <fragment> (received in order before it)
+//  DONE:      nothing, <fragment> is the last fragment of the message
+
+RYUW122Transfer::RYUW122Transfer(const char* peerAddress) {
+    setPeer(peerAddress);
+    memset(_bitmap, 0, sizeof(_bitmap));
+    memset(_sentAt, 0, sizeof(_sentAt));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void RYUW122Transfer::setPeer(const char* peerAddress) {
+    _peer[0] = '\0';
+    if (peerAddress) {
+        strncpy(_peer, peerAddress, 8);
+        _peer[8] = '\0';
+    }
+}
+
+void RYUW122Transfer::setWindow(uint8_t window) {
+    if (window < 1) window = 1;
+    if (window > RYUW122_TRANSFER_MAX_WINDOW) window = RYUW122_TRANSFER_MAX_WINDOW;
+    _window = window;
+}
+
+void RYUW122Transfer::onComplete(TransferCompleteCallback callback, void* context) {
+    _completeCallback = callback;
+    _completeContext = context;
+}
+
+bool RYUW122Transfer::send(const uint8_t* data, uint16_t length) {
+    if (!data || length == 0 || length > RYUW122_TRANSFER_MAX_LENGTH) {
+        DEBUG_PRINTLN(F("Error: Transfer length must be 1-384 bytes"));
+        return false;
+    }
+    _sender = true;
+    _txData = data;
+    _length = length;
+    _fragments = (uint8_t)((length + RYUW122_TRANSFER_FRAGMENT_BYTES - 1) / RYUW122_TRANSFER_FRAGMENT_BYTES);
+    _id = (uint8_t)((_id + 1) & 0x0F);
+    memset(_bitmap, 0, sizeof(_bitmap));
+    _base = 0;
+    _nextNew = 0;
+    _sendSeq = 0;
+    _idle = 0;
+    memset(&_stats, 0, sizeof(_stats));
+    _startTime = 0;
+    _state = RYUW122TransferState::SENDING;
+    return true;
+}
+
+bool RYUW122Transfer::receive(uint8_t* buffer, uint16_t size) {
+    if (!buffer || size == 0) return false;
+    _sender = false;
+    _rxBuffer = buffer;
+    _size = size;
+    _length = 0;
+    _fragments = 0;
+    memset(_bitmap, 0, sizeof(_bitmap));
+    _base = 0;
+    _started = false;
+    _idle = 0;
+    memset(&_stats, 0, sizeof(_stats));
+    _startTime = 0;
+    _state = RYUW122TransferState::RECEIVING;
+    return true;
+}
+
+void RYUW122Transfer::cancel() {
+    _state = RYUW122TransferState::IDLE;
+}
+
+RYUW122TransferStats RYUW122Transfer::getStats() const {
+    RYUW122TransferStats stats = _stats;
+    bool ended = _state == RYUW122TransferState::COMPLETE || _state == RYUW122TransferState::FAILED;
+    stats.bytes = _sender || _state == RYUW122TransferState::COMPLETE
+                  ? _length : (uint16_t)(_base * RYUW122_TRANSFER_FRAGMENT_BYTES);
+    stats.fragments = _fragments;
+    stats.elapsed = _startTime == 0 ? 0 : (ended ? _endTime : millis()) - _startTime;
+    stats.throughput = stats.elapsed > 0 ? stats.bytes * 1000.0f / stats.elapsed : 0.0f;
+    return stats;
+}
+
+bool RYUW122Transfer::handleFrame(const char* data, int length) {
+    if (!data || length < 3 || length > RYUW122_MAX_PAYLOAD_LENGTH || data[0] != RYUW122_TRANSFER_MARKER) return false;
+
+    RYUW122PayloadBits bits;
+    if (!bits.fromChars(data + 1, length - 1)) return false;
+    uint8_t type = (uint8_t)bits.read(2);
+    uint8_t id = (uint8_t)bits.read(4);
+    uint8_t value = (uint8_t)bits.read(6);
+
+    switch (type) {
+        case FRAME_DATA:
+        case FRAME_LAST:
+            if (_sender) return false;
+            handleData(id, value, type == FRAME_LAST, bits, (uint8_t)(((length - 1) * 6 - 12) / 8));
+            return true;
+
+        case FRAME_ACK:
+            if (!_sender) return false;
+            handleAck(id, value, (uint16_t)bits.read(12));
+            return true;
+
+        case FRAME_DONE:
+        default:
+            if (!_sender) return false;
+            if (_state == RYUW122TransferState::SENDING && id == _id && value + 1 == _fragments) {
+                _stats.framesReceived++;
+                finish(RYUW122TransferState::COMPLETE);
+            }
+            return true;
+    }
+}
+
+void RYUW122Transfer::handleData(uint8_t id, uint8_t index, bool last, RYUW122PayloadBits& bits, uint8_t bytes) {
+    if (_state == RYUW122TransferState::RECEIVING && !_started) {
+        // A late fragment of the transfer already completed: nextFrame() confirms it again
+        if ((int16_t)id == _doneId) return;
+        _id = id;
+        _started = true;
+        _startTime = millis();
+    }
+    if (_state != RYUW122TransferState::RECEIVING || id != _id) return;
+
+    _stats.framesReceived++;
+    if (!last && bytes != RYUW122_TRANSFER_FRAGMENT_BYTES) return; // only the last fragment may be short
+    if (_fragments > 0 && index >= _fragments) return;
+    if (isAcked(index)) {
+        _stats.duplicates++;
+        return;
+    }
+
+    uint16_t offset = (uint16_t)index * RYUW122_TRANSFER_FRAGMENT_BYTES;
+    if (offset + bytes > _size) {
+        DEBUG_PRINTLN(F("Error: Transfer larger than the receive buffer"));
+        finish(RYUW122TransferState::FAILED);
+        return;
+    }
+    for (uint8_t i = 0; i < bytes; i++) {
+        _rxBuffer[offset + i] = (uint8_t)bits.read(8);
+    }
+    setAcked(index);
+    if (last) {
+        _fragments = index + 1;
+        _length = offset + bytes;
+    }
+    while (_base < RYUW122_TRANSFER_MAX_FRAGMENTS && isAcked(_base)) _base++;
+    progress();
+
+    if (_fragments > 0 && _base >= _fragments) {
+        _doneId = _id;
+        _doneFragments = _fragments;
+        finish(RYUW122TransferState::COMPLETE);
+    }
+}
+
+void RYUW122Transfer::handleAck(uint8_t id, uint8_t cumulative, uint16_t selective) {
+    if (_state != RYUW122TransferState::SENDING || id != _id) return;
+    _stats.framesReceived++;
+
+    // Nothing can be acknowledged before it is sent
+    bool advanced = false;
+    for (uint8_t i = _base; i < cumulative && i < _nextNew; i++) {
+        if (!isAcked(i)) {
+            setAcked(i);
+            advanced = true;
+        }
+    }
+    for (uint8_t b = 0; b < RYUW122_TRANSFER_MAX_WINDOW; b++) {
+        uint8_t index = cumulative + 1 + b;
+        if (index >= _nextNew) break;
+        if ((selective >> b) & 1 && !isAcked(index)) {
+            setAcked(index);
+            advanced = true;
+        }
+    }
+    while (_base < _fragments && isAcked(_base)) _base++;
+    if (advanced) progress();
+}
+
+uint8_t RYUW122Transfer::nextFrame(char* out) {
+    out[0] = '\0';
+    RYUW122PayloadBits bits;
+
+    if (_sender) {
+        if (_state != RYUW122TransferState::SENDING) return 0;
+        if (_startTime == 0) _startTime = millis();
+        if (_maxIdle > 0 && _idle >= _maxIdle) {
+            DEBUG_PRINTLN(F("Transfer failed: no acknowledgement"));
+            finish(RYUW122TransferState::FAILED);
+            return 0;
+        }
+        _idle++;
+
+        // Selective retransmission: a fragment sent after this one was acknowledged, this one is lost
+        for (uint8_t f = _base; f < _nextNew; f++) {
+            if (isAcked(f)) continue;
+            for (uint8_t g = f + 1; g < _nextNew; g++) {
+                if (isAcked(g) && (int16_t)(_sentAt[g % RYUW122_TRANSFER_MAX_WINDOW]
+                                            - _sentAt[f % RYUW122_TRANSFER_MAX_WINDOW]) > 0) {
+                    return sendFragment(out, f, true);
+                }
+            }
+        }
+
+        if (_nextNew < _fragments && _nextNew < _base + _window) {
+            return sendFragment(out, _nextNew++, false);
+        }
+
+        // Window full (or all sent): the oldest fragment in flight goes again
+        int16_t oldest = -1;
+        for (uint8_t f = _base; f < _nextNew; f++) {
+            if (isAcked(f)) continue;
+            if (oldest < 0 || (int16_t)(_sentAt[f % RYUW122_TRANSFER_MAX_WINDOW]
+                                        - _sentAt[oldest % RYUW122_TRANSFER_MAX_WINDOW]) < 0) {
+                oldest = f;
+            }
+        }
+        return oldest >= 0 ? sendFragment(out, (uint8_t)oldest, true) : 0;
+    }
+
+    // Receiver: the whole message (again, if the sender did not get it), or what is missing
+    bool confirm = _state == RYUW122TransferState::COMPLETE
+                   || (_state == RYUW122TransferState::RECEIVING && !_started && _doneId >= 0);
+    if (confirm) {
+        bits.write(FRAME_DONE, 2);
+        bits.write((uint32_t)_doneId, 4);
+        bits.write(_doneFragments - 1, 6);
+        _stats.framesSent++;
+        return writeFrame(out, bits);
+    }
+    if (_state != RYUW122TransferState::RECEIVING || !_started) return 0;
+
+    if (_maxIdle > 0 && _idle >= _maxIdle) {
+        DEBUG_PRINTLN(F("Transfer failed: no fragment"));
+        finish(RYUW122TransferState::FAILED);
+        return 0;
+    }
+    _idle++;
+
+    uint16_t selective = 0;
+    for (uint8_t b = 0; b < RYUW122_TRANSFER_MAX_WINDOW; b++) {
+        uint8_t index = _base + 1 + b;
+        if (index < RYUW122_TRANSFER_MAX_FRAGMENTS && isAcked(index)) selective |= (uint16_t)(1 << b);
+    }
+    bits.write(FRAME_ACK, 2);
+    bits.write(_id, 4);
+    bits.write(_base, 6);
+    bits.write(selective, 12);
+    _stats.framesSent++;
+    return writeFrame(out, bits);
+}
+
+uint8_t RYUW122Transfer::sendFragment(char* out, uint8_t index, bool retransmission) {
+    _sentAt[index % RYUW122_TRANSFER_MAX_WINDOW] = ++_sendSeq;
+    _stats.framesSent++;
+    if (retransmission) _stats.retransmissions++;
+
+    uint16_t offset = (uint16_t)index * RYUW122_TRANSFER_FRAGMENT_BYTES;
+    uint16_t bytes = _length - offset;
+    if (bytes > RYUW122_TRANSFER_FRAGMENT_BYTES) bytes = RYUW122_TRANSFER_FRAGMENT_BYTES;
+
+    RYUW122PayloadBits bits;
+    bits.write(index + 1 == _fragments ? FRAME_LAST : FRAME_DATA, 2);
+    bits.write(_id, 4);
+    bits.write(index, 6);
+    for (uint16_t i = 0; i < bytes; i++) bits.write(_txData[offset + i], 8);
+    return writeFrame(out, bits);
+}
+
+uint8_t RYUW122Transfer::writeFrame(char* out, RYUW122PayloadBits& bits) {
+    out[0] = RYUW122_TRANSFER_MARKER;
+    return (uint8_t)(bits.toChars(out + 1) + 1);
+}
+
+void RYUW122Transfer::progress() {
+    _idle = 0;
+}
+
+void RYUW122Transfer::finish(RYUW122TransferState state) {
+    _state = state;
+    _endTime = millis();
+    if (_startTime == 0) _startTime = _endTime;
+    if (_completeCallback) _completeCallback(state, _length, _completeContext);
+}
+
+void RYUW122Transfer::onRange(const RYUW122Frame& frame, unsigned long timestampUs) {
+    (void)timestampUs;
+    if (_peer[0] != '\0' && strncmp(frame.tagAddress, _peer, 8) == 0) {
+        handleFrame(frame.data, frame.payloadLength);
+    }
+}
+
+bool RYUW122Transfer::exchange(RYUW122& uwb) {
+    if (_peer[0] == '\0') return false;
+    uwb.addRangeListener(this); // no-op once registered
+    char frame[RYUW122_MAX_PAYLOAD_LENGTH + 1];
+    uint8_t length = nextFrame(frame);
+    return uwb.anchorSendDataSync(_peer, length, frame, nullptr);
+}
+
+int RYUW122Transfer::schedulerPayload(uint8_t index, const char* tagAddress, char* data, void* context) {
+    (void)index;
+    RYUW122Transfer* transfer = static_cast<RYUW122Transfer*>(context);
+    if (transfer->_peer[0] == '\0' || strncmp(tagAddress, transfer->_peer, 8) != 0) return -1;
+    uint8_t length = transfer->nextFrame(data);
+    return length > 0 ? length : -1;
+}
+
+bool RYUW122Transfer::tagReply(RYUW122& uwb, const char* data, int length) {
+    if (data) handleFrame(data, length);
+    char frame[RYUW122_MAX_PAYLOAD_LENGTH + 1];
+    uint8_t frameLength = nextFrame(frame);
+    if (frameLength == 0) return true; // the current reply stays
+    return uwb.tagSendData(frameLength, frame);
+}
@@ -0,0 +1,214 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Segmented transfer of messages larger than 12 bytes over the RYUW122 ranging exchanges
+ */
+
+#ifndef RYUW122_TRANSFER_H
+#define RYUW122_TRANSFER_H
+
+#include "RYUW122.h"
+#include "RYUW122Payload.h"
+
+// Message bytes carried by each fragment (8 characters of the 12)
+#define RYUW122_TRANSFER_FRAGMENT_BYTES 6
+// Fragments of a message: up to 384 bytes
+#define RYUW122_TRANSFER_MAX_FRAGMENTS 64
+#define RYUW122_TRANSFER_MAX_LENGTH (RYUW122_TRANSFER_FRAGMENT_BYTES * RYUW122_TRANSFER_MAX_FRAGMENTS)
+// Fragments in flight; also the reach of the selective acknowledgements
+#define RYUW122_TRANSFER_MAX_WINDOW 12
+// First character of every transfer frame, which tells them from the other payloads
+#define RYUW122_TRANSFER_MARKER '~'
+
+/**
+ * @brief State of a RYUW122Transfer.
+ */
+enum class RYUW122TransferState {
+    IDLE,      ///< Nothing to send or receive
+    SENDING,   ///< send(): fragments go out until the peer confirms the whole message
+    RECEIVING, ///< receive(): fragments are reassembled into the buffer
+    COMPLETE,  ///< The last message was sent and confirmed, or received whole
+    FAILED     ///< No progress for setMaxIdleExchanges() exchanges, or the message does not fit the buffer
+};
+
+/**
+ * @brief Figures of the current (or last) transfer.
+ */
+struct RYUW122TransferStats {
+    uint16_t bytes;           ///< Message length (received so far while receiving)
+    uint8_t fragments;        ///< Fragments of the message
+    uint16_t framesSent;      ///< Frames handed to the link: fragments and retransmissions, or acknowledgements
+    uint16_t framesReceived;  ///< Frames of this transfer received from the peer
+    uint16_t retransmissions; ///< Fragments sent again
+    uint16_t duplicates;      ///< Fragments received more than once
+    unsigned long elapsed;    ///< Milliseconds from the first frame to the end (or to now)
+    float throughput;         ///< Message bytes per second over elapsed
+};
+
+// Called when a transfer ends (COMPLETE or FAILED)
+typedef void (*TransferCompleteCallback)(RYUW122TransferState state, uint16_t length, void* context);
+
+/**
+ * @class RYUW122Transfer
+ * @brief Sends and receives messages of up to 384 bytes, 6 bytes per ranging exchange.
+ *
+ * Each AT+ANCHOR_SEND carries a frame from the ANCHOR to the TAG (+TAG_RCV), and its
+ * +ANCHOR_RCV brings back the frame the TAG set with its last AT+TAG_SEND. A transfer uses
+ * these exchanges as its transport, in either direction:
+ *  - DATA frames carry a 6-bit fragment number and 6 bytes, packed in URL-safe base64;
+ *  - ACK frames carry the fragments received in order plus a bitmap of the next 12
+ *    (selective acknowledgement), DONE frames confirm the whole message;
+ *  - up to setWindow() fragments are in flight. A fragment is sent again as soon as one sent
+ *    after it is acknowledged, and when the window is full the oldest one is sent again.
+ *
+ * Frames start with '~': other payloads are ignored, so a transfer can share the exchanges of
+ * the ranging. The answer to a frame travels in the next exchange (the TAG answers with the
+ * data it set before), which is what the window hides.
+ *
+ * ANCHOR side: the object is a range listener and takes the frames of its TAG from any
+ * +ANCHOR_RCV. The exchanges come from exchange() (blocking) or from the ranging scheduler:
+ * @code
+ * RYUW122Transfer transfer("T1T1T1T1");
+ * uwb.addRangeListener(&transfer);
+ * ranging.onPayload(RYUW122Transfer::schedulerPayload, &transfer);
+ * transfer.send(config, sizeof(config));   // or transfer.receive(buffer, sizeof(buffer))
+ * @endcode
+ *
+ * TAG side: every +TAG_RCV goes to tagReply(), which sets the data of the next reply:
+ * @code
+ * void onTagReceive(int length, const char* data, int rssi) { transfer.tagReply(uwb, data, length); }
+ * ...
+ * transfer.send(record, sizeof(record));
+ * transfer.tagReply(uwb);                   // first fragment ready for the next poll
+ * @endcode
+ *
+ * The data given to send() and the buffer given to receive() must stay valid until the end
+ * of the transfer; nothing is copied or allocated.
+ */
+class RYUW122Transfer : public RYUW122RangeListener {
+public:
+    /**
+     * @param peerAddress On the ANCHOR, the TAG of the transfer (8 bytes ASCII); unused on the TAG.
+     */
+    explicit RYUW122Transfer(const char* peerAddress = nullptr);
+
+    void setPeer(const char* peerAddress);
+    const char* getPeer() const { return _peer; }
+
+    /**
+     * @brief Fragments in flight, 1 to RYUW122_TRANSFER_MAX_WINDOW (default 4).
+     */
+    void setWindow(uint8_t window);
+
+    /**
+     * @brief Frames sent without progress before the transfer fails (default 64, 0 = never).
+     */
+    void setMaxIdleExchanges(uint16_t exchanges) { _maxIdle = exchanges; }
+
+    /**
+     * @brief Starts sending a message.
+     * @return False if the length is 0 or above RYUW122_TRANSFER_MAX_LENGTH.
+     */
+    bool send(const uint8_t* data, uint16_t length);
+
+    /**
+     * @brief Waits for a message from the peer and reassembles it into buffer.
+     */
+    bool receive(uint8_t* buffer, uint16_t size);
+
+    /**
+     * @brief Abandons the transfer in progress (no callback).
+     */
+    void cancel();
+
+    RYUW122TransferState getState() const { return _state; }
+
+    /**
+     * @brief Gets the length of the message received (valid once COMPLETE).
+     */
+    uint16_t getLength() const { return _length; }
+
+    RYUW122TransferStats getStats() const;
+
+    void onComplete(TransferCompleteCallback callback, void* context = nullptr);
+
+    /**
+     * @brief Handles a frame received from the peer.
+     * @return False if the data is not a frame of this transfer.
+     */
+    bool handleFrame(const char* data, int length);
+
+    /**
+     * @brief Builds the frame to send to the peer in the next exchange.
+     * @param out At least RYUW122_MAX_PAYLOAD_LENGTH + 1 characters (null terminated).
+     * @return The frame length, 0 if there is nothing to send.
+     */
+    uint8_t nextFrame(char* out);
+
+    // ----- ANCHOR side -----
+
+    void onRange(const RYUW122Frame& frame, unsigned long timestampUs) override;
+
+    /**
+     * @brief One blocking AT+ANCHOR_SEND with the next frame; the answer arrives through onRange().
+     * @return False if the TAG did not answer.
+     */
+    bool exchange(RYUW122& uwb);
+
+    /**
+     * @brief RangingPayloadCallback for RYUW122RangingScheduler::onPayload() (context: the transfer).
+     */
+    static int schedulerPayload(uint8_t index, const char* tagAddress, char* data, void* context);
+
+    // ----- TAG side -----
+
+    /**
+     * @brief Handles the data of a +TAG_RCV (if any) and sets the next reply with AT+TAG_SEND.
+     * @return False if the AT+TAG_SEND failed.
+     */
+    bool tagReply(RYUW122& uwb, const char* data = nullptr, int length = 0);
+
+private:
+    enum FrameType : uint8_t { FRAME_DATA = 0, FRAME_LAST = 1, FRAME_ACK = 2, FRAME_DONE = 3 };
+
+    void handleData(uint8_t id, uint8_t index, bool last, RYUW122PayloadBits& bits, uint8_t bytes);
+    void handleAck(uint8_t id, uint8_t cumulative, uint16_t selective);
+    uint8_t sendFragment(char* out, uint8_t index, bool retransmission);
+    uint8_t writeFrame(char* out, RYUW122PayloadBits& bits);
+    bool isAcked(uint8_t index) const { return _bitmap[index >> 3] & (1 << (index & 7)); }
+    void setAcked(uint8_t index) { _bitmap[index >> 3] |= (uint8_t)(1 << (index & 7)); }
+    void progress();
+    void finish(RYUW122TransferState state);
+
+    char _peer[9];
+    RYUW122TransferState _state = RYUW122TransferState::IDLE;
+    bool _sender = false;
+    uint8_t _id = 0;                // transfer id (4 bits), changed by each send()
+    uint8_t _window = 4;
+    uint16_t _maxIdle = 64;
+    uint16_t _idle = 0;             // frames sent since the last progress
+
+    const uint8_t* _txData = nullptr;
+    uint8_t* _rxBuffer = nullptr;
+    uint16_t _size = 0;             // receive buffer size
+    uint16_t _length = 0;           // message length
+    uint8_t _fragments = 0;         // fragments of the message (receiver: 0 until the last one is seen)
+    uint8_t _bitmap[RYUW122_TRANSFER_MAX_FRAGMENTS / 8]; // fragments acknowledged (sender) or received (receiver)
+    uint8_t _base = 0;              // first fragment not acknowledged / not received
+    uint8_t _nextNew = 0;           // sender: first fragment never sent
+    uint16_t _sendSeq = 0;          // sender: frames sent, orders the fragments in flight
+    uint16_t _sentAt[RYUW122_TRANSFER_MAX_WINDOW];
+    bool _started = false;          // receiver: a fragment of this transfer was received
+    int16_t _doneId = -1;           // receiver: last transfer completed, confirmed again if the peer insists
+    uint8_t _doneFragments = 0;
+
+    RYUW122TransferStats _stats;
+    unsigned long _startTime = 0;
+    unsigned long _endTime = 0;
+
+    TransferCompleteCallback _completeCallback = nullptr;
+    void* _completeContext = nullptr;
+};
+
+#endif // RYUW122_TRANSFER_H
@@ -0,0 +1,110 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * RYUW122 driver bound to its serial transport at compile time
+ */
+
+#ifndef RYUW122_TRANSPORT_H
+#define RYUW122_TRANSPORT_H
+
+#include "RYUW122.h"
+
+/**
+ * @brief Byte I/O of RYUW122T on a transport type.
+ *
+ * The calls are qualified with the transport type, so they are direct calls (inlined when
+ * the transport defines them in its header) instead of the virtual calls of Stream. A
+ * transport with a bulk copy (a DMA ring, a memory buffer) specializes the traits:
+ * @code
+ * template <>
+ * struct RYUW122TransportTraits<MyDmaSerial> {
+ *     static int readAvailable(MyDmaSerial& transport, uint8_t* buffer, int size) { return transport.copyOut(buffer, size); }
+ *     static void writeCommand(MyDmaSerial& transport, const char* command) { transport.send(command); transport.send("\r\n"); }
+ * };
+ * @endcode
+ */
+template <class TransportT>
+struct RYUW122TransportTraits {
+    /**
+     * @brief Moves up to size bytes already received into buffer; never waits.
+     */
+    static int readAvailable(TransportT& transport, uint8_t* buffer, int size) {
+        int count = transport.TransportT::available();
+        if (count > size) count = size;
+        for (int i = 0; i < count; i++) {
+            int c = transport.TransportT::read();
+            if (c < 0) return i;
+            buffer[i] = (uint8_t)c;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Writes a command followed by CRLF.
+     */
+    static void writeCommand(TransportT& transport, const char* command) {
+        while (*command) transport.TransportT::write((uint8_t)*command++);
+        transport.TransportT::write((uint8_t)'\r');
+        transport.TransportT::write((uint8_t)'\n');
+    }
+};
+
+#if defined(ESP32)
+// The ESP32 UART driver copies whole blocks out of (and into) its ring buffers
+template <>
+struct RYUW122TransportTraits<HardwareSerial> {
+    static int readAvailable(HardwareSerial& transport, uint8_t* buffer, int size) {
+        int count = transport.HardwareSerial::available();
+        if (count > size) count = size;
+        return count > 0 ? (int)transport.HardwareSerial::read(buffer, (size_t)count) : 0;
+    }
+
+    static void writeCommand(HardwareSerial& transport, const char* command) {
+        transport.HardwareSerial::write((const uint8_t*)command, strlen(command));
+        transport.HardwareSerial::write((const uint8_t*)"\r\n", 2);
+    }
+};
+#endif
+
+/**
+ * @class RYUW122T
+ * @brief RYUW122 driver whose byte I/O is bound to the transport type at compile time.
+ *
+ * RYUW122 reaches the module through Stream: each received byte costs two virtual calls
+ * (available() and read()) that the compiler cannot inline. RYUW122T<TransportT> reads the
+ * transport through RYUW122TransportTraits<TransportT>, a chunk of RYUW122_RX_CHUNK_SIZE bytes
+ * per virtual call: the commands, the parsing and the callbacks are the ones of RYUW122, which
+ * stays the type-erased interface (a RYUW122T can be passed wherever a RYUW122& is expected).
+ * @code
+ * RYUW122T<HardwareSerial> uwb(&Serial2, 4, RYUW122BaudRate::B_115200);
+ * RYUW122RangingScheduler ranging(uwb);
+ * @endcode
+ *
+ * TransportT must derive from Stream and must not be Stream itself. The constructor takes the
+ * transport followed by the arguments of the RYUW122 constructor for that type (reset pin,
+ * node indicator pin, baud rate); the rate of a transport that is neither HardwareSerial nor
+ * SoftwareSerial is left to the application, as with RYUW122(Stream*).
+ */
+template <class TransportT>
+class RYUW122T : public RYUW122 {
+public:
+    template <typename... Args>
+    explicit RYUW122T(TransportT* transport, Args... args) : RYUW122(transport, args...), _transport(*transport) {}
+
+    TransportT& transport() { return _transport; }
+
+protected:
+    int readAvailable(uint8_t* buffer, int size) override {
+        return RYUW122TransportTraits<TransportT>::readAvailable(_transport, buffer, size);
+    }
+
+    void writeCommand(const char* command) override {
+        RYUW122TransportTraits<TransportT>::writeCommand(_transport, command);
+    }
+
+private:
+    TransportT& _transport;
+};
+
+#endif // RYUW122_TRANSPORT_H
@@ -0,0 +1,123 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * RYUW122 enum descriptions: flash-resident lookup tables
+ */
+
+#include "RYUW122.h"
+
+// Each table is indexed by the value of its enum and ends with the text of the invalid values.
+// On AVR both the texts and the tables stay in flash (PROGMEM); elsewhere PROGMEM is a no-op.
+
+static const char TEXT_ERR_NONE[] PROGMEM = "No error";
+static const char TEXT_ERR_CRLF[] PROGMEM = "Missing carriage return or line feed";
+static const char TEXT_ERR_HEADER[] PROGMEM = "Command does not start with 'AT'";
+static const char TEXT_ERR_PARAMETER[] PROGMEM = "Parameter failure";
+static const char TEXT_ERR_COMMAND[] PROGMEM = "Command failure";
+static const char TEXT_ERR_UNKNOWN_COMMAND[] PROGMEM = "Unknown command";
+static const char TEXT_ERR_INVALID[] PROGMEM = "Invalid error code";
+static const char TEXT_ERR_UNKNOWN[] PROGMEM = "Unknown error code";
+static const char* const ERROR_CODE_TEXTS[] PROGMEM = {
+    TEXT_ERR_NONE, TEXT_ERR_CRLF, TEXT_ERR_HEADER, TEXT_ERR_PARAMETER, TEXT_ERR_COMMAND,
+    TEXT_ERR_UNKNOWN_COMMAND, TEXT_ERR_INVALID
+};
+
+static const char TEXT_MODE_TAG[] PROGMEM = "TAG (mobile) mode";
+static const char TEXT_MODE_ANCHOR[] PROGMEM = "ANCHOR (fixed) mode";
+static const char TEXT_MODE_SLEEP[] PROGMEM = "SLEEP mode";
+static const char TEXT_MODE_UNKNOWN[] PROGMEM = "Unknown mode";
+static const char* const MODE_TEXTS[] PROGMEM = {
+    TEXT_MODE_TAG, TEXT_MODE_ANCHOR, TEXT_MODE_SLEEP, TEXT_MODE_UNKNOWN
+};
+
+static const char TEXT_BAUD_9600[] PROGMEM = "9600 bps";
+static const char TEXT_BAUD_57600[] PROGMEM = "57600 bps";
+static const char TEXT_BAUD_115200[] PROGMEM = "115200 bps";
+static const char TEXT_BAUD_UNKNOWN[] PROGMEM = "Unknown baud rate";
+static const char* const BAUD_RATE_TEXTS[] PROGMEM = {
+    TEXT_BAUD_9600, TEXT_BAUD_57600, TEXT_BAUD_115200, TEXT_BAUD_UNKNOWN
+};
+
+static const char TEXT_CHANNEL_5[] PROGMEM = "Channel 5 (6489.6 MHz)";
+static const char TEXT_CHANNEL_9[] PROGMEM = "Channel 9 (7987.2 MHz)";
+static const char TEXT_CHANNEL_UNKNOWN[] PROGMEM = "Unknown RF channel";
+static const char* const RF_CHANNEL_TEXTS[] PROGMEM = {
+    TEXT_CHANNEL_5, TEXT_CHANNEL_9, TEXT_CHANNEL_UNKNOWN
+};
+
+static const char TEXT_BW_850K[] PROGMEM = "850 Kbps";
+static const char TEXT_BW_6_8M[] PROGMEM = "6.8 Mbps";
+static const char TEXT_BW_UNKNOWN[] PROGMEM = "Unknown bandwidth";
+static const char* const BANDWIDTH_TEXTS[] PROGMEM = {
+    TEXT_BW_850K, TEXT_BW_6_8M, TEXT_BW_UNKNOWN
+};
+
+static const char TEXT_POWER_N65[] PROGMEM = "-65 dBm";
+static const char TEXT_POWER_N50[] PROGMEM = "-50 dBm";
+static const char TEXT_POWER_N45[] PROGMEM = "-45 dBm";
+static const char TEXT_POWER_N40[] PROGMEM = "-40 dBm";
+static const char TEXT_POWER_N35[] PROGMEM = "-35 dBm";
+static const char TEXT_POWER_N32[] PROGMEM = "-32 dBm";
+static const char TEXT_POWER_UNKNOWN[] PROGMEM = "Unknown RF power";
+static const char* const RF_POWER_TEXTS[] PROGMEM = {
+    TEXT_POWER_N65, TEXT_POWER_N50, TEXT_POWER_N45, TEXT_POWER_N40, TEXT_POWER_N35, TEXT_POWER_N32,
+    TEXT_POWER_UNKNOWN
+};
+
+static const char TEXT_RSSI_DISABLE[] PROGMEM = "RSSI display disabled";
+static const char TEXT_RSSI_ENABLE[] PROGMEM = "RSSI display enabled";
+static const char TEXT_RSSI_UNKNOWN[] PROGMEM = "Unknown RSSI setting";
+static const char* const RSSI_TEXTS[] PROGMEM = {
+    TEXT_RSSI_DISABLE, TEXT_RSSI_ENABLE, TEXT_RSSI_UNKNOWN
+};
+
+// Index of value in a table of count valid entries followed by the invalid text
+static constexpr uint8_t textIndex(int value, uint8_t count) {
+    return value >= 0 && value < count ? (uint8_t)value : count;
+}
+
+static constexpr uint8_t baudRateIndex(int32_t value) {
+    return value == 9600 ? 0 : value == 57600 ? 1 : value == 115200 ? 2 : 3;
+}
+
+static const __FlashStringHelper* flashText(const char* const* table, uint8_t index) {
+    return reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&table[index]));
+}
+
+const __FlashStringHelper* RYUW122ErrorCode_descriptionF(RYUW122ErrorCode code) {
+    return flashText(ERROR_CODE_TEXTS, textIndex((int)code, 6));
+}
+
+const __FlashStringHelper* RYUW122ErrorCode_descriptionFromValueF(uint8_t code) {
+    if (code >= 1 && code <= 5) return flashText(ERROR_CODE_TEXTS, code);
+    return reinterpret_cast<const __FlashStringHelper*>(TEXT_ERR_UNKNOWN);
+}
+
+const __FlashStringHelper* RYUW122Mode_descriptionF(RYUW122Mode mode) {
+    return flashText(MODE_TEXTS, textIndex((int)mode, 3));
+}
+
+const __FlashStringHelper* RYUW122BaudRate_descriptionF(RYUW122BaudRate baudRate) {
+    return flashText(BAUD_RATE_TEXTS, baudRateIndex((int32_t)baudRate));
+}
+
+const __FlashStringHelper* RYUW122BaudRate_descriptionFromValueF(int32_t value) {
+    return flashText(BAUD_RATE_TEXTS, baudRateIndex(value));
+}
+
+const __FlashStringHelper* RYUW122RFChannel_descriptionF(RYUW122RFChannel channel) {
+    return flashText(RF_CHANNEL_TEXTS, channel == RYUW122RFChannel::CH_5 ? 0 : channel == RYUW122RFChannel::CH_9 ? 1 : 2);
+}
+
+const __FlashStringHelper* RYUW122Bandwidth_descriptionF(RYUW122Bandwidth bandwidth) {
+    return flashText(BANDWIDTH_TEXTS, textIndex((int)bandwidth, 2));
+}
+
+const __FlashStringHelper* RYUW122RFPower_descriptionF(RYUW122RFPower power) {
+    return flashText(RF_POWER_TEXTS, textIndex((int)power, 6));
+}
+
+const __FlashStringHelper* RYUW122RSSI_descriptionF(RYUW122RSSI rssi) {
+    return flashText(RSSI_TEXTS, textIndex((int)rssi, 2));
+}
@@ -133,25 +133,26 @@ void setup() {
     delay(500);
 
     // Test 5: Set and verify mode
+    // (the getters are called with forceRefresh: verify against the module, not the settings cache)
     Serial.println(F("\nTest 5: Set Operating Mode (TAG)"));
     bool setModeResult = uwb.setMode(RYUW122Mode::TAG);
     printTestResult("Set Mode", setModeResult);
 
-    RYUW122Mode currentMode = uwb.getMode();
+    RYUW122Mode currentMode = uwb.getMode(true);
     bool verifyModeResult = (currentMode == RYUW122Mode::TAG);
     printTestResult("Verify Mode", verifyModeResult);
     if (verifyModeResult) {
         Serial.print(F("  Current Mode: "));
-        Serial.println(RYUW122Mode_description(currentMode));
+        Serial.println(RYUW122Mode_descriptionF(currentMode));
     }
 
     delay(500);
 
     // Test 6: Set and verify baud rate
     Serial.println(F("\nTest 6: Verify Baud Rate"));
-    RYUW122BaudRate currentBaud = uwb.getBaudRate();
+    RYUW122BaudRate currentBaud = uwb.getBaudRate(true);
     Serial.print(F("  Current Baud Rate: "));
-    Serial.println(RYUW122BaudRate_description(currentBaud));
+    Serial.println(RYUW122BaudRate_descriptionF(currentBaud));
 
     delay(500);
 
@@ -160,12 +161,12 @@ void setup() {
     bool setChannelResult = uwb.setRfChannel(RYUW122RFChannel::CH_5);
     printTestResult("Set RF Channel", setChannelResult);
 
-    RYUW122RFChannel currentChannel = uwb.getRfChannel();
+    RYUW122RFChannel currentChannel = uwb.getRfChannel(true);
     bool verifyChannelResult = (currentChannel == RYUW122RFChannel::CH_5);
     printTestResult("Verify RF Channel", verifyChannelResult);
     if (verifyChannelResult) {
         Serial.print(F("  Current Channel: "));
-        Serial.println(RYUW122RFChannel_description(currentChannel));
+        Serial.println(RYUW122RFChannel_descriptionF(currentChannel));
     }
 
     delay(500);
@@ -175,12 +176,12 @@ void setup() {
     bool setBandwidthResult = uwb.setBandwidth(RYUW122Bandwidth::BW_850K);
     printTestResult("Set Bandwidth", setBandwidthResult);
 
-    RYUW122Bandwidth currentBandwidth = uwb.getBandwidth();
+    RYUW122Bandwidth currentBandwidth = uwb.getBandwidth(true);
     bool verifyBandwidthResult = (currentBandwidth == RYUW122Bandwidth::BW_850K);
     printTestResult("Verify Bandwidth", verifyBandwidthResult);
     if (verifyBandwidthResult) {
         Serial.print(F("  Current Bandwidth: "));
-        Serial.println(RYUW122Bandwidth_description(currentBandwidth));
+        Serial.println(RYUW122Bandwidth_descriptionF(currentBandwidth));
     }
 
     delay(500);
@@ -192,7 +193,7 @@ void setup() {
     printTestResult("Set Network ID", setNetworkResult);
 
     char currentNetworkId[16];
-    bool getNetworkResult = uwb.getNetworkId(currentNetworkId);
+    bool getNetworkResult = uwb.getNetworkId(currentNetworkId, true);
     printTestResult("Get Network ID", getNetworkResult);
     if (getNetworkResult) {
         Serial.print(F("  Network ID: "));
@@ -208,7 +209,7 @@ void setup() {
     printTestResult("Set Address", setAddressResult);
 
     char currentAddress[16];
-    bool getAddressResult = uwb.getAddress(currentAddress);
+    bool getAddressResult = uwb.getAddress(currentAddress, true);
     printTestResult("Get Address", getAddressResult);
     if (getAddressResult) {
         Serial.print(F("  Address: "));
@@ -222,12 +223,12 @@ void setup() {
     bool setPowerResult = uwb.setRfPower(RYUW122RFPower::N32dBm);
     printTestResult("Set RF Power", setPowerResult);
 
-    RYUW122RFPower currentPower = uwb.getRfPower();
+    RYUW122RFPower currentPower = uwb.getRfPower(true);
     bool verifyPowerResult = (currentPower == RYUW122RFPower::N32dBm);
     printTestResult("Verify RF Power", verifyPowerResult);
     if (verifyPowerResult) {
         Serial.print(F("  RF Power: "));
-        Serial.println(RYUW122RFPower_description(currentPower));
+        Serial.println(RYUW122RFPower_descriptionF(currentPower));
     }
 
     delay(500);
@@ -237,12 +238,12 @@ void setup() {
     bool setRssiResult = uwb.setRssiDisplay(RYUW122RSSI::ENABLE);
     printTestResult("Set RSSI Display", setRssiResult);
 
-    RYUW122RSSI currentRssi = uwb.getRssiDisplay();
+    RYUW122RSSI currentRssi = uwb.getRssiDisplay(true);
     bool verifyRssiResult = (currentRssi == RYUW122RSSI::ENABLE);
     printTestResult("Verify RSSI Display", verifyRssiResult);
     if (verifyRssiResult) {
         Serial.print(F("  RSSI Display: "));
-        Serial.println(RYUW122RSSI_description(currentRssi));
+        Serial.println(RYUW122RSSI_descriptionF(currentRssi));
     }
 
     delay(500);
@@ -252,7 +253,7 @@ void setup() {
     bool setCalResult = uwb.setDistanceCalibration(0);
     printTestResult("Set Calibration", setCalResult);
 
-    int currentCal = uwb.getDistanceCalibration();
+    int currentCal = uwb.getDistanceCalibration(true);
     Serial.print(F("  Calibration Value: "));
     Serial.print(currentCal);
     Serial.println(F(" cm"));
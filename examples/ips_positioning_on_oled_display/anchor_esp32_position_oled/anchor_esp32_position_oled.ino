@@ -5,10 +5,10 @@
  * @version 1.0.0
  * @date 2025-11-24
  *
- * This sketch configures the esp32 as a MASTER/ANCHOR (mobile) that sequentially
- * polls three fixed anchors, collects distances returned by them and computes
- * the device (mobile) position by trilateration. Results are shown on the OLED
- * and sent to Serial.
+ * This sketch configures the esp32 as a MASTER/ANCHOR (mobile) that polls three
+ * fixed anchors back to back with RYUW122RangingScheduler, collects distances
+ * returned by them and computes the device (mobile) position by trilateration.
+ * Results are shown on the OLED and sent to Serial.
  *
  * Hardware connections:
  * - RYUW122 TX -> GPIO18 (RX2) -- ensure this pin does NOT conflict with OLED RST
@@ -29,6 +29,9 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
 #include <RYUW122.h>
+#include <RYUW122RangingScheduler.h>
+#include <RYUW122DistanceFilter.h>
+#include <RYUW122Positioning.h>
 
 // OLED pin definitions
 #ifndef SDA_OLED
@@ -76,23 +79,19 @@ double anchorDistances[3] = { 0.0, 0.0, 0.0 };
 bool anchorHave[3] = { false, false, false };
 unsigned long anchorTimestamps[3] = {0,0,0};
 
-// Filtering buffers
-#define MEDIAN_WINDOW 3
-double distBuffers[3][MEDIAN_WINDOW];
-int distIdx[3] = {0,0,0};
-int sampleCount[3] = {0,0,0};
-double smoothedDistances[3] = {0.0,0.0,0.0};
-const double SMOOTH_ALPHA = 0.6; // exponential smoothing alpha (increased for faster response)
+// Filtering, done by the library on every measurement: 3-sample median to drop outliers,
+// then exponential smoothing with alpha 0.6 (60% weight to the new sample, for a fast response)
+RYUW122DistanceFilter<3, RYUW122MedianFilter<3>, RYUW122EmaFilter<60> > filter;
 
-// Trilateration result
+// Trilateration
+RYUW122Positioning positioning;
 double estimatedX = 0.0;
 double estimatedY = 0.0;
 bool havePosition = false;
 
-// Polling state
-int pollIndex = 0;
-unsigned long lastPollTime = 0;
-const unsigned long SEND_INTERVAL = 250; // poll every 250ms -> each tag ~750ms (faster updates)
+// Polling: each tag is polled as soon as the previous exchange has finished
+RYUW122RangingScheduler ranging(uwb);
+const unsigned long POLL_TIMEOUT = 500; // ms to wait for a tag before moving to the next one
 
 // Display / statistics
 unsigned long packetsReceived = 0;
@@ -100,8 +99,8 @@ unsigned long packetsReceived = 0;
 // Function declarations
 void updateDisplay();
 void onAnchorDataReceived(const char* tagAddress, int payloadLength, const char* data, int distanceCm, int rssi);
+void onRangingResult(const RYUW122RangingResult& result, void* context);
 bool tryTrilateration();
-double medianOfBuffer(double *buf, int len);
 
 // Draw map and status on OLED
 void updateDisplay() {
@@ -197,21 +196,10 @@ void onAnchorDataReceived(const char* tagAddress, int payloadLength, const char*
   }
 
   double dist_m = (double)distanceCm / 100.0; // cm -> meters
-  // push into circular buffer
-  distBuffers[idx][ distIdx[idx] ] = dist_m;
-  distIdx[idx] = (distIdx[idx] + 1) % MEDIAN_WINDOW;
-  if (sampleCount[idx] < MEDIAN_WINDOW) sampleCount[idx]++;
-
-  // compute median using only valid samples
-  double median = medianOfBuffer(distBuffers[idx], sampleCount[idx]);
-  // exponential smoothing (use previous smoothed value, but if first sample use median directly)
-  if (sampleCount[idx] == 1 && smoothedDistances[idx] <= 0.0) {
-    smoothedDistances[idx] = median; // initialize smoothing to first median
-  } else {
-    smoothedDistances[idx] = SMOOTH_ALPHA * median + (1.0 - SMOOTH_ALPHA) * smoothedDistances[idx];
-  }
+  // the filter has already processed this measurement (listeners are fed before the callbacks)
+  double filtered_m = (double)filter.getDistance(targetTagAddresses[idx]) / 100.0;
 
-  anchorDistances[idx] = smoothedDistances[idx];
+  anchorDistances[idx] = filtered_m;
   anchorHave[idx] = true;
   anchorTimestamps[idx] = millis();
   packetsReceived++;
@@ -220,9 +208,9 @@ void onAnchorDataReceived(const char* tagAddress, int payloadLength, const char*
   Serial.print(F("From Tag/Node: ")); Serial.println(targetTagAddresses[idx]);
   Serial.print(F("Payload: ")); Serial.println(data);
   Serial.print(F("Raw distance: ")); Serial.print(dist_m, 3); Serial.println(F(" m"));
-  Serial.print(F("Median: ")); Serial.print(median,3); Serial.println(F(" m"));
-  Serial.print(F("Smoothed: ")); Serial.print(smoothedDistances[idx],3); Serial.println(F(" m"));
+  Serial.print(F("Filtered: ")); Serial.print(filtered_m,3); Serial.println(F(" m"));
   Serial.print(F("RSSI: ")); Serial.print(rssi); Serial.println(F(" dBm"));
+  Serial.print(F("Update rate: ")); Serial.print(ranging.getUpdateRate(idx), 1); Serial.println(F(" Hz"));
 
   // Try compute position if we have at least three fresh distances
   if (anchorHave[0] && anchorHave[1] && anchorHave[2]) {
@@ -239,19 +227,13 @@ void onAnchorDataReceived(const char* tagAddress, int payloadLength, const char*
   updateDisplay();
 }
 
-// Helper: compute median of small buffer (copied into temp array)
-double medianOfBuffer(double *buf, int len) {
-  if (len <= 0) return 0.0;
-  double tmp[MEDIAN_WINDOW];
-  for (int i=0;i<len;i++) tmp[i] = buf[i];
-  // simple insertion sort
-  for (int i=1;i<len;i++) {
-    double v = tmp[i]; int j = i-1;
-    while (j>=0 && tmp[j] > v) { tmp[j+1] = tmp[j]; j--; }
-    tmp[j+1] = v;
+// Scheduler callback: one call per exchange, answered or not
+void onRangingResult(const RYUW122RangingResult& result, void* context) {
+  if (!result.success) {
+    Serial.print(F("\n[MASTER] No answer from Tag/Node: ")); Serial.println(result.tagAddress);
+    return;
   }
-  if (len % 2 == 1) return tmp[len/2];
-  return (tmp[len/2 - 1] + tmp[len/2]) / 2.0;
+  onAnchorDataReceived(result.tagAddress, result.payloadLength, result.data, result.distance, result.rssi);
 }
 
 void setup() {
@@ -277,8 +259,8 @@ void setup() {
   // Initialize arrays and default buffers
   for (int i=0;i<3;i++) {
     anchorHave[i]=false; anchorDistances[i]=0.0; anchorTimestamps[i]=0;
-    smoothedDistances[i]=0.0; distIdx[i]=0; sampleCount[i]=0;
-    for (int j=0;j<MEDIAN_WINDOW;j++) distBuffers[i][j] = 0.0;
+    filter.addTag(targetTagAddresses[i]);
+    positioning.addAnchor(targetTagAddresses[i], anchorPositions[i].x, anchorPositions[i].y);
   }
   havePosition = false;
 
@@ -308,8 +290,12 @@ void setup() {
   uwb.setAddress(MASTER_ADDRESS);
   Serial.print(F("Master Address: ")); Serial.println(MASTER_ADDRESS);
 
-  // Register callback that receives +ANCHOR_RCV
-  uwb.onAnchorReceive(onAnchorDataReceived);
+  // Poll the tags back to back; the scheduler delivers each +ANCHOR_RCV to the callback
+  for (int i=0;i<3;i++) ranging.addTag(targetTagAddresses[i]);
+  ranging.setPayload("POLL");
+  ranging.setTimeout(POLL_TIMEOUT);
+  ranging.onResult(onRangingResult);
+  uwb.addRangeListener(&filter);
   Serial.println(F("Callback registered"));
 
   // Final display
@@ -321,47 +307,21 @@ void setup() {
   display.print(F("Addr: ")); display.println(MASTER_ADDRESS);
   display.display();
 
-  lastPollTime = millis();
+  ranging.start();
 }
 
 void loop() {
-  // Poll next anchor periodically
-  if (millis() - lastPollTime >= SEND_INTERVAL) {
-    const char* payload = "POLL";
-    const char* target = targetTagAddresses[pollIndex];
-    Serial.print(F("\n[MASTER] Polling Tag/Node: ")); Serial.println(target);
-    uwb.anchorSendData(target, strlen(payload), payload);
-    pollIndex = (pollIndex + 1) % 3;
-    lastPollTime = millis();
-  }
-
-  // Process incoming data and trigger callbacks
-  uwb.loop();
-
-  delay(10);
+  // Process incoming data, trigger callbacks and poll the next tag
+  ranging.loop();
 }
 
-// Simple 2D trilateration using three circle intersections (linearized form)
+// Least-squares position from the library solver, fed with the filtered distances
 bool tryTrilateration() {
-  double x1 = anchorPositions[0].x; double y1 = anchorPositions[0].y; double r1 = anchorDistances[0];
-  double x2 = anchorPositions[1].x; double y2 = anchorPositions[1].y; double r2 = anchorDistances[1];
-  double x3 = anchorPositions[2].x; double y3 = anchorPositions[2].y; double r3 = anchorDistances[2];
-
-  if (r1 <= 0 || r2 <= 0 || r3 <= 0) return false;
-
-  double A = 2*(x2 - x1);
-  double B = 2*(y2 - y1);
-  double C = r1*r1 - r2*r2 - x1*x1 + x2*x2 - y1*y1 + y2*y2;
-
-  double D = 2*(x3 - x2);
-  double E = 2*(y3 - y2);
-  double F = r2*r2 - r3*r3 - x2*x2 + x3*x3 - y2*y2 + y3*y3;
-
-  double denom = A*E - B*D;
-  if (fabs(denom) < 1e-9) return false;
-
-  double x = (C*E - B*F) / denom;
-  double y = (A*F - C*D) / denom;
-
-  estimatedX = x; estimatedY = y; return true;
+  for (int i=0;i<3;i++) positioning.setRange(targetTagAddresses[i], anchorDistances[i]);
+  if (!positioning.solve()) return false;
+  const RYUW122Position& position = positioning.getPosition();
+  estimatedX = position.x; estimatedY = position.y;
+  Serial.print(F("Residual: ")); Serial.print(position.residual, 3);
+  Serial.print(F(" m, GDOP: ")); Serial.println(position.gdop, 2);
+  return true;
 }
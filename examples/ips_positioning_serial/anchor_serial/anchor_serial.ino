@@ -5,14 +5,16 @@
  * @version 1.0.0
  * @date 2025-11-28
  *
- * This sketch configures the MCU as a MASTER/ANCHOR (mobile) that sequentially
- * polls three fixed anchors, collects distances returned by them and computes
- * the device (mobile) position by trilateration. Results are printed to Serial.
- * Optional ASCII-art map can be toggled.
+ * This sketch configures the MCU as a MASTER/ANCHOR (mobile) that polls three
+ * fixed anchors back to back with RYUW122RangingScheduler, collects distances
+ * returned by them and computes the device (mobile) position by trilateration.
+ * Results are printed to Serial. Optional ASCII-art map can be toggled.
  */
 
 #include <Arduino.h>
 #include <RYUW122.h>
+#include <RYUW122RangingScheduler.h>
+#include <RYUW122Positioning.h>
 
 #define ASCI_MAP_ENABLE
 
@@ -58,15 +60,15 @@ double tagDistances[3] = { 0.0, 0.0, 0.0 };
 bool anchorHave[3] = { false, false, false };
 unsigned long anchorTimestamps[3] = {0,0,0};
 
-// Trilateration result
+// Trilateration: the solver takes the ranges of the nodes straight from the driver
+RYUW122Positioning positioning;
 double estimatedX = 0.0;
 double estimatedY = 0.0;
 bool havePosition = false;
 
-// Polling state
-int pollIndex = 0;
-unsigned long lastPollTime = 0;
-const unsigned long SEND_INTERVAL = 2500; // poll every 250ms -> each tag ~750ms (faster updates)
+// Polling: each tag is polled as soon as the previous exchange has finished
+RYUW122RangingScheduler ranging(uwb);
+const unsigned long POLL_TIMEOUT = 500; // ms to wait for a tag before moving to the next one
 
 // Display / statistics
 unsigned long packetsReceived = 0;
@@ -75,6 +77,7 @@ unsigned long packetsReceived = 0;
 void printStatusToSerial();
 void printAsciiMap();
 void onAnchorDataReceived(const char* tagAddress, int payloadLength, const char* data, int distanceCm, int rssi);
+void onRangingResult(const RYUW122RangingResult& result, void* context);
 bool tryTrilateration();
 
 // Print status and position to Serial (replaces OLED)
@@ -89,7 +92,8 @@ void printStatusToSerial() {
     if (anchorHave[i]) {
       Serial.print(tagDistances[i],3); Serial.print(F(" m"));
       unsigned long age = millis() - anchorTimestamps[i];
-      Serial.print(F(" (age ")); Serial.print(age); Serial.println(F(" ms)"));
+      Serial.print(F(" (age ")); Serial.print(age); Serial.print(F(" ms, "));
+      Serial.print(ranging.getUpdateRate(i), 1); Serial.println(F(" Hz)"));
     } else {
       Serial.println(F(" --"));
     }
@@ -191,6 +195,15 @@ void onAnchorDataReceived(const char* tagAddress, int payloadLength, const char*
   printStatusToSerial();
 }
 
+// Scheduler callback: one call per exchange, answered or not
+void onRangingResult(const RYUW122RangingResult& result, void* context) {
+  if (!result.success) {
+    Serial.print(F("\n[MASTER] No answer from Tag/Node: ")); Serial.println(result.tagAddress);
+    return;
+  }
+  onAnchorDataReceived(result.tagAddress, result.payloadLength, result.data, result.distance, result.rssi);
+}
+
 void setup() {
   Serial.begin(115200);
   delay(200);
@@ -199,6 +212,7 @@ void setup() {
   // Initialize arrays and default buffers
   for (int i=0;i<3;i++) {
     anchorHave[i]=false; tagDistances[i]=0.0; anchorTimestamps[i]=0;
+    positioning.addAnchor(targetTagAddresses[i], tagPositions[i].x, tagPositions[i].y);
   }
   havePosition = false;
 
@@ -227,55 +241,32 @@ void setup() {
   uwb.setAddress(MASTER_ADDRESS);
   Serial.print(F("Master Address: ")); Serial.println(MASTER_ADDRESS);
 
-  // Register callback that receives +ANCHOR_RCV
-  uwb.onAnchorReceive(onAnchorDataReceived);
+  // Poll the tags back to back; the scheduler delivers each +ANCHOR_RCV to the callback
+  for (int i=0;i<3;i++) ranging.addTag(targetTagAddresses[i]);
+  ranging.setPayload("POLL");
+  ranging.setTimeout(POLL_TIMEOUT);
+  ranging.onResult(onRangingResult);
+  uwb.addRangeListener(&positioning);
   Serial.println(F("Callback registered"));
 
   Serial.println(F("READY"));
   Serial.print(F("Net: ")); Serial.println(NETWORK_ID);
   Serial.print(F("Addr: ")); Serial.println(MASTER_ADDRESS);
 
-  lastPollTime = millis();
+  ranging.start();
 }
 
 void loop() {
-  // Poll next tag periodically
-  if (millis() - lastPollTime >= SEND_INTERVAL) {
-    const char* payload = "POLL";
-    const char* target = targetTagAddresses[pollIndex];
-    Serial.print(F("\n[MASTER] Polling Tag/Node: ")); Serial.println(target);
-    uwb.anchorSendData(target, strlen(payload), payload);
-    pollIndex = (pollIndex + 1) % 3;
-    lastPollTime = millis();
-  }
-
-  // Process incoming data and trigger callbacks
-  uwb.loop();
-
-  delay(10);
+  // Process incoming data, trigger callbacks and poll the next tag
+  ranging.loop();
 }
 
-// Simple 2D trilateration using three circle intersections (linearized form)
+// Least-squares position from the library solver (uses every node with a fresh range)
 bool tryTrilateration() {
-  double x1 = tagPositions[0].x; double y1 = tagPositions[0].y; double r1 = tagDistances[0];
-  double x2 = tagPositions[1].x; double y2 = tagPositions[1].y; double r2 = tagDistances[1];
-  double x3 = tagPositions[2].x; double y3 = tagPositions[2].y; double r3 = tagDistances[2];
-
-  if (r1 <= 0 || r2 <= 0 || r3 <= 0) return false;
-
-  double A = 2*(x2 - x1);
-  double B = 2*(y2 - y1);
-  double C = r1*r1 - r2*r2 - x1*x1 + x2*x2 - y1*y1 + y2*y2;
-
-  double D = 2*(x3 - x2);
-  double E = 2*(y3 - y2);
-  double F = r2*r2 - r3*r3 - x2*x2 + x3*x3 - y2*y2 + y3*y3;
-
-  double denom = A*E - B*D;
-  if (fabs(denom) < 1e-9) return false;
-
-  double x = (C*E - B*F) / denom;
-  double y = (A*F - C*D) / denom;
-
-  estimatedX = x; estimatedY = y; return true;
+  if (!positioning.solve()) return false;
+  const RYUW122Position& position = positioning.getPosition();
+  estimatedX = position.x; estimatedY = position.y;
+  Serial.print(F("Residual: ")); Serial.print(position.residual, 3);
+  Serial.print(F(" m, GDOP: ")); Serial.println(position.gdop, 2);
+  return true;
 }
@@ -0,0 +1,43 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Minimal Arduino core shim used by the RYUW122 host build
+ */
+
+#include "Arduino.h"
+
+#include <chrono>
+#include <thread>
+
+static const std::chrono::steady_clock::time_point _hostStart = std::chrono::steady_clock::now();
+
+HardwareSerial Serial;
+
+size_t Print::print(const String& s) { return write(s.c_str()); }
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - _hostStart).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - _hostStart).count();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+void digitalWrite(uint8_t pin, uint8_t val) { (void)pin; (void)val; }
+int digitalRead(uint8_t pin) { (void)pin; return HIGH; }
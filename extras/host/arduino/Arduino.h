@@ -0,0 +1,68 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Minimal Arduino core shim used by the RYUW122 host build
+ */
+
+#ifndef RYUW122_HOST_ARDUINO_H
+#define RYUW122_HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define SERIAL_8N1 0x800001c
+
+// Flash helpers: on the host every "flash" string is an ordinary RAM string
+#define PROGMEM
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void * const *)(addr))
+
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strstr_P strstr
+#define memcpy_P memcpy
+#define snprintf_P snprintf
+#define sprintf_P sprintf
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+
+#include "WString.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+
+#endif // RYUW122_HOST_ARDUINO_H
@@ -0,0 +1,41 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Minimal Arduino HardwareSerial shim used by the RYUW122 host build
+ */
+
+#ifndef RYUW122_HOST_HARDWARESERIAL_H
+#define RYUW122_HOST_HARDWARESERIAL_H
+
+#include "Stream.h"
+
+// Console-backed serial port: writes go to stdout, nothing is ever received.
+// Unlike the real core the methods are virtual, so host transports (the simulated
+// module, a Linux TTY) can be handed to the HardwareSerial constructors.
+class HardwareSerial : public Stream {
+public:
+    virtual void begin(unsigned long baud) { _baud = baud; }
+    virtual void begin(unsigned long baud, uint32_t config) { (void)config; begin(baud); }
+    virtual void begin(unsigned long baud, uint32_t config, int8_t rxPin, int8_t txPin) {
+        (void)rxPin; (void)txPin; begin(baud, config);
+    }
+    virtual void end() {}
+    unsigned long baudRate() const { return _baud; }
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    using Print::write;
+    void flush() override { fflush(stdout); }
+
+    explicit operator bool() const { return true; }
+
+protected:
+    unsigned long _baud = 0;
+};
+
+extern HardwareSerial Serial;
+
+#endif // RYUW122_HOST_HARDWARESERIAL_H
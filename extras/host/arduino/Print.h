@@ -0,0 +1,66 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Minimal Arduino Print shim used by the RYUW122 host build
+ */
+
+#ifndef RYUW122_HOST_PRINT_H
+#define RYUW122_HOST_PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+class __FlashStringHelper;
+class String;
+
+#define DEC 10
+#define HEX 16
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char* str) {
+        return str ? write((const uint8_t*)str, strlen(str)) : 0;
+    }
+    virtual void flush() {}
+
+    size_t print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+    size_t print(const String& s);
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) {
+        char b[24];
+        snprintf(b, sizeof(b), base == HEX ? "%lx" : "%ld", v);
+        return write(b);
+    }
+    size_t print(unsigned long v, int base = DEC) {
+        char b[24];
+        snprintf(b, sizeof(b), base == HEX ? "%lx" : "%lu", v);
+        return write(b);
+    }
+    size_t print(double v, int digits = 2) {
+        char b[40];
+        snprintf(b, sizeof(b), "%.*f", digits, v);
+        return write(b);
+    }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    template <typename T>
+    size_t println(const T& v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+};
+
+#endif // RYUW122_HOST_PRINT_H
@@ -0,0 +1,31 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Minimal Arduino SoftwareSerial shim used by the RYUW122 host build
+ */
+
+#ifndef RYUW122_HOST_SOFTWARESERIAL_H
+#define RYUW122_HOST_SOFTWARESERIAL_H
+
+#include "Stream.h"
+
+// Placeholder software serial port: it is never connected to anything on the host.
+class SoftwareSerial : public Stream {
+public:
+    SoftwareSerial(uint8_t rxPin, uint8_t txPin) { (void)rxPin; (void)txPin; }
+    void begin(long baud) { _baud = baud; }
+    bool listen() { return true; }
+    void end() {}
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override { (void)c; return 1; }
+    using Print::write;
+
+private:
+    long _baud = 0;
+};
+
+#endif // RYUW122_HOST_SOFTWARESERIAL_H
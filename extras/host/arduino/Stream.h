@@ -0,0 +1,49 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Minimal Arduino Stream shim used by the RYUW122 host build
+ */
+
+#ifndef RYUW122_HOST_STREAM_H
+#define RYUW122_HOST_STREAM_H
+
+#include "Print.h"
+
+unsigned long millis();
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout() const { return _timeout; }
+
+    size_t readBytes(char* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int c = timedRead();
+            if (c < 0) break;
+            *buffer++ = (char)c;
+            count++;
+        }
+        return count;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+
+protected:
+    int timedRead() {
+        unsigned long start = millis();
+        do {
+            int c = read();
+            if (c >= 0) return c;
+        } while (millis() - start < _timeout);
+        return -1;
+    }
+
+    unsigned long _timeout = 1000;
+};
+
+#endif // RYUW122_HOST_STREAM_H
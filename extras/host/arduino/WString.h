@@ -0,0 +1,46 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Minimal Arduino String shim used by the RYUW122 host build
+ */
+
+#ifndef RYUW122_HOST_WSTRING_H
+#define RYUW122_HOST_WSTRING_H
+
+#include <string>
+
+class __FlashStringHelper;
+
+class String {
+public:
+    String() {}
+    String(const char* s) : _s(s ? s : "") {}
+    String(const __FlashStringHelper* s) : _s(s ? reinterpret_cast<const char*>(s) : "") {}
+    String(int v) : _s(std::to_string(v)) {}
+    String(long v) : _s(std::to_string(v)) {}
+    String(unsigned long v) : _s(std::to_string(v)) {}
+
+    const char* c_str() const { return _s.c_str(); }
+    unsigned int length() const { return (unsigned int)_s.size(); }
+
+    bool equals(const String& o) const { return _s == o._s; }
+    bool equalsIgnoreCase(const String& o) const {
+        if (_s.size() != o._s.size()) return false;
+        for (size_t i = 0; i < _s.size(); i++) {
+            if (tolower((unsigned char)_s[i]) != tolower((unsigned char)o._s[i])) return false;
+        }
+        return true;
+    }
+    bool operator==(const String& o) const { return _s == o._s; }
+    bool operator!=(const String& o) const { return _s != o._s; }
+
+    String& operator+=(const String& o) { _s += o._s; return *this; }
+    String& operator+=(const char* o) { _s += o ? o : ""; return *this; }
+    String& operator+=(char c) { _s += c; return *this; }
+
+private:
+    std::string _s;
+};
+
+#endif // RYUW122_HOST_WSTRING_H
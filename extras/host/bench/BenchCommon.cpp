@@ -0,0 +1,105 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Shared helpers for the RYUW122 host benchmarks
+ */
+
+#include "BenchCommon.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <fstream>
+#include <new>
+#include <random>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static std::atomic<uint64_t> _allocations(0);
+
+// Replaced global allocation functions: every heap allocation in the benchmark process is counted
+void* operator new(size_t size) {
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+uint64_t benchAllocationCount() {
+    return _allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t benchCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+void benchPrintJson(const BenchResult& r) {
+    printf("{\"benchmark\":\"%s\",\"traffic\":\"%s\",\"frames\":%llu,\"bytes\":%llu,"
+           "\"seconds\":%.6f,\"ns_per_frame\":%.2f,\"frames_per_sec\":%.0f,\"bytes_per_sec\":%.0f,"
+           "\"cycles_per_frame\":%.1f,\"allocs_per_frame\":%.3f}\n",
+           r.name.c_str(), r.traffic.c_str(), (unsigned long long)r.frames, (unsigned long long)r.bytes,
+           r.seconds, r.nsPerFrame(), r.framesPerSecond(), r.bytesPerSecond(),
+           r.cyclesPerFrame(), r.allocationsPerFrame());
+    fflush(stdout);
+}
+
+bool benchLoadCapture(const char* path, std::vector<std::string>& lines) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == '\n')) line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        lines.push_back(line);
+    }
+    return true;
+}
+
+std::vector<std::string> benchSyntheticAnchorTraffic(size_t frames, int tags, uint32_t seed) {
+    static const char* payloads[] = { "", "OK", "POLL", "T=21.5", "BAT=3.71V", "SEQ=000123", "ABCDEFGHIJKL" };
+    const int payloadCount = sizeof(payloads) / sizeof(payloads[0]);
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> distance(20, 3500);
+    std::uniform_int_distribution<int> rssi(-95, -40);
+    std::uniform_int_distribution<int> payload(0, payloadCount - 1);
+
+    std::vector<std::string> lines;
+    lines.reserve(frames);
+    char buffer[80];
+    for (size_t i = 0; i < frames; i++) {
+        const char* data = payloads[payload(random)];
+        snprintf(buffer, sizeof(buffer), "+ANCHOR_RCV=TAG%05d,%d,%s,%d cm,%d",
+                 (int)(i % (size_t)tags), (int)strlen(data), data, distance(random), rssi(random));
+        lines.push_back(buffer);
+    }
+    return lines;
+}
@@ -0,0 +1,120 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Shared helpers for the RYUW122 host benchmarks
+ */
+
+#ifndef RYUW122_BENCH_COMMON_H
+#define RYUW122_BENCH_COMMON_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Stream.h"
+
+/**
+ * @brief Heap allocations counted by the replaced global operator new (see BenchCommon.cpp).
+ */
+uint64_t benchAllocationCount();
+
+/**
+ * @brief CPU timestamp counter (rdtsc on x86, 0 where not available).
+ */
+uint64_t benchCycles();
+
+/**
+ * @struct BenchResult
+ * @brief One measured benchmark, emitted as a JSON line.
+ */
+struct BenchResult {
+    std::string name;
+    std::string traffic;
+    uint64_t frames = 0;
+    uint64_t bytes = 0;
+    double seconds = 0.0;
+    uint64_t cycles = 0;
+    uint64_t allocations = 0;
+
+    double nsPerFrame() const { return frames ? seconds * 1e9 / (double)frames : 0.0; }
+    double framesPerSecond() const { return seconds > 0.0 ? (double)frames / seconds : 0.0; }
+    double bytesPerSecond() const { return seconds > 0.0 ? (double)bytes / seconds : 0.0; }
+    double cyclesPerFrame() const { return frames ? (double)cycles / (double)frames : 0.0; }
+    double allocationsPerFrame() const { return frames ? (double)allocations / (double)frames : 0.0; }
+};
+
+/**
+ * @brief Runs body() repeatedly and keeps the fastest repetition.
+ * body() must process `frames` frames (and `bytes` bytes) per call.
+ */
+template <typename Body>
+BenchResult benchRun(const char* name, const std::string& traffic, uint64_t frames, uint64_t bytes,
+                     int repetitions, Body body) {
+    BenchResult best;
+    best.name = name;
+    best.traffic = traffic;
+    best.frames = frames;
+    best.bytes = bytes;
+
+    body(); // warm-up: caches, branch predictors, lazy allocations
+    for (int r = 0; r < repetitions; r++) {
+        uint64_t allocations = benchAllocationCount();
+        uint64_t cycles = benchCycles();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        body();
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        cycles = benchCycles() - cycles;
+        allocations = benchAllocationCount() - allocations;
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if (r == 0 || seconds < best.seconds) {
+            best.seconds = seconds;
+            best.cycles = cycles;
+            best.allocations = allocations;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Prints a result as one JSON object per line (stable keys, for regression tracking).
+ */
+void benchPrintJson(const BenchResult& result);
+
+/**
+ * @class BenchReplayStream
+ * @brief In-memory Stream returning a fixed byte sequence; rewind() replays it.
+ */
+class BenchReplayStream : public Stream {
+public:
+    void setData(const std::string& data) { _data = data; _pos = 0; }
+    void rewind() { _pos = 0; }
+    void append(const char* s) { _data += s; }
+    void clear() { _data.clear(); _pos = 0; }
+
+    int available() override { return (int)(_data.size() - _pos); }
+    int read() override { return _pos < _data.size() ? (unsigned char)_data[_pos++] : -1; }
+    int peek() override { return _pos < _data.size() ? (unsigned char)_data[_pos] : -1; }
+    size_t write(uint8_t c) override { (void)c; return 1; }
+    using Print::write;
+
+private:
+    std::string _data;
+    size_t _pos = 0;
+};
+
+/**
+ * @brief Reads a traffic capture: one module line per text line, empty lines and '#' comments skipped.
+ */
+bool benchLoadCapture(const char* path, std::vector<std::string>& lines);
+
+/**
+ * @brief Generates synthetic +ANCHOR_RCV traffic: `tags` TAGs polled round-robin.
+ */
+std::vector<std::string> benchSyntheticAnchorTraffic(size_t frames, int tags, uint32_t seed);
+
+#endif // RYUW122_BENCH_COMMON_H
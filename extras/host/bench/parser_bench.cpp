@@ -0,0 +1,270 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Parser throughput benchmark for the RYUW122 host build
+ *
+ * Measures frames/s and ns/frame of the receive paths of the driver:
+ *  - parse_frame:          RYUW122ParseFrame() alone on +ANCHOR_RCV lines
+ *  - parse_anchor_receive: parse and dispatch of +ANCHOR_RCV lines to the ANCHOR callbacks
+ *  - parse_tag_receive:    parse and dispatch of +TAG_RCV lines with both TAG callbacks registered
+ *  - loop_dispatch:        loop() line assembly, trimming and dispatch of a byte stream
+ *  - loop_dispatch_history: the same with a RYUW122RangeHistory<32, 16> listener registered
+ *  - anchor_send_sync:     anchorSendDataSync() round trip against an instant responder
+ * on recorded traffic (a capture file) and on synthetic traffic from N TAGs.
+ *
+ * Output: one JSON object per line on stdout, e.g.
+ *   {"benchmark":"loop_dispatch","traffic":"synthetic_24tags","frames":100000,...}
+ *
+ * Usage: parser_bench [--frames N] [--tags N] [--repetitions N] [--capture FILE]
+ */
+
+#include <Arduino.h>
+#include <RYUW122.h>
+#include <RYUW122RangeHistory.h>
+
+#include "BenchCommon.h"
+
+#include <string>
+#include <vector>
+
+#ifndef RYUW122_BENCH_DATA_DIR
+#define RYUW122_BENCH_DATA_DIR "."
+#endif
+
+// Accumulators written by the callbacks so the work cannot be optimized away
+static volatile long sink;
+
+static void anchorSink(const char* tagAddress, int payloadLength, const char* tagData, int distance, int rssi) {
+    sink += tagAddress[0] + payloadLength + tagData[0] + distance + rssi;
+}
+
+static void tagSink(int payloadLength, const char* data, int rssi) {
+    sink += payloadLength + data[0] + rssi;
+}
+
+static void messageSink(const char* fromAddress, const char* message, int rssi) {
+    sink += fromAddress[0] + message[0] + rssi;
+}
+
+/**
+ * @class ScriptedResponder
+ * @brief Answers every command line immediately with the next scripted reply.
+ */
+class ScriptedResponder : public Stream {
+public:
+    std::vector<std::string> replies;
+
+    void rewind() { _next = 0; _out.clear(); _pos = 0; }
+
+    int available() override { return (int)(_out.size() - _pos); }
+    int read() override { return _pos < _out.size() ? (unsigned char)_out[_pos++] : -1; }
+    int peek() override { return _pos < _out.size() ? (unsigned char)_out[_pos] : -1; }
+    size_t write(uint8_t c) override {
+        if (c == '\n') {
+            if (_pos == _out.size()) { _out.clear(); _pos = 0; }
+            _out += replies[_next];
+            if (++_next == replies.size()) _next = 0;
+        }
+        return 1;
+    }
+    using Print::write;
+
+private:
+    std::string _out;
+    size_t _pos = 0;
+    size_t _next = 0;
+};
+
+class RYUW122Bench {
+public:
+    static void parseAnchor(RYUW122& uwb, char* line) {
+        RYUW122Frame frame;
+        if (RYUW122ParseFrame(line, frame)) uwb.dispatchAnchorReceive(frame);
+    }
+    static void parseTag(RYUW122& uwb, char* line) {
+        RYUW122Frame frame;
+        if (RYUW122ParseFrame(line, frame)) uwb.dispatchTagReceive(frame);
+    }
+};
+
+static std::vector<std::string> filterPrefix(const std::vector<std::string>& lines, const char* prefix) {
+    std::vector<std::string> out;
+    for (size_t i = 0; i < lines.size(); i++) {
+        if (lines[i].compare(0, strlen(prefix), prefix) == 0) out.push_back(lines[i]);
+    }
+    return out;
+}
+
+// Repeats the lines until `frames` lines are available
+static std::vector<std::string> repeatTo(const std::vector<std::string>& lines, size_t frames) {
+    std::vector<std::string> out;
+    out.reserve(frames);
+    for (size_t i = 0; i < frames && !lines.empty(); i++) out.push_back(lines[i % lines.size()]);
+    return out;
+}
+
+static uint64_t totalBytes(const std::vector<std::string>& lines) {
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < lines.size(); i++) bytes += lines[i].size() + 2;
+    return bytes;
+}
+
+static void benchTraffic(const std::string& traffic, const std::vector<std::string>& anchorLines, int repetitions) {
+    if (anchorLines.empty()) return;
+    const uint64_t frames = anchorLines.size();
+    const uint64_t bytes = totalBytes(anchorLines);
+
+    // Flat copy of the frames so that the measured loops do not touch std::string
+    std::vector<char> flat;
+    std::vector<size_t> offsets;
+    for (size_t i = 0; i < anchorLines.size(); i++) {
+        offsets.push_back(flat.size());
+        flat.insert(flat.end(), anchorLines[i].begin(), anchorLines[i].end());
+        flat.push_back('\0');
+    }
+
+    BenchReplayStream idle;
+    RYUW122 uwb(&idle);
+    uwb.setCommandTimeout(10); // the streams do not answer the settings read by begin()
+    uwb.begin();
+    uwb.onAnchorReceive(anchorSink);
+    uwb.onDistanceMeasured([](const char* from, float distance, MeasureUnit, int rssi) {
+        sink += from[0] + (long)distance + rssi;
+    });
+
+    // Baseline: copying the line into the scratch buffer (the parsers are destructive)
+    char scratch[RYUW122_RX_BUFFER_SIZE];
+    benchPrintJson(benchRun("copy_baseline", traffic, frames, bytes, repetitions, [&]() {
+        for (size_t i = 0; i < offsets.size(); i++) {
+            strncpy(scratch, &flat[offsets[i]], sizeof(scratch) - 1);
+            scratch[sizeof(scratch) - 1] = '\0';
+            sink += scratch[0];
+        }
+    }));
+
+    benchPrintJson(benchRun("parse_frame", traffic, frames, bytes, repetitions, [&]() {
+        RYUW122Frame frame;
+        for (size_t i = 0; i < offsets.size(); i++) {
+            strncpy(scratch, &flat[offsets[i]], sizeof(scratch) - 1);
+            scratch[sizeof(scratch) - 1] = '\0';
+            if (RYUW122ParseFrame(scratch, frame)) sink += frame.distance + frame.rssi + frame.data[0];
+        }
+    }));
+
+    benchPrintJson(benchRun("parse_anchor_receive", traffic, frames, bytes, repetitions, [&]() {
+        for (size_t i = 0; i < offsets.size(); i++) {
+            strncpy(scratch, &flat[offsets[i]], sizeof(scratch) - 1);
+            scratch[sizeof(scratch) - 1] = '\0';
+            RYUW122Bench::parseAnchor(uwb, scratch);
+        }
+    }));
+
+    // loop(): the whole traffic as a byte stream, drained the way a sketch would
+    std::string stream;
+    for (size_t i = 0; i < anchorLines.size(); i++) stream += anchorLines[i] + "\r\n";
+    BenchReplayStream replay;
+    replay.setData(stream);
+    RYUW122 looping(&replay);
+    looping.setCommandTimeout(10); // the streams do not answer the settings read by begin()
+    looping.begin();
+    looping.onAnchorReceive(anchorSink);
+    benchPrintJson(benchRun("loop_dispatch", traffic, frames, bytes, repetitions, [&]() {
+        replay.rewind();
+        while (replay.available()) looping.loop();
+    }));
+
+    static RYUW122RangeHistory<32, 16> history;
+    looping.addRangeListener(&history);
+    benchPrintJson(benchRun("loop_dispatch_history", traffic, frames, bytes, repetitions, [&]() {
+        replay.rewind();
+        while (replay.available()) looping.loop();
+    }));
+    looping.removeRangeListener(&history);
+
+    // anchorSendDataSync(): each call is answered by +OK and the +ANCHOR_RCV of the polled TAG
+    ScriptedResponder responder;
+    std::vector<std::string> tags;
+    for (size_t i = 0; i < anchorLines.size(); i++) {
+        responder.replies.push_back("+OK\r\n" + anchorLines[i] + "\r\n");
+        tags.push_back(anchorLines[i].substr(12, 8));
+    }
+    RYUW122 syncUwb(&responder);
+    syncUwb.setCommandTimeout(10); // the streams do not answer the settings read by begin()
+    syncUwb.begin();
+    char responseData[RYUW122_MAX_PAYLOAD_LENGTH + 1];
+    benchPrintJson(benchRun("anchor_send_sync", traffic, frames, bytes, repetitions, [&]() {
+        responder.rewind();
+        for (size_t i = 0; i < tags.size(); i++) {
+            int distance = 0;
+            int rssi = 0;
+            if (syncUwb.anchorSendDataSync(tags[i].c_str(), 4, "POLL", responseData, &distance, &rssi, 1000)) {
+                sink += distance + rssi;
+            }
+        }
+    }));
+}
+
+static void benchTagTraffic(size_t frames, int repetitions) {
+    static const char* payloads[] = { "", "GO", "POLL", "CFG=12", "ABCDEFGHIJKL" };
+    std::vector<char> flat;
+    std::vector<size_t> offsets;
+    uint64_t bytes = 0;
+    char buffer[64];
+    for (size_t i = 0; i < frames; i++) {
+        const char* data = payloads[i % 5];
+        int len = snprintf(buffer, sizeof(buffer), "+TAG_RCV=%d,%s,%d", (int)strlen(data), data, -40 - (int)(i % 50));
+        offsets.push_back(flat.size());
+        flat.insert(flat.end(), buffer, buffer + len + 1);
+        bytes += len + 2;
+    }
+
+    BenchReplayStream idle;
+    RYUW122 uwb(&idle);
+    uwb.setCommandTimeout(10); // the streams do not answer the settings read by begin()
+    uwb.begin();
+    uwb.onTagReceive(tagSink);
+    uwb.onMessageReceived(messageSink);
+
+    char scratch[RYUW122_RX_BUFFER_SIZE];
+    benchPrintJson(benchRun("parse_tag_receive", "synthetic_tag_rcv", frames, bytes, repetitions, [&]() {
+        for (size_t i = 0; i < offsets.size(); i++) {
+            strncpy(scratch, &flat[offsets[i]], sizeof(scratch) - 1);
+            scratch[sizeof(scratch) - 1] = '\0';
+            RYUW122Bench::parseTag(uwb, scratch);
+        }
+    }));
+}
+
+int main(int argc, char** argv) {
+    size_t frames = 100000;
+    int tags = 24;
+    int repetitions = 5;
+    std::string capture = std::string(RYUW122_BENCH_DATA_DIR) + "/anchor_session.log";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--frames") frames = (size_t)atol(argv[i + 1]);
+        else if (arg == "--tags") tags = atoi(argv[i + 1]);
+        else if (arg == "--repetitions") repetitions = atoi(argv[i + 1]);
+        else if (arg == "--capture") capture = argv[i + 1];
+        else {
+            fprintf(stderr, "Usage: %s [--frames N] [--tags N] [--repetitions N] [--capture FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (tags < 1) tags = 1;
+    if (repetitions < 1) repetitions = 1;
+
+    std::vector<std::string> recorded;
+    if (benchLoadCapture(capture.c_str(), recorded)) {
+        benchTraffic("recorded", repeatTo(filterPrefix(recorded, "+ANCHOR_RCV="), frames), repetitions);
+    } else {
+        fprintf(stderr, "Capture %s not found, recorded traffic skipped\n", capture.c_str());
+    }
+
+    std::string synthetic = "synthetic_" + std::to_string(tags) + "tags";
+    benchTraffic(synthetic, benchSyntheticAnchorTraffic(frames, tags, 42), repetitions);
+    benchTagTraffic(frames, repetitions);
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Multilateration benchmark for the RYUW122 host build: float against Q16.16 fixed point
+ *
+ * Solves random positions inside a room from noisy ranges with the RYUW122Multilaterate
+ * kernel instantiated for float and for RYUW122Fixed (the AVR default), and reports:
+ *  - ns_per_frame:      time per solve on this machine
+ *  - rms_error_cm:      error against the true position
+ *  - rms_vs_float_cm:   difference from the float solution (the cost of fixed point)
+ *  - failures:          solves that did not return a position
+ * The host has a hardware FPU, so there float is faster; the timings show the operation
+ * count of the two kernels, not their speed on an FPU-less AVR, where every float operation
+ * is a library call and the Q16.16 kernel only needs integer additions and multiplications
+ * (plus one division per distance and per Cholesky column).
+ *
+ * Scenarios: 2d_4nodes (10 x 8 m room, nodes in the corners), 2d_8nodes (corners and wall
+ * centers), 3d_5nodes (4 ceiling corners at 3 m and one node on the floor).
+ *
+ * Usage: positioning_bench [--solves N] [--noise CM] [--repetitions N]
+ */
+
+#include <Arduino.h>
+#include <RYUW122Multilateration.h>
+
+#include "BenchCommon.h"
+
+#include <math.h>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Scenario {
+    const char* name;
+    uint8_t dimensions;
+    std::vector<std::vector<float>> nodes;
+};
+
+struct Problem {
+    float truth[3];
+    std::vector<float> ranges;
+};
+
+static std::vector<Problem> problems(const Scenario& scenario, size_t count, double noiseCm, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> x(0.5, 9.5), y(0.5, 7.5), z(0.5, 2.0);
+    std::normal_distribution<double> noise(0.0, noiseCm / 100.0);
+
+    std::vector<Problem> out(count);
+    for (Problem& problem : out) {
+        problem.truth[0] = (float)x(rng);
+        problem.truth[1] = (float)y(rng);
+        problem.truth[2] = scenario.dimensions == 3 ? (float)z(rng) : 0.0f;
+        for (const std::vector<float>& node : scenario.nodes) {
+            double d = 0.0;
+            for (int k = 0; k < 3; k++) d += (problem.truth[k] - node[k]) * (problem.truth[k] - node[k]);
+            problem.ranges.push_back((float)std::max(0.0, sqrt(d) + noise(rng)));
+        }
+    }
+    return out;
+}
+
+template <typename Scalar>
+static void toNodes(const Scenario& scenario, const Problem& problem, RYUW122MultilaterationNode<Scalar>* nodes) {
+    typedef RYUW122ScalarTraits<Scalar> Traits;
+    for (size_t i = 0; i < scenario.nodes.size(); i++) {
+        for (int k = 0; k < 3; k++) nodes[i].coord[k] = Traits::fromFloat(scenario.nodes[i][k]);
+        // Ranges arrive from the module in cm: convert them the way the driver does
+        nodes[i].range = Traits::fromRatio((int32_t)lroundf(problem.ranges[i] * 100.0f), 100);
+        nodes[i].weight = Scalar(100);
+    }
+}
+
+static volatile int32_t sink;
+
+template <typename Scalar>
+static std::vector<std::vector<float>> benchKernel(const char* name, const Scenario& scenario,
+                                                   const std::vector<Problem>& input, int repetitions,
+                                                   const std::vector<std::vector<float>>* reference) {
+    typedef RYUW122ScalarTraits<Scalar> Traits;
+    uint8_t count = (uint8_t)scenario.nodes.size();
+
+    std::vector<RYUW122MultilaterationNode<Scalar>> nodes(input.size() * count);
+    for (size_t i = 0; i < input.size(); i++) toNodes(scenario, input[i], &nodes[i * count]);
+
+    BenchResult timing = benchRun(name, scenario.name, input.size(), 0, repetitions, [&]() {
+        for (size_t i = 0; i < input.size(); i++) {
+            RYUW122MultilaterationResult<Scalar> result =
+                RYUW122Multilaterate(&nodes[i * count], count, scenario.dimensions, (const Scalar*)nullptr);
+            sink = (int32_t)result.status;
+        }
+    });
+
+    std::vector<std::vector<float>> solutions(input.size());
+    double squaredError = 0.0, squaredDiff = 0.0;
+    size_t solved = 0, compared = 0, failures = 0;
+    for (size_t i = 0; i < input.size(); i++) {
+        RYUW122MultilaterationResult<Scalar> result =
+            RYUW122Multilaterate(&nodes[i * count], count, scenario.dimensions, (const Scalar*)nullptr);
+        if (result.status != RYUW122PositionStatus::OK) {
+            failures++;
+            continue;
+        }
+        std::vector<float>& p = solutions[i];
+        for (int k = 0; k < 3; k++) p.push_back(Traits::toFloat(result.position[k]));
+        for (int k = 0; k < scenario.dimensions; k++) {
+            squaredError += (p[k] - input[i].truth[k]) * (p[k] - input[i].truth[k]);
+        }
+        solved++;
+        if (reference && !(*reference)[i].empty()) {
+            for (int k = 0; k < scenario.dimensions; k++) {
+                double d = p[k] - (*reference)[i][k];
+                squaredDiff += d * d;
+            }
+            compared++;
+        }
+    }
+
+    printf("{\"benchmark\":\"%s\",\"traffic\":\"%s\",\"frames\":%llu,\"seconds\":%.6f,"
+           "\"ns_per_frame\":%.2f,\"cycles_per_frame\":%.1f,\"allocs_per_frame\":%.3f,"
+           "\"rms_error_cm\":%.2f,\"rms_vs_float_cm\":%.3f,\"failures\":%llu}\n",
+           timing.name.c_str(), timing.traffic.c_str(), (unsigned long long)timing.frames, timing.seconds,
+           timing.nsPerFrame(), timing.cyclesPerFrame(), timing.allocationsPerFrame(),
+           solved ? sqrt(squaredError / solved) * 100.0 : 0.0,
+           compared ? sqrt(squaredDiff / compared) * 100.0 : 0.0,
+           (unsigned long long)failures);
+    fflush(stdout);
+    return solutions;
+}
+
+int main(int argc, char** argv) {
+    size_t solves = 20000;
+    double noiseCm = 10.0;
+    int repetitions = 5;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--solves") solves = (size_t)atol(argv[i + 1]);
+        else if (arg == "--noise") noiseCm = atof(argv[i + 1]);
+        else if (arg == "--repetitions") repetitions = atoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "Usage: %s [--solves N] [--noise CM] [--repetitions N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (solves < 1) solves = 1;
+    if (repetitions < 1) repetitions = 1;
+
+    std::vector<Scenario> scenarios = {
+        { "2d_4nodes", 2, { { 0, 0, 0 }, { 10, 0, 0 }, { 10, 8, 0 }, { 0, 8, 0 } } },
+        { "2d_8nodes", 2, { { 0, 0, 0 }, { 10, 0, 0 }, { 10, 8, 0 }, { 0, 8, 0 },
+                            { 5, 0, 0 }, { 10, 4, 0 }, { 5, 8, 0 }, { 0, 4, 0 } } },
+        { "3d_5nodes", 3, { { 0, 0, 3 }, { 10, 0, 3 }, { 10, 8, 3 }, { 0, 8, 3 }, { 5, 4, 0 } } },
+    };
+
+    for (const Scenario& scenario : scenarios) {
+        if (scenario.nodes.size() > RYUW122_POSITIONING_MAX_ANCHORS) continue;
+        std::vector<Problem> input = problems(scenario, solves, noiseCm, 42);
+        std::vector<std::vector<float>> reference =
+            benchKernel<float>("multilaterate_float", scenario, input, repetitions, nullptr);
+        benchKernel<RYUW122Fixed>("multilaterate_q16", scenario, input, repetitions, &reference);
+    }
+    return 0;
+}
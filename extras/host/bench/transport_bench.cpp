@@ -0,0 +1,143 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Byte I/O benchmark for the RYUW122 host build
+ *
+ * Measures the bytes/s that loop() pulls from the transport, with the same traffic and the
+ * same callbacks on three bindings of the driver:
+ *  - stream: RYUW122 over a Stream*, two virtual calls per byte
+ *  - direct: RYUW122T<BenchReplayStream>, available()/read() called directly and inlined
+ *  - bulk:   RYUW122T<BenchBlockStream>, whose traits copy a whole chunk (like a DMA ring)
+ * on two kinds of traffic:
+ *  - anchor_rcv: +ANCHOR_RCV frames from N TAGs, parsed and dispatched to a callback
+ *  - discarded:  lines that are not frames, so the cost is mostly the byte I/O and the line assembly
+ *
+ * Output: one JSON object per line on stdout, e.g.
+ *   {"benchmark":"loop_direct","traffic":"anchor_rcv_24tags","frames":100000,...,"bytes_per_sec":...}
+ *
+ * Usage: transport_bench [--frames N] [--tags N] [--repetitions N]
+ */
+
+#include <Arduino.h>
+#include <RYUW122.h>
+#include <RYUW122Transport.h>
+
+#include "BenchCommon.h"
+
+#include <string>
+#include <vector>
+
+static volatile long sink;
+
+static void anchorSink(const char* tagAddress, int payloadLength, const char* tagData, int distance, int rssi) {
+    sink += tagAddress[0] + payloadLength + tagData[0] + distance + rssi;
+}
+
+/**
+ * @class BenchBlockStream
+ * @brief In-memory Stream that hands out its bytes a block at a time through its traits.
+ */
+class BenchBlockStream : public Stream {
+public:
+    void setData(const std::string& data) { _data = data; _pos = 0; }
+    void rewind() { _pos = 0; }
+
+    int available() override { return (int)(_data.size() - _pos); }
+    int read() override { return _pos < _data.size() ? (unsigned char)_data[_pos++] : -1; }
+    int peek() override { return _pos < _data.size() ? (unsigned char)_data[_pos] : -1; }
+    size_t write(uint8_t c) override { (void)c; return 1; }
+    using Print::write;
+
+    int copyOut(uint8_t* buffer, int size) {
+        int count = available();
+        if (count > size) count = size;
+        memcpy(buffer, _data.data() + _pos, (size_t)count);
+        _pos += (size_t)count;
+        return count;
+    }
+
+private:
+    std::string _data;
+    size_t _pos = 0;
+};
+
+template <>
+struct RYUW122TransportTraits<BenchBlockStream> {
+    static int readAvailable(BenchBlockStream& transport, uint8_t* buffer, int size) {
+        return transport.copyOut(buffer, size);
+    }
+    static void writeCommand(BenchBlockStream& transport, const char* command) {
+        transport.write(command);
+        transport.write("\r\n");
+    }
+};
+
+// Drains the whole traffic with loop(), the way a sketch would
+template <typename Driver, typename Transport>
+static void benchLoop(const char* name, const std::string& traffic, const std::string& bytes, uint64_t frames,
+                      int repetitions, Driver& uwb, Transport& transport) {
+    transport.setData(bytes);
+    uwb.setCommandTimeout(10); // the streams do not answer the settings read by begin()
+    uwb.begin();
+    uwb.onAnchorReceive(anchorSink);
+    benchPrintJson(benchRun(name, traffic, frames, bytes.size(), repetitions, [&]() {
+        transport.rewind();
+        while (transport.available()) uwb.loop();
+    }));
+}
+
+static void benchTraffic(const std::string& traffic, const std::vector<std::string>& lines, int repetitions) {
+    std::string bytes;
+    for (size_t i = 0; i < lines.size(); i++) bytes += lines[i] + "\r\n";
+    const uint64_t frames = lines.size();
+
+    BenchReplayStream replay;
+    RYUW122 stream(&replay);
+    benchLoop("loop_stream", traffic, bytes, frames, repetitions, stream, replay);
+
+    BenchReplayStream directReplay;
+    RYUW122T<BenchReplayStream> direct(&directReplay);
+    benchLoop("loop_direct", traffic, bytes, frames, repetitions, direct, directReplay);
+
+    BenchBlockStream block;
+    RYUW122T<BenchBlockStream> bulk(&block);
+    benchLoop("loop_bulk", traffic, bytes, frames, repetitions, bulk, block);
+}
+
+// Lines of the length of a frame that the driver assembles and drops (no known prefix)
+static std::vector<std::string> discardedTraffic(size_t frames) {
+    std::vector<std::string> lines;
+    lines.reserve(frames);
+    char buffer[64];
+    for (size_t i = 0; i < frames; i++) {
+        snprintf(buffer, sizeof(buffer), "+NOTE=%06d,ABCDEFGHIJKL,%04d,-%02d", (int)(i % 1000000), (int)(i % 3500),
+                 40 + (int)(i % 55));
+        lines.push_back(buffer);
+    }
+    return lines;
+}
+
+int main(int argc, char** argv) {
+    size_t frames = 100000;
+    int tags = 24;
+    int repetitions = 5;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--frames") frames = (size_t)atol(argv[i + 1]);
+        else if (arg == "--tags") tags = atoi(argv[i + 1]);
+        else if (arg == "--repetitions") repetitions = atoi(argv[i + 1]);
+        else {
+            fprintf(stderr, "Usage: %s [--frames N] [--tags N] [--repetitions N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (tags < 1) tags = 1;
+    if (repetitions < 1) repetitions = 1;
+
+    benchTraffic("anchor_rcv_" + std::to_string(tags) + "tags", benchSyntheticAnchorTraffic(frames, tags, 42),
+                 repetitions);
+    benchTraffic("discarded", discardedTraffic(frames), repetitions);
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file pty_gateway.cpp
+ * @author Renzo Mischianti
+ * @brief Host example: a Linux positioning hub with several modules on serial ports.
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Each module is opened as a /dev/tty* device with termios and all of them are served by one
+ * epoll loop (RYUW122EpollGateway), each with its ranging scheduler.
+ *
+ * Without arguments three simulated modules are put behind pseudo-terminals, left at 9600 baud:
+ * begin() detects the rate through the terminal and moves both sides to 115200. With real
+ * modules on USB-UART adapters give their devices and the TAGs to range:
+ *   ./pty_gateway /dev/ttyUSB0 /dev/ttyUSB1 --tag T1T1T1T1 --tag T2T2T2T2
+ *
+ * Build with the host CMake project in extras/host (Linux only) and run ./pty_gateway
+ */
+
+#include <Arduino.h>
+#include <RYUW122.h>
+#include <RYUW122Transport.h>
+#include <RYUW122RangingScheduler.h>
+#include <RYUW122Simulator.h>
+#include <RYUW122LinuxSerial.h>
+#include <RYUW122EpollGateway.h>
+#include <RYUW122PtyModule.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef RYUW122T<RYUW122LinuxSerial> LinuxRYUW122;
+
+struct Node {
+    std::unique_ptr<RYUW122Simulator> module;  // simulated modules only
+    std::unique_ptr<RYUW122PtyModule> pty;
+    std::unique_ptr<RYUW122LinuxSerial> port;
+    std::unique_ptr<LinuxRYUW122> uwb;
+    std::unique_ptr<RYUW122RangingScheduler> ranging;
+};
+
+int main(int argc, char** argv) {
+    std::vector<std::string> devices;
+    std::vector<std::string> tags;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--tag" && i + 1 < argc) tags.push_back(argv[++i]);
+        else devices.push_back(arg);
+    }
+    bool simulated = devices.empty();
+    if (!simulated && tags.empty()) {
+        fprintf(stderr, "Usage: %s [/dev/ttyX ... --tag ADDRESS ...]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Node> nodes(simulated ? 3 : devices.size());
+    if (nodes.size() > RYUW122_GROUP_MAX_MODULES) {
+        fprintf(stderr, "At most %d modules (RYUW122_GROUP_MAX_MODULES)\n", RYUW122_GROUP_MAX_MODULES);
+        return 1;
+    }
+
+    RYUW122EpollGateway gateway;
+    for (size_t n = 0; n < nodes.size(); n++) {
+        Node& node = nodes[n];
+        std::string path;
+        if (simulated) {
+            node.module.reset(new RYUW122Simulator((uint32_t)n + 1));
+            node.module->setModuleBaudRate(9600);
+            node.module->setResponseLatency(2000, 500);
+            node.module->setRangingLatency(15000, 5000);
+            node.module->setDropRate(0.05);
+            for (int t = 0; t < 4; t++) {
+                char address[9];
+                snprintf(address, sizeof(address), "%c%d%c%d%c%d%c%d", 'A' + (int)n, t, 'A' + (int)n, t,
+                         'A' + (int)n, t, 'A' + (int)n, t);
+                node.module->addTag(address, 150 + 100 * t);
+                if (n == 0) tags.push_back(address);
+            }
+            node.pty.reset(new RYUW122PtyModule(*node.module));
+            if (!node.pty->begin()) {
+                perror("openpty");
+                return 1;
+            }
+            path = node.pty->path();
+        } else {
+            path = devices[n];
+        }
+
+        node.port.reset(new RYUW122LinuxSerial(path.c_str()));
+        node.uwb.reset(new LinuxRYUW122(node.port.get(), RYUW122BaudRate::B_115200));
+        node.uwb->setAutoBaud(RYUW122AutoBaud::DETECT_AND_UPGRADE);
+        node.ranging.reset(new RYUW122RangingScheduler(*node.uwb));
+        gateway.add(*node.uwb, *node.port, node.ranging.get());
+    }
+
+    if (!gateway.begin()) {
+        for (size_t n = 0; n < nodes.size(); n++) {
+            if (!nodes[n].port->isOpen()) {
+                fprintf(stderr, "%s: %s\n", nodes[n].port->path(), strerror(nodes[n].port->getError()));
+            }
+        }
+        Serial.println(F("Failed to initialize the RYUW122 modules"));
+        return 1;
+    }
+
+    for (size_t n = 0; n < nodes.size(); n++) {
+        Node& node = nodes[n];
+        if (!node.uwb->setMode(RYUW122Mode::ANCHOR)) {
+            Serial.println(F("Failed to set the ANCHOR mode"));
+            return 1;
+        }
+        for (size_t t = 0; t < 4 && t < tags.size(); t++) {
+            std::string address = tags[t];
+            // Each simulated module has its own TAGs: A0A0A0A0.. for the first, B0B0B0B0.. for the second
+            if (simulated) for (size_t c = 0; c < 8; c += 2) address[c] = (char)('A' + n);
+            node.ranging->addTag(address.c_str());
+        }
+        Serial.print(F("Module ")); Serial.print((int)n + 1); Serial.print(F(" on ")); Serial.print(node.port->path());
+        Serial.print(F(" at ")); Serial.print(node.port->baudRate()); Serial.println(F(" baud"));
+    }
+
+    gateway.group().resetStats();
+    gateway.start();
+    gateway.run(3000);
+    gateway.stop();
+
+    bool ok = true;
+    Serial.println(F("After 3 s:"));
+    for (size_t n = 0; n < nodes.size(); n++) {
+        RYUW122GroupStats stats = gateway.group().getStats((uint8_t)n);
+        Serial.print(F("  module ")); Serial.print((int)n + 1); Serial.print(F(": "));
+        Serial.print(stats.measurements); Serial.print(F(" measurements, "));
+        Serial.print(stats.measurementRate, 1); Serial.print(F(" /s, "));
+        Serial.print(nodes[n].port->bytesRead()); Serial.print(F(" bytes read, "));
+        Serial.print(nodes[n].port->bytesWritten()); Serial.println(F(" written"));
+        for (uint8_t t = 0; t < nodes[n].ranging->getTagCount(); t++) {
+            Serial.print(F("    ")); Serial.print(nodes[n].ranging->getTagAddress(t)); Serial.print(F(": "));
+            Serial.print(nodes[n].ranging->getLastDistance(t)); Serial.println(F(" cm"));
+        }
+        if (stats.measurements == 0) ok = false;
+    }
+    Serial.print(F("  epoll wakeups: ")); Serial.println(gateway.getWakeups());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file simulated_group.cpp
+ * @author Renzo Mischianti
+ * @brief Host example: three ANCHOR modules on one board, driven by a RYUW122Group.
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * A gateway with three UARTs, one module on each, every module ranging its own four TAGs
+ * with a ranging scheduler. The group loop() runs the three schedulers in turn, so the
+ * exchanges of the modules are in flight at the same time and the board measures about three
+ * times the distances of a single module. Then the sketch makes a blocking call on the first
+ * module to a TAG that never answers (2 s): the other two keep ranging while it waits.
+ *
+ * Build with the host CMake project in extras/host and run ./simulated_group
+ */
+
+#include <Arduino.h>
+#include <RYUW122.h>
+#include <RYUW122Transport.h>
+#include <RYUW122RangingScheduler.h>
+#include <RYUW122Group.h>
+#include <RYUW122Simulator.h>
+
+const int numModules = 3;
+const char* tagAddresses[numModules][4] = {
+    { "A1A1A1A1", "A2A2A2A2", "A3A3A3A3", "A4A4A4A4" },
+    { "B1B1B1B1", "B2B2B2B2", "B3B3B3B3", "B4B4B4B4" },
+    { "C1C1C1C1", "C2C2C2C2", "C3C3C3C3", "C4C4C4C4" }
+};
+
+RYUW122Simulator modules[numModules] = { RYUW122Simulator(1), RYUW122Simulator(2), RYUW122Simulator(3) };
+RYUW122T<RYUW122Simulator> uwb[numModules] = {
+    RYUW122T<RYUW122Simulator>(&modules[0]),
+    RYUW122T<RYUW122Simulator>(&modules[1]),
+    RYUW122T<RYUW122Simulator>(&modules[2])
+};
+RYUW122RangingScheduler ranging[numModules] = {
+    RYUW122RangingScheduler(uwb[0]), RYUW122RangingScheduler(uwb[1]), RYUW122RangingScheduler(uwb[2])
+};
+RYUW122Group group;
+
+void printStats(const char* title) {
+    Serial.println(title);
+    float total = 0;
+    for (uint8_t i = 0; i < group.getCount(); i++) {
+        RYUW122GroupStats stats = group.getStats(i);
+        Serial.print(F("  module ")); Serial.print(i + 1); Serial.print(F(": "));
+        Serial.print(stats.measurements); Serial.print(F(" measurements, "));
+        Serial.print(stats.measurementRate, 1); Serial.print(F(" /s, "));
+        Serial.print(stats.services); Serial.print(F(" runs, longest "));
+        Serial.print(stats.maxService); Serial.print(F(" us, load "));
+        Serial.print(stats.load * 100.0f, 2); Serial.println(F(" %"));
+        total += stats.measurementRate;
+    }
+    Serial.print(F("  board: ")); Serial.print(total, 1); Serial.println(F(" measurements/s"));
+}
+
+void run(unsigned long duration) {
+    unsigned long start = millis();
+    while (millis() - start < duration) group.loop();
+}
+
+int main() {
+    for (int m = 0; m < numModules; m++) {
+        modules[m].setResponseLatency(2000, 500);
+        modules[m].setRangingLatency(20000 + m * 5000, 5000);
+        modules[m].setDropRate(0.05);
+        for (int t = 0; t < 4; t++) modules[m].addTag(tagAddresses[m][t], 150 + 100 * t + 10 * m);
+        group.add(uwb[m], &ranging[m]);
+    }
+
+    if (!group.begin()) {
+        Serial.println(F("Failed to initialize the RYUW122 modules"));
+        return 1;
+    }
+    for (int m = 0; m < numModules; m++) {
+        if (!uwb[m].setMode(RYUW122Mode::ANCHOR)) {
+            Serial.println(F("Failed to set the ANCHOR mode"));
+            return 1;
+        }
+        for (int t = 0; t < 4; t++) ranging[m].addTag(tagAddresses[m][t]);
+    }
+
+    // One module alone, as a reference
+    ranging[0].start();
+    group.resetStats();
+    run(2000);
+    ranging[0].stop();
+    run(100);
+    printStats("Module 1 alone for 2 s:");
+
+    // The three modules together
+    group.start();
+    group.resetStats();
+    run(2000);
+    printStats("Three modules together for 2 s:");
+
+    // A blocking call of module 1 to a TAG that never answers: modules 2 and 3 keep ranging
+    group.resetStats();
+    unsigned long start = millis();
+    float distance = uwb[0].getDistanceFrom("GONEGONE", MeasureUnit::CENTIMETERS, 2000);
+    Serial.print(F("Blocking call of module 1: ")); Serial.print(distance, 0);
+    Serial.print(F(" after ")); Serial.print(millis() - start); Serial.println(F(" ms"));
+    printStats("Meanwhile:");
+
+    group.stop();
+    bool ok = group.getStats(1).measurements > 0 && group.getStats(2).measurements > 0;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file simulated_positioning.cpp
+ * @author Renzo Mischianti
+ * @brief Host example: 2D positioning of a moving ANCHOR from four reference nodes.
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * The simulated module is the mobile ANCHOR; four reference nodes sit at the corners of a
+ * 5.3 x 3.65 m room. The ANCHOR walks a circle at 0.5 m/s and the simulated ranges carry
+ * 10 cm of gaussian noise. The ranging scheduler polls the nodes back to back; both
+ * RYUW122Positioning (a snapshot solve after every range) and RYUW122PositionTracker
+ * (an EKF updated by every single range) take the ranges straight from the driver.
+ *
+ * Build with the host CMake project in extras/host and run ./simulated_positioning
+ */
+
+#include <Arduino.h>
+#include <RYUW122.h>
+#include <RYUW122RangingScheduler.h>
+#include <RYUW122Positioning.h>
+#include <RYUW122PositionTracker.h>
+#include <RYUW122Simulator.h>
+
+#include <math.h>
+#include <random>
+
+struct Node { const char* address; float x; float y; };
+const Node nodes[] = {
+    { "T1T1T1T1", 0.0f, 0.0f },
+    { "T2T2T2T2", 5.3f, 0.0f },
+    { "T3T3T3T3", 5.3f, 3.65f },
+    { "T4T4T4T4", 0.0f, 3.65f }
+};
+const int numNodes = sizeof(nodes) / sizeof(nodes[0]);
+
+RYUW122Simulator module;
+RYUW122 uwb(&module);
+RYUW122RangingScheduler ranging(uwb);
+RYUW122Positioning positioning;
+RYUW122PositionTracker tracker;
+
+std::mt19937 rng(7);
+std::normal_distribution<double> rangeNoise(0.0, 10.0);
+
+unsigned long positions = 0;
+double squaredError = 0.0;
+unsigned long trackUpdates = 0;
+double trackSquaredError = 0.0;
+
+// True position of the ANCHOR: a 1 m circle around the room center, 0.5 m/s
+void truePosition(unsigned long ms, double& x, double& y) {
+    double angle = 0.5 * ms / 1000.0;
+    x = 2.65 + cos(angle);
+    y = 1.825 + sin(angle);
+}
+
+// Moves the simulated ranges to the current true position
+void updateRanges() {
+    double x, y;
+    truePosition(millis(), x, y);
+    for (int i = 0; i < numNodes; i++) {
+        double d = hypot(x - nodes[i].x, y - nodes[i].y) * 100.0 + rangeNoise(rng);
+        module.setTagDistance(nodes[i].address, (int)lround(d));
+    }
+}
+
+void onPosition(const RYUW122Position& position, void* context) {
+    (void)context;
+    double x, y;
+    truePosition(position.timestamp, x, y);
+    double error = hypot(position.x - x, position.y - y);
+    squaredError += error * error;
+
+    if (positions++ % 20 == 0) {
+        Serial.print(F("x=")); Serial.print(position.x, 3);
+        Serial.print(F(" y=")); Serial.print(position.y, 3);
+        Serial.print(F(" (true ")); Serial.print(x, 3); Serial.print(F(", ")); Serial.print(y, 3);
+        Serial.print(F(") residual ")); Serial.print(position.residual, 3);
+        Serial.print(F(" m, GDOP ")); Serial.print(position.gdop, 2);
+        Serial.print(F(", ")); Serial.print(position.anchorsUsed); Serial.println(F(" nodes"));
+    }
+}
+
+void onTrackUpdate(const RYUW122TrackState& state, void* context) {
+    (void)context;
+    double x, y;
+    truePosition(state.timestamp / 1000, x, y);
+    double error = hypot(state.x - x, state.y - y);
+    trackSquaredError += error * error;
+    trackUpdates++;
+}
+
+int main() {
+    module.setResponseLatency(2000);
+    module.setRangingLatency(15000, 5000);
+    for (int i = 0; i < numNodes; i++) {
+        module.addTag(nodes[i].address, 100);
+        ranging.addTag(nodes[i].address);
+        positioning.addAnchor(nodes[i].address, nodes[i].x, nodes[i].y);
+        tracker.addAnchor(nodes[i].address, nodes[i].x, nodes[i].y);
+    }
+
+    if (!uwb.begin() || !uwb.setMode(RYUW122Mode::ANCHOR)) {
+        Serial.println(F("Failed to initialize RYUW122 module"));
+        return 1;
+    }
+
+    // Ranges older than one round are not used, a moving ANCHOR makes them wrong
+    positioning.setMaxRangeAge(150);
+    positioning.onPosition(onPosition);
+    uwb.addRangeListener(&positioning);
+
+    // Walking pace: accelerations of about 0.5 m/s^2
+    tracker.setAccelerationNoise(0.5);
+    tracker.onUpdate(onTrackUpdate);
+    uwb.addRangeListener(&tracker);
+
+    ranging.setTimeout(200);
+    ranging.start();
+    unsigned long start = millis();
+    while (millis() - start < 5000) {
+        updateRanges();
+        ranging.loop();
+    }
+    ranging.stop();
+
+    Serial.print(F("[snapshot] ")); Serial.print(positions); Serial.print(F(" positions in 5 s, RMS error "));
+    Serial.print(positions ? sqrt(squaredError / positions) * 100.0 : 0.0, 1); Serial.println(F(" cm"));
+    Serial.print(F("[tracker]  ")); Serial.print(trackUpdates); Serial.print(F(" positions in 5 s, RMS error "));
+    Serial.print(trackUpdates ? sqrt(trackSquaredError / trackUpdates) * 100.0 : 0.0, 1); Serial.println(F(" cm"));
+
+    // Between ranges, the tracker extrapolates to any instant
+    RYUW122TrackState now = tracker.predict(micros());
+    Serial.print(F("[tracker]  now x=")); Serial.print(now.x, 3); Serial.print(F(" y=")); Serial.print(now.y, 3);
+    Serial.print(F(", speed ")); Serial.print(hypot(now.vx, now.vy), 2);
+    Serial.print(F(" m/s, accuracy ")); Serial.print(now.accuracy * 100.0f, 1); Serial.println(F(" cm"));
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file simulated_ranging.cpp
+ * @author Renzo Mischianti
+ * @brief Host example: the real RYUW122 driver talking to a simulated module.
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * The simulated module answers the AT commands like the real one and hosts three TAGs
+ * at known distances. The module was left at 9600 baud: begin() finds it and moves both
+ * sides to 115200. The sketch then configures the module as ANCHOR and measures the
+ * distances with the blocking API, with the asynchronous transaction API and with the
+ * ranging scheduler. No timeout is given: each exchange waits as long as the round trips
+ * measured with that TAG suggest, so the lost replies cost little. During the scheduler run
+ * one TAG leaves the coverage for a second: the retry policy stops polling it and probes it
+ * now and then until it answers again.
+ *
+ * Build with the host CMake project in extras/host and run ./simulated_ranging
+ */
+
+#include <Arduino.h>
+#include <RYUW122.h>
+#include <RYUW122RangingScheduler.h>
+#include <RYUW122RangeHistory.h>
+#include <RYUW122RetryPolicy.h>
+#include <RYUW122Simulator.h>
+
+const char* tagAddresses[] = { "T1T1T1T1", "T2T2T2T2", "T3T3T3T3" };
+const int numTags = sizeof(tagAddresses) / sizeof(tagAddresses[0]);
+
+RYUW122Simulator module;
+RYUW122 uwb(&module);
+RYUW122RangingScheduler ranging(uwb);
+RYUW122RangeHistory<4, 8> history; // last 8 measurements of each TAG, filled by the driver
+RYUW122RetryPolicy retryPolicy;
+unsigned long schedulerStart = 0;
+
+int pendingReplies = 0;
+
+void onRangingDone(const RYUW122TransactionResult& result, void* context) {
+    const char* tag = static_cast<const char*>(context);
+    Serial.print(F("[async] ")); Serial.print(tag);
+    if (result.status == RYUW122TransactionStatus::COMPLETED) {
+        // The +ANCHOR_RCV is delivered already decoded
+        Serial.print(F(" -> ")); Serial.print(result.frame->data);
+        Serial.print(F(", ")); Serial.print(result.frame->distance);
+        Serial.print(F(" cm, RSSI ")); Serial.print(result.frame->rssi);
+    } else {
+        Serial.print(F(" -> failed, status ")); Serial.print((int)result.status);
+    }
+    Serial.print(F(" (")); Serial.print(result.elapsed); Serial.println(F(" ms)"));
+    pendingReplies--;
+}
+
+void onRoundComplete(uint8_t successCount, unsigned long elapsed, void* context) {
+    (void)context;
+    Serial.print(F("[scheduler] round ")); Serial.print(ranging.getRoundCount());
+    Serial.print(F(": ")); Serial.print(successCount); Serial.print(F(" tags in "));
+    Serial.print(elapsed); Serial.println(F(" ms"));
+}
+
+void onTagState(const char* tagAddress, RYUW122CircuitState state, void* context) {
+    (void)context;
+    Serial.print(F("[policy] ")); Serial.print(millis() - schedulerStart); Serial.print(F(" ms: "));
+    Serial.print(tagAddress);
+    switch (state) {
+        case RYUW122CircuitState::OPEN:      Serial.println(F(" not answering, polling suspended")); break;
+        case RYUW122CircuitState::HALF_OPEN: Serial.println(F(" probed")); break;
+        case RYUW122CircuitState::CLOSED:    Serial.println(F(" back")); break;
+    }
+}
+
+void setup() {
+    // 2 ms per answer, 15 +/- 5 ms for the ranging exchange, 10% of the replies lost
+    module.setResponseLatency(2000);
+    module.setRangingLatency(15000, 5000);
+    module.setDropRate(0.1);
+    module.addTag("T1T1T1T1", 120, -55, "OK1");
+    module.addTag("T2T2T2T2", 340, -62, "OK2");
+    module.addTag("T3T3T3T3", 515, -71, "OK3");
+    module.setModuleBaudRate(9600);
+    module.setWireTime(true);
+
+    uwb.setAutoBaud(RYUW122AutoBaud::DETECT_AND_UPGRADE);
+    unsigned long start = millis();
+    if (!uwb.begin()) {
+        Serial.println(F("Failed to initialize RYUW122 module"));
+        exit(1);
+    }
+    Serial.print(F("Module found and switched to ")); Serial.print(module.moduleBaudRate());
+    Serial.print(F(" baud in ")); Serial.print(millis() - start); Serial.println(F(" ms"));
+
+    // Only the settings that differ from the module are sent
+    RYUW122Config config;
+    config.mode = RYUW122Mode::ANCHOR;
+    config.networkId = "AABBCCDD";
+    config.address = "A1A1A1A1";
+    start = millis();
+    if (!uwb.applyConfig(config)) {
+        Serial.println(F("Failed to configure the module"));
+        exit(1);
+    }
+    Serial.print(F("Configured in ")); Serial.print(millis() - start); Serial.println(F(" ms"));
+    Serial.print(F("Mode: ")); Serial.println(RYUW122Mode_descriptionF(uwb.getMode()));
+
+    for (int i = 0; i < numTags; i++) ranging.addTag(tagAddresses[i]);
+    ranging.onRoundComplete(onRoundComplete);
+    uwb.addRangeListener(&history);
+
+    // One retry per exchange, 3 failures in a row suspend a TAG, probed again after 250 ms
+    retryPolicy.setOpenTime(250);
+    retryPolicy.onStateChange(onTagState);
+    uwb.setRetryPolicy(&retryPolicy);
+}
+
+void loop() {
+    // Blocking API
+    float distances[numTags];
+    unsigned long start = millis();
+    int found = uwb.getMultipleDistances(tagAddresses, numTags, distances, MeasureUnit::METERS);
+    Serial.print(F("[sync] ")); Serial.print(found); Serial.print(F(" tags in "));
+    Serial.print(millis() - start); Serial.println(F(" ms"));
+    for (int i = 0; i < numTags; i++) {
+        Serial.print(F("  ")); Serial.print(tagAddresses[i]); Serial.print(F(": "));
+        Serial.print(distances[i], 2); Serial.println(F(" m"));
+    }
+
+    // Asynchronous API: all the requests are queued, loop() moves them forward
+    start = millis();
+    for (int i = 0; i < numTags; i++) {
+        if (uwb.anchorSendDataAsync(tagAddresses[i], 4, "PING", onRangingDone, (void*)tagAddresses[i])) {
+            pendingReplies++;
+        }
+    }
+    while (pendingReplies > 0) {
+        uwb.loop();
+    }
+    Serial.print(F("[async] round in ")); Serial.print(millis() - start); Serial.println(F(" ms"));
+}
+
+int main() {
+    setup();
+    for (int round = 0; round < 3; round++) {
+        loop();
+    }
+
+    // Ranging scheduler: each TAG is polled as soon as the previous exchange has finished.
+    // T3 leaves the coverage between 1 and 2 s.
+    ranging.start();
+    schedulerStart = millis();
+    bool tagGone = false;
+    while (millis() - schedulerStart < 3000) {
+        unsigned long elapsed = millis() - schedulerStart;
+        if (!tagGone && elapsed >= 1000 && elapsed < 2000) {
+            module.removeTag("T3T3T3T3");
+            tagGone = true;
+        } else if (tagGone && elapsed >= 2000) {
+            module.addTag("T3T3T3T3", 515, -71, "OK3");
+            tagGone = false;
+        }
+        ranging.loop();
+    }
+    ranging.stop();
+    for (int i = 0; i < numTags; i++) {
+        Serial.print(F("  ")); Serial.print(tagAddresses[i]); Serial.print(F(": "));
+        Serial.print(ranging.getLastDistance(i)); Serial.print(F(" cm, "));
+        Serial.print(ranging.getUpdateRate(i), 1); Serial.print(F(" Hz, "));
+        Serial.print(ranging.getFailureCount(i)); Serial.print(F(" lost, history:"));
+        int8_t tag = history.getTagIndex(tagAddresses[i]);
+        for (uint8_t age = 0; tag >= 0 && age < history.getCount(tag); age++) {
+            Serial.print(' '); Serial.print(history.getDistance(tag, age));
+        }
+        Serial.println();
+    }
+
+    // Round trip statistics behind the adaptive timeouts
+    RYUW122TagLatency latency;
+    for (uint8_t i = 0; uwb.getTagLatencyAt(i, latency); i++) {
+        Serial.print(F("  ")); Serial.print(latency.address);
+        Serial.print(F(": RTT ")); Serial.print(latency.srtt);
+        Serial.print(F(" +/- ")); Serial.print(latency.rttvar);
+        Serial.print(F(" ms (")); Serial.print(latency.minRtt); Serial.print(F("-")); Serial.print(latency.maxRtt);
+        Serial.print(F(" ms, ")); Serial.print(latency.samples); Serial.print(F(" samples, "));
+        Serial.print(latency.timeouts); Serial.print(F(" timeouts), timeout "));
+        Serial.print(latency.timeout); Serial.println(F(" ms"));
+    }
+
+    Serial.print(F("Commands handled by the simulated module: "));
+    Serial.println(module.commandsReceived());
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file simulated_telemetry.cpp
+ * @author Renzo Mischianti
+ * @brief Host example: TAG telemetry carried by the ranging replies.
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Every 20 ms each simulated TAG refreshes the data of its reply (AT+TAG_SEND on a real
+ * TAG) with a sequence number, its battery voltage, a 3-axis acceleration and a "moving"
+ * flag, packed by a RYUW122PayloadSchema into 8 characters. The ANCHOR polls the TAGs with
+ * the ranging scheduler and decodes the telemetry of every +ANCHOR_RCV in a range listener:
+ * distance and sensor data arrive in the same exchange, and the sequence numbers tell how
+ * many samples of each TAG went by between two polls.
+ *
+ * Build with the host CMake project in extras/host and run ./simulated_telemetry
+ */
+
+#include <Arduino.h>
+#include <RYUW122.h>
+#include <RYUW122RangingScheduler.h>
+#include <RYUW122Payload.h>
+#include <RYUW122Simulator.h>
+
+#include <math.h>
+
+typedef RYUW122PayloadSchema<
+    RYUW122Counter<8>,                   // sequence number
+    RYUW122Scaled<8, 100, 250>,          // battery, 2.50-5.05 V at 10 mV
+    RYUW122Scaled<9, 64, -256>,          // acceleration X, -4..+4 g at 1/64 g
+    RYUW122Scaled<9, 64, -256>,          // acceleration Y
+    RYUW122Scaled<9, 64, -256>,          // acceleration Z
+    RYUW122Flag                          // moving
+> Telemetry;
+
+const char* tagAddresses[] = { "T1T1T1T1", "T2T2T2T2", "T3T3T3T3" };
+const int numTags = sizeof(tagAddresses) / sizeof(tagAddresses[0]);
+
+RYUW122Simulator module;
+RYUW122 uwb(&module);
+RYUW122RangingScheduler ranging(uwb);
+
+// What the firmware of each simulated TAG knows about itself
+uint32_t tagSequence[numTags] = { 0 };
+
+void refreshTag(int tag) {
+    float t = millis() / 1000.0f;
+    float battery = 4.15f - 0.02f * t - 0.1f * tag;
+    float ax = 0.5f * sinf(t + tag);
+    float ay = 0.5f * cosf(t + tag);
+    float az = 1.0f;
+    bool moving = tag != 2;
+
+    char data[Telemetry::LENGTH + 1];
+    Telemetry::encode(data, tagSequence[tag]++, battery, ax, ay, az, moving);
+    module.setTagData(tagAddresses[tag], data);
+}
+
+// ANCHOR side: decodes the telemetry of every range
+class TelemetryListener : public RYUW122RangeListener {
+public:
+    void onRange(const RYUW122Frame& frame, unsigned long timestampUs) override {
+        (void)timestampUs;
+        int tag = -1;
+        for (int i = 0; i < numTags; i++) {
+            if (strcmp(frame.tagAddress, tagAddresses[i]) == 0) tag = i;
+        }
+        uint32_t sequence;
+        float battery, ax, ay, az;
+        bool moving;
+        if (tag < 0 || !Telemetry::decode(frame.data, frame.payloadLength, sequence, battery, ax, ay, az, moving)) {
+            invalid++;
+            return;
+        }
+
+        // The sequence numbers tell how many samples of the TAG went by since the previous poll
+        if (received[tag] > 0) {
+            uint32_t steps = RYUW122Counter<8>::distance(sequence, lastSequence[tag]);
+            if (steps == 0) stale[tag]++;
+            else skipped[tag] += steps - 1;
+        }
+        lastSequence[tag] = sequence;
+        received[tag]++;
+
+        if (received[tag] % 10 == 1) {
+            Serial.print(frame.tagAddress); Serial.print(F(" ")); Serial.print(frame.distance);
+            Serial.print(F(" cm, data ")); Serial.print(frame.data);
+            Serial.print(F(": seq ")); Serial.print(sequence);
+            Serial.print(F(", battery ")); Serial.print(battery, 2);
+            Serial.print(F(" V, acc ")); Serial.print(ax, 2); Serial.print(F("/")); Serial.print(ay, 2);
+            Serial.print(F("/")); Serial.print(az, 2); Serial.print(F(" g"));
+            Serial.println(moving ? F(", moving") : F(", still"));
+        }
+    }
+
+    unsigned long received[numTags] = { 0 };
+    unsigned long skipped[numTags] = { 0 };
+    unsigned long stale[numTags] = { 0 };
+    uint32_t lastSequence[numTags] = { 0 };
+    unsigned long invalid = 0;
+};
+
+TelemetryListener telemetry;
+
+int main() {
+    module.setResponseLatency(2000);
+    module.setRangingLatency(15000, 5000);
+    module.setDropRate(0.1);
+    for (int i = 0; i < numTags; i++) {
+        module.addTag(tagAddresses[i], 120 + 200 * i);
+        refreshTag(i);
+        ranging.addTag(tagAddresses[i]);
+    }
+
+    if (!uwb.begin() || !uwb.setMode(RYUW122Mode::ANCHOR)) {
+        Serial.println(F("Failed to initialize RYUW122 module"));
+        return 1;
+    }
+    Serial.print(F("Telemetry schema: ")); Serial.print(Telemetry::BITS); Serial.print(F(" bits, "));
+    Serial.print(Telemetry::LENGTH); Serial.println(F(" characters"));
+
+    uwb.addRangeListener(&telemetry);
+    ranging.start();
+    unsigned long start = millis();
+    unsigned long lastSample = start;
+    while (millis() - start < 2000) {
+        // Sensor period of the TAGs, shorter than the polling period of each of them
+        if (millis() - lastSample >= 20) {
+            lastSample += 20;
+            for (int i = 0; i < numTags; i++) refreshTag(i);
+        }
+        ranging.loop();
+    }
+    ranging.stop();
+
+    for (int i = 0; i < numTags; i++) {
+        Serial.print(tagAddresses[i]); Serial.print(F(": ")); Serial.print(telemetry.received[i]);
+        Serial.print(F(" replies, last sample ")); Serial.print(telemetry.lastSequence[i]);
+        Serial.print(F(", ")); Serial.print(telemetry.skipped[i]); Serial.print(F(" samples skipped, "));
+        Serial.print(telemetry.stale[i]); Serial.print(F(" repeated, "));
+        Serial.print(ranging.getFailureCount(i)); Serial.println(F(" polls lost"));
+    }
+    Serial.print(F("Invalid payloads: ")); Serial.println(telemetry.invalid);
+    return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file simulated_threaded_rx.cpp
+ * @author Renzo Mischianti
+ * @brief Host example: the receive path of the driver on its own thread.
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * The ranging scheduler polls four simulated TAGs while the main loop also does 2 ms of other
+ * work per pass. First the driver reads the module from loop(); then a RYUW122ThreadedReceiver
+ * (the host counterpart of the ESP32 UART receive callback) reads it on a second thread and
+ * hands the decoded lines over through a lock-free RYUW122RxQueue. With the queue each
+ * measurement carries the time it arrived, not the time the main loop got to it: the example
+ * prints how long the frames waited for their dispatch, and checks that every payload arrives intact
+ * and that no line is lost between the two threads.
+ *
+ * Build with the host CMake project in extras/host and run ./simulated_threaded_rx
+ */
+
+#include <Arduino.h>
+#include <RYUW122.h>
+#include <RYUW122RangingScheduler.h>
+#include <RYUW122RxQueue.h>
+#include <RYUW122Simulator.h>
+#include <RYUW122ThreadedReceiver.h>
+
+const char* tagAddresses[] = { "T1T1T1T1", "T2T2T2T2", "T3T3T3T3", "T4T4T4T4" };
+const char* tagPayloads[] = { "TEMP=21.5", "HUM=48", "BAT=3.71V", "SEQ=000123" };
+const int numTags = 4;
+
+RYUW122Simulator module;
+RYUW122 uwb(&module);
+RYUW122RangingScheduler ranging(uwb);
+RYUW122RxQueue rxQueue;
+RYUW122ThreadedReceiver receiver(module, rxQueue);
+
+/**
+ * @brief Counts the measurements, checks their payload and the age of their timestamp.
+ */
+class Checker : public RYUW122RangeListener {
+public:
+    void onRange(const RYUW122Frame& frame, unsigned long timestampUs) override {
+        unsigned long age = micros() - timestampUs;
+        measurements++;
+        ageSum += age;
+        if (age > ageMax) ageMax = age;
+        for (int i = 0; i < numTags; i++) {
+            if (strcmp(frame.tagAddress, tagAddresses[i]) == 0) {
+                if (strcmp(frame.data, tagPayloads[i]) != 0) corrupted++;
+                return;
+            }
+        }
+        corrupted++;
+    }
+
+    void reset() { measurements = corrupted = 0; ageSum = ageMax = 0; }
+
+    unsigned long measurements = 0;
+    unsigned long corrupted = 0;
+    unsigned long ageSum = 0;
+    unsigned long ageMax = 0;
+};
+
+Checker checker;
+
+// Runs the sketch loop for a while: ranging plus 2 ms of application work per pass
+unsigned long run(unsigned long duration) {
+    unsigned long inLoop = 0;
+    unsigned long start = millis();
+    while (millis() - start < duration) {
+        unsigned long t = micros();
+        ranging.loop();
+        inLoop += micros() - t;
+        delay(2);
+    }
+    return inLoop;
+}
+
+void report(const char* title, unsigned long inLoop, bool timestamped) {
+    Serial.println(title);
+    Serial.print(F("  ")); Serial.print(checker.measurements); Serial.print(F(" measurements, "));
+    Serial.print(checker.corrupted); Serial.print(F(" corrupted, "));
+    Serial.print(checker.measurements ? inLoop / checker.measurements : 0);
+    Serial.println(F(" us of main loop per measurement"));
+    if (!timestamped) return;
+    // Read from loop(), the timestamps are taken at dispatch: late by this much
+    Serial.print(F("  frames arrived before their dispatch by: mean "));
+    Serial.print(checker.measurements ? checker.ageSum / checker.measurements : 0);
+    Serial.print(F(" us, max ")); Serial.print(checker.ageMax); Serial.println(F(" us"));
+}
+
+int main() {
+    module.setResponseLatency(1000, 200);
+    module.setRangingLatency(8000, 3000);
+    for (int i = 0; i < numTags; i++) module.addTag(tagAddresses[i], 120 + 80 * i, -60, tagPayloads[i]);
+
+    if (!uwb.begin() || !uwb.setMode(RYUW122Mode::ANCHOR)) {
+        Serial.println(F("Failed to initialize the RYUW122 module"));
+        return 1;
+    }
+    uwb.addRangeListener(&checker);
+    for (int i = 0; i < numTags; i++) ranging.addTag(tagAddresses[i]);
+    ranging.start();
+
+    // Polled: the frames wait in the stream until loop() reads them
+    unsigned long inLoop = run(2000);
+    report("Read from loop():", inLoop, false);
+
+    // Receive thread: the lines are assembled, decoded and timestamped as they arrive
+    ranging.stop();
+    run(50);
+    checker.reset();
+    receiver.begin();
+    uwb.setReceiveQueue(&rxQueue);
+    ranging.start();
+    inLoop = run(2000);
+    ranging.stop();
+    report("Read by the receive thread:", inLoop, true);
+
+    uwb.setReceiveQueue(nullptr);
+    receiver.end();
+    Serial.print(F("  queue: ")); Serial.print(rxQueue.getQueued()); Serial.print(F(" lines, "));
+    Serial.print(rxQueue.getDropped()); Serial.print(F(" dropped, deepest ")); Serial.println(rxQueue.getMaxDepth());
+
+    return checker.measurements > 0 && checker.corrupted == 0 && rxQueue.getDropped() == 0 ? 0 : 1;
+}
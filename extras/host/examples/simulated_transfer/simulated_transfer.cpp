@@ -0,0 +1,122 @@
+/**
+ * @file simulated_transfer.cpp
+ * @author Renzo Mischianti
+ * @brief Host example: messages larger than 12 bytes carried by the ranging exchanges.
+ * @version 1.0.0
+ * @date 2025-12-10
+ *
+ * Two simulated modules: the ANCHOR ranges two TAGs with the ranging scheduler, and one of
+ * them is a second module in TAG mode driven by its own RYUW122 instance. A RYUW122Transfer
+ * on each side first pushes a 100-byte configuration blob to the TAG, then pulls a 96-byte
+ * record from it, 6 bytes per exchange, while the ranging goes on. 10% of the exchanges are
+ * lost: the selective acknowledgements tell which fragments to send again.
+ *
+ * Build with the host CMake project in extras/host and run ./simulated_transfer
+ */
+
+#include <Arduino.h>
+#include <RYUW122.h>
+#include <RYUW122RangingScheduler.h>
+#include <RYUW122Transfer.h>
+#include <RYUW122Simulator.h>
+
+RYUW122Simulator anchorModule;
+RYUW122Simulator tagModule(2);
+RYUW122 anchor(&anchorModule);
+RYUW122 tag(&tagModule);
+RYUW122RangingScheduler ranging(anchor);
+
+RYUW122Transfer anchorTransfer("T1T1T1T1");
+RYUW122Transfer tagTransfer;
+
+// TAG firmware: every poll of the ANCHOR goes through the transfer, which sets the next reply
+void onTagReceive(int payloadLength, const char* data, int rssi) {
+    (void)rssi;
+    tagTransfer.tagReply(tag, data, payloadLength);
+}
+
+void printStats(const char* side, const RYUW122Transfer& transfer) {
+    RYUW122TransferStats stats = transfer.getStats();
+    Serial.print(F("  ")); Serial.print(side); Serial.print(F(": "));
+    Serial.print(transfer.getState() == RYUW122TransferState::COMPLETE ? F("complete, ") : F("NOT complete, "));
+    Serial.print(stats.bytes); Serial.print(F(" bytes in ")); Serial.print(stats.fragments);
+    Serial.print(F(" fragments, ")); Serial.print(stats.framesSent); Serial.print(F(" frames sent ("));
+    Serial.print(stats.retransmissions); Serial.print(F(" again), ")); Serial.print(stats.framesReceived);
+    Serial.print(F(" received (")); Serial.print(stats.duplicates); Serial.print(F(" duplicates), "));
+    Serial.print(stats.elapsed); Serial.print(F(" ms, ")); Serial.print(stats.throughput, 1);
+    Serial.println(F(" bytes/s"));
+}
+
+// Runs both modules until the transfer of the ANCHOR ends
+void run(RYUW122TransferState activeState) {
+    unsigned long start = millis();
+    while (anchorTransfer.getState() == activeState && millis() - start < 10000) {
+        ranging.loop();
+        tag.loop();
+    }
+}
+
+int main() {
+    anchorModule.setResponseLatency(2000);
+    anchorModule.setRangingLatency(15000, 5000);
+    anchorModule.setDropRate(0.1);
+    anchorModule.addTag("T1T1T1T1", 250);
+    anchorModule.addTag("T2T2T2T2", 410, -65, "OK2");
+    anchorModule.linkTag("T1T1T1T1", &tagModule);
+    tagModule.setResponseLatency(2000);
+
+    if (!anchor.begin() || !anchor.setMode(RYUW122Mode::ANCHOR) || !tag.begin() || !tag.setMode(RYUW122Mode::TAG)) {
+        Serial.println(F("Failed to initialize the RYUW122 modules"));
+        return 1;
+    }
+    tag.onTagReceive(onTagReceive);
+
+    // The fragments travel with the polls of T1; T2 is ranged as usual
+    anchor.addRangeListener(&anchorTransfer);
+    ranging.addTag("T1T1T1T1");
+    ranging.addTag("T2T2T2T2");
+    ranging.onPayload(RYUW122Transfer::schedulerPayload, &anchorTransfer);
+    ranging.start();
+
+    // ANCHOR -> TAG: configuration blob
+    uint8_t config[100];
+    for (uint16_t i = 0; i < sizeof(config); i++) config[i] = (uint8_t)(i * 7 + 3);
+    uint8_t tagBuffer[128];
+    tagTransfer.receive(tagBuffer, sizeof(tagBuffer));
+    anchorTransfer.send(config, sizeof(config));
+    run(RYUW122TransferState::SENDING);
+
+    Serial.print(F("Push of ")); Serial.print(sizeof(config)); Serial.print(F(" bytes to the TAG: "));
+    bool pushed = tagTransfer.getLength() == sizeof(config) && memcmp(tagBuffer, config, sizeof(config)) == 0;
+    Serial.println(pushed ? F("received intact") : F("CORRUPTED"));
+    printStats("ANCHOR", anchorTransfer);
+    printStats("TAG   ", tagTransfer);
+
+    // TAG -> ANCHOR: telemetry record, ready in the reply to the next poll
+    uint8_t record[96];
+    for (uint16_t i = 0; i < sizeof(record); i++) record[i] = (uint8_t)(255 - i);
+    uint8_t anchorBuffer[128];
+    anchorTransfer.receive(anchorBuffer, sizeof(anchorBuffer));
+    tagTransfer.send(record, sizeof(record));
+    tagTransfer.tagReply(tag);
+    run(RYUW122TransferState::RECEIVING);
+
+    Serial.print(F("Pull of ")); Serial.print(sizeof(record)); Serial.print(F(" bytes from the TAG: "));
+    bool pulled = anchorTransfer.getLength() == sizeof(record) && memcmp(anchorBuffer, record, sizeof(record)) == 0;
+    Serial.println(pulled ? F("received intact") : F("CORRUPTED"));
+    printStats("ANCHOR", anchorTransfer);
+    // The TAG learns that its record arrived with the next poll
+    for (int i = 0; i < 3 && tagTransfer.getState() == RYUW122TransferState::SENDING; i++) {
+        unsigned long start = millis();
+        while (millis() - start < 50) {
+            ranging.loop();
+            tag.loop();
+        }
+    }
+    printStats("TAG   ", tagTransfer);
+
+    ranging.stop();
+    Serial.print(F("Ranging meanwhile: T1 ")); Serial.print(ranging.getSuccessCount(0));
+    Serial.print(F(" and T2 ")); Serial.print(ranging.getSuccessCount(1)); Serial.println(F(" measurements"));
+    return pushed && pulled ? 0 : 1;
+}
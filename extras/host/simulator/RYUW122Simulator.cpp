@@ -0,0 +1,410 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Simulated RYUW122 module for the host build
+ */
+
+#include "RYUW122Simulator.h"
+
+// Module error codes (see RYUW122ErrorCode)
+static const int ERR_INVALID_COMMAND_HEADER = 2;
+static const int ERR_PARAMETER_FAILURE = 3;
+static const int ERR_COMMAND_FAILURE = 4;
+static const int ERR_UNKNOWN_COMMAND = 5;
+
+// Parses a decimal integer occupying the whole string
+static bool parseInt(const std::string& s, int& value) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    long v = strtol(s.c_str(), &end, 10);
+    if (*end != '\0') return false;
+    value = (int)v;
+    return true;
+}
+
+static bool startsWith(const std::string& s, const char* prefix) {
+    return s.compare(0, strlen(prefix), prefix) == 0;
+}
+
+RYUW122Simulator::RYUW122Simulator(uint32_t seed) : _random(seed) {
+    resetSettings();
+    _moduleBaud = 115200;
+}
+
+void RYUW122Simulator::resetSettings() {
+    _mode = 0;
+    _channel = 5;
+    _bandwidth = 0;
+    _rfPower = 5;
+    _rssiDisplay = 1;
+    _calibration = 0;
+    _tagEnableTime = 100;
+    _tagDisableTime = 100;
+    _networkId = "REYAX123";
+    _address = "00000000";
+    _password = "00000000000000000000000000000000";
+    _tagData.clear();
+}
+
+void RYUW122Simulator::setResponseLatency(unsigned long latencyUs, unsigned long jitterUs) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _latencyUs = latencyUs;
+    _jitterUs = jitterUs;
+}
+
+void RYUW122Simulator::setRangingLatency(unsigned long latencyUs, unsigned long jitterUs) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _rangingLatencyUs = latencyUs;
+    _rangingJitterUs = jitterUs;
+}
+
+void RYUW122Simulator::setDropRate(double probability) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _dropRate = probability;
+}
+
+void RYUW122Simulator::addTag(const char* address, int distanceCm, int rssi, const char* data) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    Tag tag;
+    tag.distanceCm = distanceCm;
+    tag.rssi = rssi;
+    tag.data = data ? data : "";
+    tag.exchanges = 0;
+    tag.module = nullptr;
+    _tags[address] = tag;
+}
+
+void RYUW122Simulator::linkTag(const char* address, RYUW122Simulator* tagModule) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    Tag* tag = getTag(address);
+    if (tag) tag->module = tagModule;
+}
+
+void RYUW122Simulator::removeTag(const char* address) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _tags.erase(address);
+}
+
+void RYUW122Simulator::setTagDistance(const char* address, int distanceCm) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    Tag* tag = getTag(address);
+    if (tag) tag->distanceCm = distanceCm;
+}
+
+void RYUW122Simulator::setTagData(const char* address, const char* data) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    Tag* tag = getTag(address);
+    if (tag) tag->data = data ? data : "";
+}
+
+RYUW122Simulator::Tag* RYUW122Simulator::getTag(const char* address) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    std::map<std::string, Tag>::iterator it = _tags.find(address);
+    return it == _tags.end() ? nullptr : &it->second;
+}
+
+void RYUW122Simulator::injectLine(const char* line) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    schedule(line, 0, 0);
+}
+
+void RYUW122Simulator::receiveFromAnchor(const char* data, int rssi) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (_mode != 0) return;
+    std::string line = "+TAG_RCV=" + std::to_string(strlen(data)) + "," + data;
+    if (_rssiDisplay) line += "," + std::to_string(rssi);
+    schedule(line, 0, 0);
+}
+
+// ----- Stream -----
+
+void RYUW122Simulator::begin(unsigned long baud) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    HardwareSerial::begin(baud);
+}
+
+int RYUW122Simulator::available() {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    promoteDueLines();
+    return (int)(_ready.size() - _readyPos);
+}
+
+int RYUW122Simulator::read() {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    promoteDueLines();
+    if (_readyPos >= _ready.size()) return -1;
+    _bytesIn++;
+    int c = (unsigned char)_ready[_readyPos++];
+    if (_readyPos == _ready.size()) {
+        _ready.clear();
+        _readyPos = 0;
+    }
+    return c;
+}
+
+int RYUW122Simulator::peek() {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    promoteDueLines();
+    return _readyPos < _ready.size() ? (unsigned char)_ready[_readyPos] : -1;
+}
+
+size_t RYUW122Simulator::write(uint8_t c) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _bytesOut++;
+    if (c == '\n') {
+        if (!_command.empty() && _command[_command.size() - 1] == '\r') {
+            _command.erase(_command.size() - 1);
+        }
+        std::string command;
+        command.swap(_command);
+        if (command.empty()) return 1;
+        if (baudMismatch()) {
+            // Sent at the wrong rate: the module receives noise and does not answer
+            _garbled++;
+            return 1;
+        }
+        handleCommand(command);
+    } else {
+        _command += (char)c;
+    }
+    return 1;
+}
+
+// ----- Answer scheduling -----
+
+void RYUW122Simulator::schedule(const std::string& line, unsigned long latencyUs, unsigned long jitterUs) {
+    // Sent at the wrong rate: the host receives noise, never a line
+    if (baudMismatch()) return;
+
+    long delay = (long)latencyUs;
+    if (jitterUs > 0) {
+        std::uniform_int_distribution<long> jitter(-(long)jitterUs, (long)jitterUs);
+        delay += jitter(_random);
+        if (delay < 0) delay = 0;
+    }
+
+    // The UART delivers lines in order: a line is never due before the previous one
+    unsigned long due = micros() + (unsigned long)delay;
+    if (!_pending.empty() && (long)(due - _lastDueUs) < 0) due = _lastDueUs;
+
+    PendingLine pending;
+    pending.text = line + "\r\n";
+    // The line is readable once its last byte is received: start, 8 data and stop bit per byte
+    if (_wireTime) due += (unsigned long)(pending.text.size() * 10ULL * 1000000ULL / _moduleBaud);
+    _lastDueUs = due;
+    pending.dueUs = due;
+    _pending.push_back(pending);
+    promoteDueLines();
+}
+
+void RYUW122Simulator::promoteDueLines() {
+    if (_pending.empty()) return;
+    unsigned long now = micros();
+    while (!_pending.empty() && (long)(now - _pending.front().dueUs) >= 0) {
+        _ready += _pending.front().text;
+        _pending.pop_front();
+    }
+}
+
+void RYUW122Simulator::reply(const std::string& line) {
+    schedule(line, _latencyUs, _jitterUs);
+}
+
+void RYUW122Simulator::replyError(int code) {
+    reply("+ERR=" + std::to_string(code));
+}
+
+// ----- AT command set -----
+
+void RYUW122Simulator::handleCommand(const std::string& command) {
+    _commands++;
+
+    if (!startsWith(command, "AT")) {
+        replyError(ERR_INVALID_COMMAND_HEADER);
+        return;
+    }
+    if (command == "AT") {
+        reply("+OK");
+        return;
+    }
+    if (!startsWith(command, "AT+")) {
+        replyError(ERR_UNKNOWN_COMMAND);
+        return;
+    }
+
+    std::string body = command.substr(3);
+    std::string name;
+    std::string args;
+    bool query = false;
+    size_t eq = body.find('=');
+    if (eq != std::string::npos) {
+        name = body.substr(0, eq);
+        args = body.substr(eq + 1);
+    } else if (!body.empty() && body[body.size() - 1] == '?') {
+        name = body.substr(0, body.size() - 1);
+        query = true;
+    } else {
+        name = body;
+    }
+
+    int value = 0;
+
+    if (name == "ANCHOR_SEND" && !query) {
+        handleAnchorSend(args);
+    } else if (name == "TAG_SEND" && !query) {
+        handleTagSend(args);
+    } else if (name == "MODE") {
+        if (query) { reply("+MODE=" + std::to_string(_mode)); return; }
+        if (!parseInt(args, value) || value < 0 || value > 2) { replyError(ERR_PARAMETER_FAILURE); return; }
+        _mode = value;
+        reply("+OK");
+    } else if (name == "IPR") {
+        if (query) { reply("+IPR=" + std::to_string(_moduleBaud)); return; }
+        if (!parseInt(args, value) || (value != 9600 && value != 57600 && value != 115200)) {
+            replyError(ERR_PARAMETER_FAILURE);
+            return;
+        }
+        // The +OK still goes out at the old rate
+        reply("+OK");
+        _moduleBaud = (unsigned long)value;
+    } else if (name == "CHANNEL") {
+        if (query) { reply("+CHANNEL=" + std::to_string(_channel)); return; }
+        if (!parseInt(args, value) || (value != 5 && value != 9)) { replyError(ERR_PARAMETER_FAILURE); return; }
+        _channel = value;
+        reply("+OK");
+    } else if (name == "BANDWIDTH") {
+        if (query) { reply("+BANDWIDTH=" + std::to_string(_bandwidth)); return; }
+        if (!parseInt(args, value) || value < 0 || value > 1) { replyError(ERR_PARAMETER_FAILURE); return; }
+        _bandwidth = value;
+        reply("+OK");
+    } else if (name == "CRFOP") {
+        if (query) { reply("+CRFOP=" + std::to_string(_rfPower)); return; }
+        if (!parseInt(args, value) || value < 0 || value > 5) { replyError(ERR_PARAMETER_FAILURE); return; }
+        _rfPower = value;
+        reply("+OK");
+    } else if (name == "RSSI") {
+        if (query) { reply("+RSSI=" + std::to_string(_rssiDisplay)); return; }
+        if (!parseInt(args, value) || value < 0 || value > 1) { replyError(ERR_PARAMETER_FAILURE); return; }
+        _rssiDisplay = value;
+        reply("+OK");
+    } else if (name == "CAL") {
+        if (query) { reply("+CAL=" + std::to_string(_calibration)); return; }
+        if (!parseInt(args, value) || value < -100 || value > 100) { replyError(ERR_PARAMETER_FAILURE); return; }
+        _calibration = value;
+        reply("+OK");
+    } else if (name == "NETWORKID") {
+        if (query) { reply("+NETWORKID=" + _networkId); return; }
+        if (args.size() != 8) { replyError(ERR_PARAMETER_FAILURE); return; }
+        _networkId = args;
+        reply("+OK");
+    } else if (name == "ADDRESS") {
+        if (query) { reply("+ADDRESS=" + _address); return; }
+        if (args.size() != 8) { replyError(ERR_PARAMETER_FAILURE); return; }
+        _address = args;
+        reply("+OK");
+    } else if (name == "CPIN") {
+        if (query) { reply("+CPIN=" + _password); return; }
+        if (args.size() != 32) { replyError(ERR_PARAMETER_FAILURE); return; }
+        _password = args;
+        reply("+OK");
+    } else if (name == "TAGD") {
+        if (query) {
+            reply("+TAGD=" + std::to_string(_tagEnableTime) + "," + std::to_string(_tagDisableTime));
+            return;
+        }
+        size_t comma = args.find(',');
+        int enable = 0;
+        int disable = 0;
+        if (comma == std::string::npos || !parseInt(args.substr(0, comma), enable) ||
+            !parseInt(args.substr(comma + 1), disable) ||
+            enable < 10 || enable > 28000 || disable < 10 || disable > 28000) {
+            replyError(ERR_PARAMETER_FAILURE);
+            return;
+        }
+        _tagEnableTime = enable;
+        _tagDisableTime = disable;
+        reply("+OK");
+    } else if (name == "UID" && query) {
+        reply("+UID=0123456789ABCDEF");
+    } else if (name == "VER" && query) {
+        reply("+VER=RYUW122_SIM_V1.0");
+    } else if (name == "RESET" && !query) {
+        reply("+RESET");
+        reply("+READY");
+    } else if (name == "FACTORY" && !query) {
+        resetSettings();
+        _moduleBaud = 115200;
+        reply("+FACTORY");
+        reply("+READY");
+    } else {
+        replyError(ERR_UNKNOWN_COMMAND);
+    }
+}
+
+void RYUW122Simulator::handleAnchorSend(const std::string& args) {
+    // AT+ANCHOR_SEND=<TAG Address>,<Payload Length>,<Data>
+    size_t first = args.find(',');
+    size_t second = first == std::string::npos ? std::string::npos : args.find(',', first + 1);
+    if (second == std::string::npos) {
+        replyError(ERR_PARAMETER_FAILURE);
+        return;
+    }
+
+    std::string tagAddress = args.substr(0, first);
+    int length = 0;
+    std::string data = args.substr(second + 1);
+    if (tagAddress.size() != 8 || !parseInt(args.substr(first + 1, second - first - 1), length) ||
+        length < 0 || length > 12 || (size_t)length != data.size()) {
+        replyError(ERR_PARAMETER_FAILURE);
+        return;
+    }
+    if (_mode != 1) {
+        replyError(ERR_COMMAND_FAILURE);
+        return;
+    }
+
+    reply("+OK");
+
+    Tag* tag = getTag(tagAddress.c_str());
+    if (!tag) return; // nobody answers: the caller times out
+
+    if (_dropRate > 0.0) {
+        std::uniform_real_distribution<double> chance(0.0, 1.0);
+        if (chance(_random) < _dropRate) return;
+    }
+
+    tag->received = data;
+    tag->exchanges++;
+    if (tag->module) {
+        // The reply carries what the TAG set before this request, as on the real modules
+        tag->data = tag->module->tagData();
+        tag->module->receiveFromAnchor(data.c_str(), tag->rssi);
+    }
+
+    // +ANCHOR_RCV=<TAG Address>,<Payload Length>,<TAG Data>,<Distance> cm[,<RSSI>]
+    int distance = tag->distanceCm + _calibration;
+    if (distance < 0) distance = 0;
+    std::string line = "+ANCHOR_RCV=" + tagAddress + "," + std::to_string(tag->data.size()) + "," +
+                       tag->data + "," + std::to_string(distance) + " cm";
+    if (_rssiDisplay) line += "," + std::to_string(tag->rssi);
+    schedule(line, _latencyUs + _rangingLatencyUs, _jitterUs + _rangingJitterUs);
+}
+
+void RYUW122Simulator::handleTagSend(const std::string& args) {
+    // AT+TAG_SEND=<Payload Length>,<Data>
+    size_t comma = args.find(',');
+    int length = 0;
+    if (comma == std::string::npos || !parseInt(args.substr(0, comma), length) ||
+        length < 0 || length > 12 || (size_t)length != args.size() - comma - 1) {
+        replyError(ERR_PARAMETER_FAILURE);
+        return;
+    }
+    if (_mode != 0) {
+        replyError(ERR_COMMAND_FAILURE);
+        return;
+    }
+
+    _tagData = args.substr(comma + 1);
+    reply("+OK");
+}
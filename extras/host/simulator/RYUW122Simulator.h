@@ -0,0 +1,199 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Simulated RYUW122 module for the host build
+ */
+
+#ifndef RYUW122_SIMULATOR_H
+#define RYUW122_SIMULATOR_H
+
+#include "Arduino.h"
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+
+/**
+ * @class RYUW122Simulator
+ * @brief A serial port with a RYUW122 module behind it.
+ *
+ * The simulator implements the AT command set used by the library (configuration, AT+ANCHOR_SEND,
+ * AT+TAG_SEND, ...) and generates the module answers, including the +ANCHOR_RCV of the simulated
+ * TAGs in range. Answers become readable after a configurable latency with jitter, and ranging
+ * replies can be dropped with a given probability.
+ *
+ * The module has its own baud rate (AT+IPR): while the host UART (begin()) is at a different
+ * rate, the commands are not understood and the answers are lost, as with a real mismatch.
+ * Optionally each line also takes its time on the wire (10 bits per byte).
+ *
+ * The Stream methods and the setters are thread-safe, so a receive thread
+ * (RYUW122ThreadedReceiver) can read the module while the driver writes to it.
+ *
+ * It derives from HardwareSerial, so it can be passed both to RYUW122(Stream*) and to the
+ * HardwareSerial constructors:
+ * @code
+ * RYUW122Simulator module;
+ * module.addTag("T1T1T1T1", 250);
+ * RYUW122 uwb(&module);
+ * uwb.begin();
+ * @endcode
+ */
+class RYUW122Simulator : public HardwareSerial {
+public:
+    /**
+     * @struct Tag
+     * @brief A simulated TAG in range of the module (used in ANCHOR mode).
+     */
+    struct Tag {
+        int distanceCm;
+        int rssi;
+        std::string data;     ///< Payload returned with each ranging reply
+        std::string received; ///< Last payload received from the anchor
+        unsigned long exchanges;
+        RYUW122Simulator* module; ///< TAG mode module answering for this TAG (see linkTag()), or nullptr
+    };
+
+    explicit RYUW122Simulator(uint32_t seed = 1);
+
+    // ----- Timing and fault injection -----
+
+    /**
+     * @brief Sets the delay of the direct command answers (+OK, +MODE=..., ...).
+     * @param latencyUs Mean latency in microseconds.
+     * @param jitterUs Uniform jitter (+/-) in microseconds.
+     */
+    void setResponseLatency(unsigned long latencyUs, unsigned long jitterUs = 0);
+
+    /**
+     * @brief Sets the delay between the +OK of AT+ANCHOR_SEND and the +ANCHOR_RCV of the TAG.
+     * @param latencyUs Mean latency in microseconds.
+     * @param jitterUs Uniform jitter (+/-) in microseconds.
+     */
+    void setRangingLatency(unsigned long latencyUs, unsigned long jitterUs = 0);
+
+    /**
+     * @brief Sets the probability (0.0-1.0) that a TAG does not answer a ranging request.
+     */
+    void setDropRate(double probability);
+
+    /**
+     * @brief Adds the transmission time of each line at the module baud rate to its latency.
+     */
+    void setWireTime(bool enable) { _wireTime = enable; }
+
+    /**
+     * @brief Sets the rate the module is configured at, as if changed before the test (AT+IPR).
+     */
+    void setModuleBaudRate(unsigned long baud) { _moduleBaud = baud; }
+
+    // ----- Simulated environment -----
+
+    void addTag(const char* address, int distanceCm, int rssi = -60, const char* data = "");
+    void removeTag(const char* address);
+    void setTagDistance(const char* address, int distanceCm);
+    void setTagData(const char* address, const char* data);
+    Tag* getTag(const char* address);
+
+    /**
+     * @brief Lets a second simulator in TAG mode answer for a TAG: it receives the AT+ANCHOR_SEND
+     * data as +TAG_RCV and its last AT+TAG_SEND data is returned in the +ANCHOR_RCV.
+     */
+    void linkTag(const char* address, RYUW122Simulator* tagModule);
+
+    /**
+     * @brief Queues an arbitrary line (CRLF appended) as if the module had sent it.
+     */
+    void injectLine(const char* line);
+
+    /**
+     * @brief In TAG mode, simulates a request from an anchor: emits +TAG_RCV with the given data.
+     */
+    void receiveFromAnchor(const char* data, int rssi = -60);
+
+    // ----- Module state -----
+
+    int mode() const { return _mode; }
+    const char* address() const { return _address.c_str(); }
+    const char* networkId() const { return _networkId.c_str(); }
+    const char* tagData() const { return _tagData.c_str(); }
+    unsigned long moduleBaudRate() const { return _moduleBaud; }
+
+    unsigned long commandsReceived() const { return _commands; }
+    unsigned long commandsGarbled() const { return _garbled; }
+    unsigned long bytesWritten() const { return _bytesOut; }
+    unsigned long bytesRead() const { return _bytesIn; }
+
+    // ----- Stream / HardwareSerial -----
+
+    void begin(unsigned long baud) override;
+    using HardwareSerial::begin;
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+private:
+    struct PendingLine {
+        unsigned long dueUs;
+        std::string text;
+    };
+
+    void handleCommand(const std::string& command);
+    void handleAnchorSend(const std::string& args);
+    void handleTagSend(const std::string& args);
+
+    void reply(const std::string& line);
+    void replyError(int code);
+    void schedule(const std::string& line, unsigned long latencyUs, unsigned long jitterUs);
+    void promoteDueLines();
+    void resetSettings();
+    // True while the host UART runs at a different rate than the module
+    bool baudMismatch() const { return _baud != 0 && _baud != _moduleBaud; }
+
+    // The Stream methods and the environment setters can be called from different threads
+    // (e.g. a receive thread reading while the driver writes its commands)
+    mutable std::recursive_mutex _mutex;
+
+    std::mt19937 _random;
+
+    unsigned long _latencyUs = 0;
+    unsigned long _jitterUs = 0;
+    unsigned long _rangingLatencyUs = 0;
+    unsigned long _rangingJitterUs = 0;
+    double _dropRate = 0.0;
+    bool _wireTime = false;
+
+    std::map<std::string, Tag> _tags;
+
+    std::string _command;
+    std::deque<PendingLine> _pending;
+    unsigned long _lastDueUs = 0;
+    std::string _ready;
+    size_t _readyPos = 0;
+
+    // Module registers
+    int _mode;
+    unsigned long _moduleBaud;
+    int _channel;
+    int _bandwidth;
+    int _rfPower;
+    int _rssiDisplay;
+    int _calibration;
+    int _tagEnableTime;
+    int _tagDisableTime;
+    std::string _networkId;
+    std::string _address;
+    std::string _password;
+    std::string _tagData;
+
+    unsigned long _commands = 0;
+    unsigned long _garbled = 0;
+    unsigned long _bytesOut = 0;
+    unsigned long _bytesIn = 0;
+};
+
+#endif // RYUW122_SIMULATOR_H
@@ -0,0 +1,90 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Several RYUW122 modules on Linux serial ports multiplexed with epoll: implementation
+ */
+
+#include "RYUW122EpollGateway.h"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+RYUW122EpollGateway::RYUW122EpollGateway() {
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    for (uint8_t i = 0; i < RYUW122_GROUP_MAX_MODULES; i++) {
+        _ports[i] = nullptr;
+        _watched[i] = false;
+    }
+}
+
+RYUW122EpollGateway::~RYUW122EpollGateway() {
+    if (_epoll >= 0) ::close(_epoll);
+}
+
+int8_t RYUW122EpollGateway::add(RYUW122& uwb, RYUW122LinuxSerial& port, RYUW122RangingScheduler* scheduler) {
+    int8_t index = _group.add(uwb, scheduler);
+    if (index < 0) return -1;
+    _ports[index] = &port;
+    _watched[index] = false;
+    return index;
+}
+
+bool RYUW122EpollGateway::begin() {
+    bool ok = _group.begin();
+    for (uint8_t i = 0; i < _group.getCount(); i++) {
+        if (!_ports[i]->isOpen() && !_ports[i]->open()) {
+            ok = false;
+            continue;
+        }
+        if (!watch(i)) ok = false;
+    }
+    return ok && _epoll >= 0;
+}
+
+bool RYUW122EpollGateway::watch(uint8_t index) {
+    if (_epoll < 0 || _watched[index]) return _watched[index];
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.u32 = index;
+    _watched[index] = epoll_ctl(_epoll, EPOLL_CTL_ADD, _ports[index]->fd(), &event) == 0;
+    return _watched[index];
+}
+
+void RYUW122EpollGateway::unwatch(uint8_t index) {
+    if (!_watched[index]) return;
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, _ports[index]->fd(), nullptr);
+    _watched[index] = false;
+}
+
+int RYUW122EpollGateway::poll() {
+    if (_epoll < 0) return -1;
+
+    // Commands issued by the schedulers go out before the wait
+    _group.loop();
+
+    epoll_event events[RYUW122_GROUP_MAX_MODULES];
+    int ready = epoll_wait(_epoll, events, RYUW122_GROUP_MAX_MODULES, _tickMs);
+    if (ready < 0) {
+        if (errno != EINTR) return -1;
+        ready = 0;
+    }
+    if (ready > 0) _wakeups++;
+
+    for (int i = 0; i < ready; i++) {
+        uint8_t index = (uint8_t)events[i].data.u32;
+        // A port that hung up stays readable forever: it leaves the loop
+        if (_ports[index]->pump() < 0 || (events[i].events & (EPOLLHUP | EPOLLERR))) unwatch(index);
+    }
+
+    _group.loop();
+    return ready;
+}
+
+void RYUW122EpollGateway::run(unsigned long durationMs) {
+    unsigned long start = millis();
+    while (millis() - start < durationMs) {
+        if (poll() < 0) break;
+    }
+}
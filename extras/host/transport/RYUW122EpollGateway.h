@@ -0,0 +1,93 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Several RYUW122 modules on Linux serial ports multiplexed with epoll
+ */
+
+#ifndef RYUW122_EPOLL_GATEWAY_H
+#define RYUW122_EPOLL_GATEWAY_H
+
+#include <RYUW122.h>
+#include <RYUW122Group.h>
+
+#include "RYUW122LinuxSerial.h"
+
+/**
+ * @class RYUW122EpollGateway
+ * @brief Positioning hub on Linux: the modules of a RYUW122Group on /dev/tty* ports, one epoll loop.
+ *
+ * poll() sleeps in epoll_wait() until one of the ports has data (or the tick elapses, for the
+ * transaction timeouts and the ranging rounds), reads every ready port without blocking and runs
+ * every module once through the group: the frames reach the usual parsing, transactions and
+ * callbacks of each driver. A port that hangs up is taken out of the loop.
+ * @code
+ * RYUW122LinuxSerial port1("/dev/ttyUSB0"), port2("/dev/ttyUSB1");
+ * RYUW122T<RYUW122LinuxSerial> uwb1(&port1), uwb2(&port2);
+ * RYUW122RangingScheduler ranging1(uwb1), ranging2(uwb2);
+ * RYUW122EpollGateway gateway;
+ * gateway.add(uwb1, port1, &ranging1);
+ * gateway.add(uwb2, port2, &ranging2);
+ * gateway.begin();
+ * ...
+ * gateway.start();
+ * for (;;) gateway.poll();
+ * @endcode
+ */
+class RYUW122EpollGateway {
+public:
+    RYUW122EpollGateway();
+    ~RYUW122EpollGateway();
+
+    /**
+     * @brief Adds a module and its port (opened by begin() if not open yet).
+     * @return The index of the module, -1 if the group is full.
+     */
+    int8_t add(RYUW122& uwb, RYUW122LinuxSerial& port, RYUW122RangingScheduler* scheduler = nullptr);
+
+    /**
+     * @brief Starts the modules (begin()) and registers their ports with epoll.
+     * @return True if all of them started.
+     */
+    bool begin();
+
+    void start() { _group.start(); }
+    void stop() { _group.stop(); }
+
+    /**
+     * @brief Longest sleep of poll() without data, in milliseconds (default 2).
+     */
+    void setTick(int tickMs) { _tickMs = tickMs > 0 ? tickMs : 1; }
+
+    /**
+     * @brief Waits for data on any port (at most the tick), reads the ready ports and runs every module once.
+     * @return The ports that had data, -1 on an epoll error.
+     */
+    int poll();
+
+    /**
+     * @brief Calls poll() for the given time.
+     */
+    void run(unsigned long durationMs);
+
+    RYUW122Group& group() { return _group; }
+    RYUW122LinuxSerial& getPort(uint8_t index) { return *_ports[index]; }
+
+    /**
+     * @brief Gets the epoll_wait() calls that returned at least one ready port.
+     */
+    unsigned long getWakeups() const { return _wakeups; }
+
+private:
+    bool watch(uint8_t index);
+    void unwatch(uint8_t index);
+
+    RYUW122Group _group;
+    RYUW122LinuxSerial* _ports[RYUW122_GROUP_MAX_MODULES];
+    bool _watched[RYUW122_GROUP_MAX_MODULES];
+    int _epoll = -1;
+    int _tickMs = 2;
+    unsigned long _wakeups = 0;
+};
+
+#endif // RYUW122_EPOLL_GATEWAY_H
@@ -0,0 +1,178 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Linux serial port (termios) for the RYUW122 host build: implementation
+ */
+
+#include "RYUW122LinuxSerial.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Longest wait for the kernel to take the bytes of a command
+static const int WRITE_TIMEOUT_MS = 100;
+
+static speed_t toSpeed(unsigned long baud) {
+    switch (baud) {
+        case 9600: return B9600;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        default: return 0;
+    }
+}
+
+RYUW122LinuxSerial::RYUW122LinuxSerial(const char* path) {
+    if (path) _path = path;
+}
+
+RYUW122LinuxSerial::~RYUW122LinuxSerial() {
+    close();
+}
+
+bool RYUW122LinuxSerial::open(const char* path) {
+    close();
+    if (path) _path = path;
+    _error = 0;
+    _hungUp = false;
+
+    _fd = ::open(_path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (_fd < 0) {
+        _error = errno;
+        return false;
+    }
+    if (!isatty(_fd) || !configure(_baud ? _baud : 115200)) {
+        if (!_error) _error = ENOTTY;
+        ::close(_fd);
+        _fd = -1;
+        return false;
+    }
+    return true;
+}
+
+void RYUW122LinuxSerial::close() {
+    if (_fd >= 0) ::close(_fd);
+    _fd = -1;
+    _rxHead = _rxTail = 0;
+}
+
+bool RYUW122LinuxSerial::configure(unsigned long baud) {
+    speed_t speed = toSpeed(baud);
+    if (speed == 0) {
+        _error = EINVAL;
+        return false;
+    }
+
+    termios options;
+    if (tcgetattr(_fd, &options) != 0) {
+        _error = errno;
+        return false;
+    }
+    cfmakeraw(&options);
+    options.c_cflag |= CLOCAL | CREAD;
+    options.c_cflag &= ~(CSTOPB | CRTSCTS);
+    // With VMIN 0 an empty terminal reads 0 like a hang-up: with 1 the non-blocking read gives EAGAIN
+    options.c_cc[VMIN] = 1;
+    options.c_cc[VTIME] = 0;
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
+    if (tcsetattr(_fd, TCSANOW, &options) != 0) {
+        _error = errno;
+        return false;
+    }
+    // Bytes received at the previous rate are garbage
+    tcflush(_fd, TCIFLUSH);
+    _rxHead = _rxTail = 0;
+    return true;
+}
+
+void RYUW122LinuxSerial::begin(unsigned long baud) {
+    if (toSpeed(baud) == 0) {
+        _error = EINVAL;
+        return;
+    }
+    HardwareSerial::begin(baud);
+    if (_fd < 0) {
+        open();
+    } else {
+        configure(baud);
+    }
+}
+
+int RYUW122LinuxSerial::pump() {
+    if (_fd < 0 || _hungUp) return -1;
+
+    // Compacts the buffer so that the free space is contiguous
+    if (_rxHead > 0) {
+        memmove(_rx, _rx + _rxHead, _rxTail - _rxHead);
+        _rxTail -= _rxHead;
+        _rxHead = 0;
+    }
+
+    int total = 0;
+    while (_rxTail < sizeof(_rx)) {
+        ssize_t count = ::read(_fd, _rx + _rxTail, sizeof(_rx) - _rxTail);
+        if (count > 0) {
+            _rxTail += (size_t)count;
+            total += (int)count;
+            continue;
+        }
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (count < 0 && errno == EINTR) continue;
+        // EOF or EIO: the device (or the other end of the pty) is gone
+        _error = count < 0 ? errno : EIO;
+        _hungUp = true;
+        break;
+    }
+    _bytesRead += (unsigned long)total;
+    return total > 0 || !_hungUp ? total : -1;
+}
+
+int RYUW122LinuxSerial::available() {
+    if (_rxHead == _rxTail) pump();
+    return (int)(_rxTail - _rxHead);
+}
+
+int RYUW122LinuxSerial::read() {
+    if (_rxHead == _rxTail) pump();
+    return _rxHead < _rxTail ? _rx[_rxHead++] : -1;
+}
+
+int RYUW122LinuxSerial::peek() {
+    if (_rxHead == _rxTail) pump();
+    return _rxHead < _rxTail ? _rx[_rxHead] : -1;
+}
+
+size_t RYUW122LinuxSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t RYUW122LinuxSerial::write(const uint8_t* buffer, size_t size) {
+    if (_fd < 0) return 0;
+
+    size_t written = 0;
+    while (written < size) {
+        ssize_t count = ::write(_fd, buffer + written, size - written);
+        if (count > 0) {
+            written += (size_t)count;
+            continue;
+        }
+        if (count < 0 && errno == EINTR) continue;
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            // Output queue full: wait for room, as the UART of a board would
+            pollfd descriptor = { _fd, POLLOUT, 0 };
+            if (::poll(&descriptor, 1, WRITE_TIMEOUT_MS) > 0) continue;
+        }
+        _error = count < 0 ? errno : EIO;
+        break;
+    }
+    _bytesWritten += (unsigned long)written;
+    return written;
+}
+
+void RYUW122LinuxSerial::flush() {
+    if (_fd >= 0) tcdrain(_fd);
+}
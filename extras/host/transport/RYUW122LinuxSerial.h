@@ -0,0 +1,102 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Linux serial port (termios) for the RYUW122 host build
+ */
+
+#ifndef RYUW122_LINUX_SERIAL_H
+#define RYUW122_LINUX_SERIAL_H
+
+#include <Arduino.h>
+
+#include <string>
+
+// Bytes read from the kernel and not yet taken by the driver
+#ifndef RYUW122_LINUX_SERIAL_BUFFER
+#define RYUW122_LINUX_SERIAL_BUFFER 1024
+#endif
+
+/**
+ * @class RYUW122LinuxSerial
+ * @brief A /dev/tty* device (USB-UART adapter, pseudo-terminal) as the serial port of a module.
+ *
+ * The port is opened non-blocking in raw mode (8N1, no flow control) and begin() sets the
+ * termios speed, so it can be handed to the HardwareSerial constructors: the driver then owns
+ * the rate, and the auto-baud detection and setBaudRate() (AT+IPR) work as on a board.
+ * Only the RYUW122BaudRate values (9600, 57600, 115200) are accepted.
+ *
+ * available() reads what the kernel holds when the internal buffer is empty; pump() does the
+ * same on demand (RYUW122EpollGateway calls it when the descriptor is readable).
+ * @code
+ * RYUW122LinuxSerial port("/dev/ttyUSB0");
+ * RYUW122T<RYUW122LinuxSerial> uwb(&port, RYUW122BaudRate::B_115200);
+ * uwb.begin();                             // opens the device at 115200
+ * @endcode
+ */
+class RYUW122LinuxSerial : public HardwareSerial {
+public:
+    explicit RYUW122LinuxSerial(const char* path = nullptr);
+    ~RYUW122LinuxSerial() override;
+
+    /**
+     * @brief Opens the device (begin() opens it too); a port already open is closed first.
+     * @return False if the device cannot be opened or is not a terminal (see getError()).
+     */
+    bool open(const char* path = nullptr);
+    void close();
+    bool isOpen() const { return _fd >= 0; }
+    int fd() const { return _fd; }
+    const char* path() const { return _path.c_str(); }
+
+    /**
+     * @brief errno of the last failure (0 if none).
+     */
+    int getError() const { return _error; }
+
+    /**
+     * @brief True once the other end has gone (EOF, EIO or hang-up).
+     */
+    bool isHungUp() const { return _hungUp; }
+
+    /**
+     * @brief Opens the device if needed and sets the speed (9600, 57600 or 115200).
+     */
+    void begin(unsigned long baud) override;
+    using HardwareSerial::begin;
+    void end() override { close(); }
+
+    /**
+     * @brief Moves the bytes the kernel holds into the buffer; never blocks.
+     * @return The bytes read, -1 if the port is closed or hung up.
+     */
+    int pump();
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void flush() override;
+
+    unsigned long bytesRead() const { return _bytesRead; }
+    unsigned long bytesWritten() const { return _bytesWritten; }
+
+private:
+    bool configure(unsigned long baud);
+
+    std::string _path;
+    int _fd = -1;
+    int _error = 0;
+    bool _hungUp = false;
+
+    uint8_t _rx[RYUW122_LINUX_SERIAL_BUFFER];
+    size_t _rxHead = 0;
+    size_t _rxTail = 0;
+
+    unsigned long _bytesRead = 0;
+    unsigned long _bytesWritten = 0;
+};
+
+#endif // RYUW122_LINUX_SERIAL_H
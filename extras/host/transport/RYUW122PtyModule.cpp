@@ -0,0 +1,96 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Simulated RYUW122 module behind a pseudo-terminal: implementation
+ */
+
+#include "RYUW122PtyModule.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+static unsigned long toBaud(speed_t speed) {
+    switch (speed) {
+        case B9600: return 9600;
+        case B57600: return 57600;
+        case B115200: return 115200;
+        default: return 0;
+    }
+}
+
+bool RYUW122PtyModule::begin() {
+    end();
+
+    char name[64];
+    termios options;
+    memset(&options, 0, sizeof(options));
+    cfmakeraw(&options);
+    cfsetispeed(&options, B115200);
+    cfsetospeed(&options, B115200);
+    if (openpty(&_master, &_slave, name, &options, nullptr) != 0) return false;
+    // The terminal stays open here too, so the master does not see a hang-up between two opens
+    fcntl(_master, F_SETFL, fcntl(_master, F_GETFL) | O_NONBLOCK);
+    _path = name;
+
+    _running = true;
+    _thread = std::thread(&RYUW122PtyModule::run, this);
+    return true;
+}
+
+void RYUW122PtyModule::end() {
+    _running = false;
+    if (_thread.joinable()) _thread.join();
+    if (_master >= 0) ::close(_master);
+    if (_slave >= 0) ::close(_slave);
+    _master = _slave = -1;
+}
+
+void RYUW122PtyModule::run() {
+    unsigned long baud = 0;
+    uint8_t buffer[256];
+    while (_running.load()) {
+        // Commands from the host
+        pollfd descriptor = { _master, POLLIN, 0 };
+        ssize_t count = 0;
+        if (::poll(&descriptor, 1, 1) > 0 && (descriptor.revents & POLLIN)) {
+            count = ::read(_master, buffer, sizeof(buffer));
+        }
+
+        // The UART of the module is at the speed of the terminal, checked after the read: the
+        // host sets the speed before writing, so the bytes just read were sent at this one
+        termios options;
+        if (tcgetattr(_master, &options) == 0) {
+            unsigned long speed = toBaud(cfgetospeed(&options));
+            if (speed != baud) {
+                baud = speed;
+                _module.begin(baud);
+            }
+        }
+        if (count > 0) _module.write(buffer, (size_t)count);
+
+        // Answers of the module, once due
+        size_t pending = 0;
+        int c;
+        while (pending < sizeof(buffer) && _module.available() > 0 && (c = _module.read()) >= 0) {
+            buffer[pending++] = (uint8_t)c;
+        }
+        size_t written = 0;
+        while (written < pending && _running.load()) {
+            ssize_t count = ::write(_master, buffer + written, pending - written);
+            if (count > 0) {
+                written += (size_t)count;
+            } else if (count < 0 && errno == EAGAIN) {
+                // The host is not reading: wait for room in the terminal
+                pollfd room = { _master, POLLOUT, 0 };
+                ::poll(&room, 1, 1);
+            } else if (count < 0 && errno != EINTR) {
+                break;
+            }
+        }
+    }
+}
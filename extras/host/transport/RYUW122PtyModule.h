@@ -0,0 +1,59 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Simulated RYUW122 module behind a pseudo-terminal
+ */
+
+#ifndef RYUW122_PTY_MODULE_H
+#define RYUW122_PTY_MODULE_H
+
+#include <RYUW122Simulator.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * @class RYUW122PtyModule
+ * @brief Puts a RYUW122Simulator behind a pty pair, so the gateway can be run without hardware.
+ *
+ * A thread copies the commands written to the terminal (path()) into the simulated module and
+ * its answers back, as a USB-UART adapter with a module on it would. The module follows the
+ * speed set on the terminal with termios, so a host at a different rate than the module
+ * (AT+IPR) gets no answer, and the auto-baud detection can be exercised too.
+ * @code
+ * RYUW122Simulator module;
+ * RYUW122PtyModule pty(module);
+ * pty.begin();
+ * RYUW122LinuxSerial port(pty.path());     // e.g. /dev/pts/3
+ * @endcode
+ */
+class RYUW122PtyModule {
+public:
+    explicit RYUW122PtyModule(RYUW122Simulator& module) : _module(module) {}
+    ~RYUW122PtyModule() { end(); }
+
+    /**
+     * @brief Creates the pty pair and starts the thread.
+     */
+    bool begin();
+    void end();
+
+    /**
+     * @brief Path of the terminal to open (valid after begin()).
+     */
+    const char* path() const { return _path.c_str(); }
+
+private:
+    void run();
+
+    RYUW122Simulator& _module;
+    std::string _path;
+    int _master = -1;
+    int _slave = -1;
+    std::thread _thread;
+    std::atomic<bool> _running{false};
+};
+
+#endif // RYUW122_PTY_MODULE_H
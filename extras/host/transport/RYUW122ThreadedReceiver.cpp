@@ -0,0 +1,43 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Receive thread feeding a RYUW122RxQueue on the host build: implementation
+ */
+
+#include "RYUW122ThreadedReceiver.h"
+
+#include <chrono>
+
+void RYUW122ThreadedReceiver::begin(unsigned long idleUs) {
+    end();
+    _idleUs = idleUs;
+    _queue.resetLine();
+    _running = true;
+    _thread = std::thread(&RYUW122ThreadedReceiver::run, this);
+}
+
+void RYUW122ThreadedReceiver::end() {
+    _running = false;
+    if (_thread.joinable()) _thread.join();
+}
+
+void RYUW122ThreadedReceiver::run() {
+    uint8_t buffer[RYUW122_RX_CHUNK_SIZE];
+    while (_running.load()) {
+        int count = _stream.available();
+        if (count <= 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(_idleUs));
+            continue;
+        }
+        if (count > (int)sizeof(buffer)) count = sizeof(buffer);
+        int read = 0;
+        while (read < count) {
+            int c = _stream.read();
+            if (c < 0) break;
+            buffer[read++] = (uint8_t)c;
+        }
+        _queue.feed(buffer, (size_t)read);
+        _bytes += (unsigned long)read;
+    }
+}
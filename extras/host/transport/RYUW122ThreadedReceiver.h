@@ -0,0 +1,63 @@
+/*
+ * Author: Renzo Mischianti
+ * Website: https://mischianti.org
+ * Copyright (c) 2025 Renzo Mischianti
+ * Receive thread feeding a RYUW122RxQueue on the host build
+ */
+
+#ifndef RYUW122_THREADED_RECEIVER_H
+#define RYUW122_THREADED_RECEIVER_H
+
+#include <Arduino.h>
+#include <RYUW122RxQueue.h>
+
+#include <atomic>
+#include <thread>
+
+/**
+ * @class RYUW122ThreadedReceiver
+ * @brief Host counterpart of RYUW122UartReceiver: a std::thread reads the stream into the queue.
+ *
+ * The thread stands for the UART interrupt of the board: it takes the bytes as soon as they
+ * are readable and the lines reach the queue decoded and timestamped, while the main thread
+ * runs the driver. The stream must allow reads from another thread than the writes (the
+ * simulated module and the Linux TTY transport do).
+ * @code
+ * RYUW122RxQueue rxQueue;
+ * RYUW122ThreadedReceiver receiver(module, rxQueue);
+ * uwb.begin();
+ * receiver.begin();
+ * uwb.setReceiveQueue(&rxQueue);
+ * @endcode
+ */
+class RYUW122ThreadedReceiver {
+public:
+    RYUW122ThreadedReceiver(Stream& stream, RYUW122RxQueue& queue) : _stream(stream), _queue(queue) {}
+    ~RYUW122ThreadedReceiver() { end(); }
+
+    /**
+     * @brief Starts the receive thread.
+     * @param idleUs Pause when nothing is readable, in microseconds.
+     */
+    void begin(unsigned long idleUs = 50);
+
+    /**
+     * @brief Stops the thread (the bytes not yet read stay in the stream).
+     */
+    void end();
+
+    bool isRunning() const { return _running.load(); }
+    unsigned long bytesReceived() const { return _bytes.load(); }
+
+private:
+    void run();
+
+    Stream& _stream;
+    RYUW122RxQueue& _queue;
+    std::thread _thread;
+    std::atomic<bool> _running{false};
+    std::atomic<unsigned long> _bytes{0};
+    unsigned long _idleUs = 50;
+};
+
+#endif // RYUW122_THREADED_RECEIVER_H
@@ -28,6 +28,15 @@ enum class RYUW122BaudRate : int32_t {
     UNKNOWN = -1      ///< Unknown baud rate
 };
 
+/**
+ * @brief How begin() finds the baud rate of the module.
+ */
+enum class RYUW122AutoBaud {
+    OFF,               ///< The module is expected at the configured rate
+    DETECT,            ///< Probe 115200, 57600 and 9600 and keep the rate the module answers at
+    DETECT_AND_UPGRADE ///< Probe, then switch module and host UART to the fastest rate of the transport
+};
+
 /**
  * @brief Defines the RF channel for the RYUW122 module.
  */
@@ -72,6 +81,7 @@ enum class RYUW122RSSI {
  * @brief Defines the error codes returned by the RYUW122 module.
  */
 enum class RYUW122ErrorCode {
+    NONE                     = 0, ///< No error reported
     MISSING_CARRIAGE_RETURN = 1, ///< Missing carriage return or line feed
     INVALID_COMMAND_HEADER   = 2, ///< Command does not start with "AT"
     PARAMETER_FAILURE        = 3, ///< Parameter failure
@@ -80,103 +90,67 @@ enum class RYUW122ErrorCode {
     UNKNOWN = -1
 };
 
+// -----------------------------------------
+// Enum descriptions
+// -----------------------------------------
+// The texts live in flash-resident lookup tables (RYUW122_enums.cpp): the *_descriptionF()
+// helpers allocate nothing and can be passed straight to print(), or read with strcpy_P().
+
 /**
  * @brief Return a human-readable description for a RYUW122ErrorCode value.
- * Acts like a static helper tied to the enum.
  */
-static inline String RYUW122ErrorCode_description(RYUW122ErrorCode code) {
-    switch (code) {
-        case RYUW122ErrorCode::MISSING_CARRIAGE_RETURN:
-            return String(F("Missing carriage return or line feed"));
-        case RYUW122ErrorCode::INVALID_COMMAND_HEADER:
-            return String(F("Command does not start with 'AT'"));
-        case RYUW122ErrorCode::PARAMETER_FAILURE:
-            return String(F("Parameter failure"));
-        case RYUW122ErrorCode::COMMAND_FAILURE:
-            return String(F("Command failure"));
-        case RYUW122ErrorCode::UNKNOWN_COMMAND:
-            return String(F("Unknown command"));
-        default:
-            return String(F("Invalid error code"));
-    }
-}
+const __FlashStringHelper* RYUW122ErrorCode_descriptionF(RYUW122ErrorCode code);
 
 /**
- * @brief Parse a numeric error code (e.g. from "+ERR=n") and return description.
+ * @brief Description of a numeric error code (e.g. from "+ERR=n").
  * @param code Numeric error code as received from module.
  */
-static inline String RYUW122ErrorCode_descriptionFromValue(uint8_t code) {
-    if (code >= 1 && code <= 5) {
-        return RYUW122ErrorCode_description(static_cast<RYUW122ErrorCode>(code));
-    }
-    return String(F("Unknown error code"));
+const __FlashStringHelper* RYUW122ErrorCode_descriptionFromValueF(uint8_t code);
+
+const __FlashStringHelper* RYUW122Mode_descriptionF(RYUW122Mode mode);
+const __FlashStringHelper* RYUW122BaudRate_descriptionF(RYUW122BaudRate baudRate);
+const __FlashStringHelper* RYUW122BaudRate_descriptionFromValueF(int32_t value);
+const __FlashStringHelper* RYUW122RFChannel_descriptionF(RYUW122RFChannel channel);
+const __FlashStringHelper* RYUW122Bandwidth_descriptionF(RYUW122Bandwidth bandwidth);
+const __FlashStringHelper* RYUW122RFPower_descriptionF(RYUW122RFPower power);
+const __FlashStringHelper* RYUW122RSSI_descriptionF(RYUW122RSSI rssi);
+
+// String versions, kept for compatibility: each call copies the text to the heap
+
+static inline String RYUW122ErrorCode_description(RYUW122ErrorCode code) {
+    return String(RYUW122ErrorCode_descriptionF(code));
 }
 
-// -----------------------------------------
-// Additional enum description helpers
-// -----------------------------------------
+static inline String RYUW122ErrorCode_descriptionFromValue(uint8_t code) {
+    return String(RYUW122ErrorCode_descriptionFromValueF(code));
+}
 
 static inline String RYUW122Mode_description(RYUW122Mode mode) {
-    switch (mode) {
-        case RYUW122Mode::TAG: return String(F("TAG (mobile) mode"));
-        case RYUW122Mode::ANCHOR: return String(F("ANCHOR (fixed) mode"));
-        case RYUW122Mode::SLEEP: return String(F("SLEEP mode"));
-        default: return String(F("Unknown mode"));
-    }
+    return String(RYUW122Mode_descriptionF(mode));
 }
 
 static inline String RYUW122BaudRate_description(RYUW122BaudRate br) {
-    switch (br) {
-        case RYUW122BaudRate::B_9600: return String(F("9600 bps"));
-        case RYUW122BaudRate::B_57600: return String(F("57600 bps"));
-        case RYUW122BaudRate::B_115200: return String(F("115200 bps"));
-        default: return String(F("Unknown baud rate"));
-    }
+    return String(RYUW122BaudRate_descriptionF(br));
 }
 
 static inline String RYUW122BaudRate_descriptionFromValue(int32_t val) {
-    switch (val) {
-        case 9600: return String(F("9600 bps"));
-        case 57600: return String(F("57600 bps"));
-        case 115200: return String(F("115200 bps"));
-        default: return String(F("Unknown baud rate"));
-    }
+    return String(RYUW122BaudRate_descriptionFromValueF(val));
 }
 
 static inline String RYUW122RFChannel_description(RYUW122RFChannel ch) {
-    switch (ch) {
-        case RYUW122RFChannel::CH_5: return String(F("Channel 5 (6489.6 MHz)"));
-        case RYUW122RFChannel::CH_9: return String(F("Channel 9 (7987.2 MHz)"));
-        default: return String(F("Unknown RF channel"));
-    }
+    return String(RYUW122RFChannel_descriptionF(ch));
 }
 
 static inline String RYUW122Bandwidth_description(RYUW122Bandwidth bw) {
-    switch (bw) {
-        case RYUW122Bandwidth::BW_850K: return String(F("850 Kbps"));
-        case RYUW122Bandwidth::BW_6_8M: return String(F("6.8 Mbps"));
-        default: return String(F("Unknown bandwidth"));
-    }
+    return String(RYUW122Bandwidth_descriptionF(bw));
 }
 
 static inline String RYUW122RFPower_description(RYUW122RFPower p) {
-    switch (p) {
-        case RYUW122RFPower::N65dBm: return String(F("-65 dBm"));
-        case RYUW122RFPower::N50dBm: return String(F("-50 dBm"));
-        case RYUW122RFPower::N45dBm: return String(F("-45 dBm"));
-        case RYUW122RFPower::N40dBm: return String(F("-40 dBm"));
-        case RYUW122RFPower::N35dBm: return String(F("-35 dBm"));
-        case RYUW122RFPower::N32dBm: return String(F("-32 dBm"));
-        default: return String(F("Unknown RF power"));
-    }
+    return String(RYUW122RFPower_descriptionF(p));
 }
 
 static inline String RYUW122RSSI_description(RYUW122RSSI r) {
-    switch (r) {
-        case RYUW122RSSI::DISABLE: return String(F("RSSI display disabled"));
-        case RYUW122RSSI::ENABLE: return String(F("RSSI display enabled"));
-        default: return String(F("Unknown RSSI setting"));
-    }
+    return String(RYUW122RSSI_descriptionF(r));
 }
 
 #endif // RYUW122_ENUMS_H